@@ -0,0 +1,74 @@
+#
+#   Performance stress test: Compare filling a table item by item with
+#   filling it with the bulk addRows() call
+#
+#   Usage: python table_bulk_benchmark.py [rows]
+#
+#   License
+#
+#   This program is free software; you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation; either version 2 of the License, or
+#   (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+import sys
+import time
+sys.path.insert(0,'../../../build/swig/python')
+import yui
+
+rowCount = int(sys.argv[1]) if len(sys.argv) > 1 else 20000
+
+rows = [ [ "name-{0}".format(i), "1.0", str(i), "x86_64" ] for i in range(rowCount) ]
+
+factory = yui.YUI.widgetFactory()
+dialog = factory.createMainDialog()
+
+VBox = factory.createVBox(dialog)
+
+def createTable(parent):
+    header = yui.YTableHeader()
+    header.addColumn("package")
+    header.addColumn("version")
+    header.addColumn("release")
+    header.addColumn("arch")
+    return factory.createTable(parent, header)
+
+HBox = factory.createHBox(VBox)
+perItemTable = createTable(HBox)
+bulkTable = createTable(HBox)
+result = factory.createLabel(VBox, "")
+myOK = factory.createPushButton(VBox, "OK")
+dialog.recalcLayout()
+
+# Per item: one wrapped YTableItem and one addItem() call per row
+
+start = time.time()
+
+for row in rows:
+    item = yui.YTableItem(*row)
+    item.this.own(False)
+    perItemTable.addItem(item)
+
+perItemTime = time.time() - start
+
+# Bulk: one call, all items are created on the C++ side
+
+start = time.time()
+bulkTable.addRows(rows)
+bulkTime = time.time() - start
+
+summary = "{0} rows: per item {1:.3f} s, bulk {2:.3f} s".format(rowCount, perItemTime, bulkTime)
+print(summary)
+result.setValue(summary)
+
+event = dialog.waitForEvent()
+
+dialog.destroy()
@@ -309,6 +309,68 @@ namespace std {
 using namespace std;
 typedef std::vector<YItem *> YItemCollection;
 
+/*
+ * Bulk item construction.
+ *
+ * Creating one wrapped YItem / YTableItem per row and calling addItem() for
+ * each of them crosses the language boundary several times per row. These
+ * take native lists (Python lists, Ruby arrays, ...) of labels or of rows,
+ * build all items on the C++ side and add them with one single addItems()
+ * call, i.e. with only one screen update.
+ *
+ *   table.addRows( [ [ "name-1", "1.0", "1", "x86_64" ], ... ] )
+ *   selBox.addItemLabels( [ "one", "two", "three" ] )
+ */
+
+#if !defined(SWIGCSHARP)
+namespace std {
+    %template(YStringVector)  vector<string>;
+    %template(YStringTable)   vector< vector<string> >;
+}
+
+%{
+static YItemCollection
+yuiTableItems( const std::vector< std::vector<std::string> > & rows )
+{
+  YItemCollection items;
+  items.reserve( rows.size() );
+
+  for ( const std::vector<std::string> & row: rows )
+  {
+    YTableItem * item = new YTableItem();
+
+    for ( const std::string & cell: row )
+      item->addCell( cell );
+
+    items.push_back( item );
+  }
+
+  return items;
+}
+%}
+
+%extend YSelectionWidget {
+  void addItemLabels( const std::vector<std::string> & labels )
+  {
+    YItemCollection items;
+    items.reserve( labels.size() );
+
+    for ( const std::string & label: labels )
+      items.push_back( new YItem( label ) );
+
+    $self->addItems( items );
+  }
+}
+
+%extend YTable {
+  void addRows( const std::vector< std::vector<std::string> > & rows )
+  { $self->addItems( yuiTableItems( rows ) ); }
+
+  void setRows( const std::vector< std::vector<std::string> > & rows )
+  { $self->setItems( yuiTableItems( rows ) ); }
+}
+#endif
+
 %extend YWidget {
 #if defined(SWIGPERL5)
   int __eq__( YWidget *w )
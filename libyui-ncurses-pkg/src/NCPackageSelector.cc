@@ -160,6 +160,9 @@ NCPackageSelector::~NCPackageSelector()
     // Don't call delete for the popups in destructor but call
     // YDialog::deleteTopmostDialog() instead at the end of
     // NCPackageSelectorPlugin::runPkgSelection
+
+    // The cached details would keep the zypp objects alive
+    NCPkgPackageDetails::clearCache();
 }
 
 
@@ -1565,71 +1568,7 @@ void NCPackageSelector::showDiskSpace()
 //
 void NCPackageSelector::showDownloadSize()
 {
-    std::set<ZyppSel> selectablesToInstall;
-
-    for ( ZyppPoolIterator patches_it = zyppPatchesBegin();
-	  patches_it != zyppPatchesEnd();
-	  ++patches_it )
-    {
-	ZyppPatch patch = tryCastToZyppPatch( (*patches_it)->theObj() );
-
-	if ( patch )
-	{
-	    ZyppPatchContents patchContents( patch->contents() );
-
-	    for ( ZyppPatchContentsIterator contents_it = patchContents.selectableBegin();
-		  contents_it != patchContents.selectableEnd();
-		  ++contents_it )
-	    {
-		ZyppPkg pkg = tryCastToZyppPkg( (*contents_it)->theObj() );
-		ZyppSel sel;
-
-		if ( pkg )
-		    sel = selMapper.findZyppSel( pkg );
-
-
-		if ( sel )
-		{
-		    switch ( sel->status() )
-		    {
-			case S_Install:
-			case S_AutoInstall:
-			case S_Update:
-			case S_AutoUpdate:
-			    // Insert the patch contents selectables into a set,
-			    // don't immediately sum up their sizes: The same
-			    // package could be in more than one patch, but of
-			    // course it will be downloaded only once.
-
-			    selectablesToInstall.insert( sel );
-			    break;
-
-			case S_Del:
-			case S_AutoDel:
-			case S_NoInst:
-			case S_KeepInstalled:
-			case S_Taboo:
-			case S_Protected:
-			    break;
-
-			    // intentionally omitting 'default' branch so the compiler can
-			    // catch unhandled enum states
-		    }
-
-		}
-	    }
-	}
-    }
-
-    FSize totalSize = 0;
-
-    for ( std::set<ZyppSel>::iterator it = selectablesToInstall.begin();
-	  it != selectablesToInstall.end();
-	  ++it )
-    {
-	if ( (*it)->candidateObj() )
-	    totalSize += zypp::ByteCount::SizeType((*it)->candidateObj()->installSize());
-    }
+    FSize totalSize = downloadSize.totalSize();
 
     // show the download size
     if ( diskspaceLabel )
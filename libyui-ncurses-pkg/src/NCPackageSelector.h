@@ -61,6 +61,7 @@
 #include "NCPkgFilterMain.h"
 #include "NCPkgFilterSearch.h"
 #include "NCPkgMenuFilter.h"
+#include "NCPkgDownloadSize.h"
 #include "NCPkgPackageDetails.h"
 #include "NCPkgPopupDeps.h"
 #include "NCPkgSearchSettings.h"
@@ -194,6 +195,7 @@ private:
 
     // Mapping from ZyppPkg to the corresponding ZyppSel.
     NCPkgSelMapper selMapper;
+    NCPkgDownloadSize downloadSize;	// total download size of YOU patches
 
     std::set<std::string> verified_pkgs;
 
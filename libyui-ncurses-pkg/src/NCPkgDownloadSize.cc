@@ -0,0 +1,150 @@
+/****************************************************************************
+|
+| Copyright (c) [2020] SUSE LLC
+| All Rights Reserved.
+|
+| This program is free software; you can redistribute it and/or
+| modify it under the terms of version 2 of the GNU General Public License as
+| published by the Free Software Foundation.
+|
+| This program is distributed in the hope that it will be useful,
+| but WITHOUT ANY WARRANTY; without even the implied warranty of
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+| GNU General Public License for more details.
+|
+| You should have received a copy of the GNU General Public License
+| along with this program; if not, contact SUSE.
+|
+| To contact SUSE about this file by physical or electronic mail,
+| you may find current contact information at www.suse.com
+|
+|***************************************************************************/
+
+
+#define YUILogComponent "ncurses-pkg"
+#include <yui/YUILog.h>
+
+#include <set>
+#include <yui/YLatencyHistogram.h>
+#include <zypp/Patch.h>
+
+#include "NCPkgDownloadSize.h"
+
+
+using std::endl;
+using std::set;
+
+typedef zypp::Patch::Contents			ZyppPatchContents;
+typedef zypp::Patch::Contents::Selectable_iterator	ZyppPatchContentsIterator;
+
+
+NCPkgDownloadSize::NCPkgDownloadSize()
+    : _collected( false )
+    , _total( 0 )
+{
+}
+
+
+NCPkgDownloadSize::~NCPkgDownloadSize()
+{
+    // NOP
+}
+
+
+void
+NCPkgDownloadSize::collect()
+{
+    YStopWatch stopWatch;
+    set<ZyppSel> patchSelectables;
+
+    for ( ZyppPoolIterator patches_it = zyppPatchesBegin();
+	  patches_it != zyppPatchesEnd();
+	  ++patches_it )
+    {
+	ZyppPatch patch = tryCastToZyppPatch( (*patches_it)->theObj() );
+
+	if ( patch )
+	{
+	    ZyppPatchContents patchContents( patch->contents() );
+
+	    for ( ZyppPatchContentsIterator contents_it = patchContents.selectableBegin();
+		  contents_it != patchContents.selectableEnd();
+		  ++contents_it )
+	    {
+		ZyppPkg pkg = tryCastToZyppPkg( (*contents_it)->theObj() );
+		ZyppSel sel;
+
+		if ( pkg )
+		    sel = _selMapper.findZyppSel( pkg );
+
+		// The same package could be in more than one patch, but of
+		// course it will be downloaded only once.
+
+		if ( sel && patchSelectables.insert( sel ).second )
+		{
+		    Entry entry;
+		    entry.sel  = sel;
+		    entry.size = 0;
+		    _entries.push_back( entry );
+		}
+	    }
+	}
+    }
+
+    _collected = true;
+
+    yuiDebug() << "Collected " << _entries.size() << " patch packages in "
+	       << stopWatch.elapsed() / 1000 << " millisec"
+	       << endl;
+}
+
+
+bool
+NCPkgDownloadSize::toInstall( ZyppSel sel )
+{
+    switch ( sel->status() )
+    {
+	case S_Install:
+	case S_AutoInstall:
+	case S_Update:
+	case S_AutoUpdate:
+	    return true;
+
+	case S_Del:
+	case S_AutoDel:
+	case S_NoInst:
+	case S_KeepInstalled:
+	case S_Taboo:
+	case S_Protected:
+	    return false;
+
+	    // intentionally omitting 'default' branch so the compiler can
+	    // catch unhandled enum states
+    }
+
+    return false;
+}
+
+
+FSize
+NCPkgDownloadSize::totalSize()
+{
+    if ( ! _collected )
+	collect();
+
+    for ( Entry & entry: _entries )
+    {
+	zypp::ByteCount::SizeType size = 0;
+
+	if ( toInstall( entry.sel ) && entry.sel->candidateObj() )
+	    size = entry.sel->candidateObj()->installSize();
+
+	if ( size != entry.size )
+	{
+	    _total    += size - entry.size;
+	    entry.size = size;
+	}
+    }
+
+    return FSize( boost::multiprecision::cpp_int( _total ) );
+}
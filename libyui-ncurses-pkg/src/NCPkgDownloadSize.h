@@ -0,0 +1,100 @@
+/****************************************************************************
+|
+| Copyright (c) [2020] SUSE LLC
+| All Rights Reserved.
+|
+| This program is free software; you can redistribute it and/or
+| modify it under the terms of version 2 of the GNU General Public License as
+| published by the Free Software Foundation.
+|
+| This program is distributed in the hope that it will be useful,
+| but WITHOUT ANY WARRANTY; without even the implied warranty of
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.   See the
+| GNU General Public License for more details.
+|
+| You should have received a copy of the GNU General Public License
+| along with this program; if not, contact SUSE.
+|
+| To contact SUSE about this file by physical or electronic mail,
+| you may find current contact information at www.suse.com
+|
+|***************************************************************************/
+
+#ifndef NCPkgDownloadSize_h
+#define NCPkgDownloadSize_h
+
+#include <vector>
+#include <yui/FSize.h>
+
+#include "NCZypp.h"
+#include "NCPkgSelMapper.h"
+
+
+/**
+ * @short Running total of the download size of all patch packages that
+ * are going to be installed or updated.
+ *
+ * The packages of all patches are collected only once (on the first call),
+ * each selectable only once even if it belongs to more than one patch: It
+ * will be downloaded only once. After that, an update only compares the
+ * status of each of these selectables with the status it had at the last
+ * update and adjusts the total for those that changed. This avoids walking
+ * the contents of every patch and looking up their selectables again after
+ * each status change.
+ *
+ * The collected selectables stay valid as long as the package selector is
+ * open: The ZyppPool only changes (e.g. with the repository manager) after
+ * the package selector was closed, and restoring the saved states when it
+ * is cancelled only changes the statuses.
+ *
+ * libzypp does not notify about status changes (the solver changes
+ * statuses without any callback), so totalSize() has to check them all;
+ * but that is one status() call per selectable, not a rebuild.
+ **/
+class NCPkgDownloadSize
+{
+public:
+
+    /**
+     * Constructor. Nothing is collected yet.
+     **/
+    NCPkgDownloadSize();
+
+    /**
+     * Destructor.
+     **/
+    virtual ~NCPkgDownloadSize();
+
+    /**
+     * Return the total size of the patch packages that are going to be
+     * installed or updated, taking any status changes since the last call
+     * into account.
+     **/
+    FSize totalSize();
+
+protected:
+
+    /**
+     * Collect the selectables of all patch packages.
+     **/
+    void collect();
+
+    /**
+     * Return 'true' if 'sel' is going to be installed or updated.
+     **/
+    static bool toInstall( ZyppSel sel );
+
+    struct Entry
+    {
+	ZyppSel				sel;
+	zypp::ByteCount::SizeType	size;	// the size that is counted, 0 if not
+    };
+
+    std::vector<Entry>		_entries;
+    bool			_collected;
+    zypp::ByteCount::SizeType	_total;
+    NCPkgSelMapper		_selMapper;
+};
+
+
+#endif // ifndef NCPkgDownloadSize_h
@@ -47,12 +47,18 @@
 #include "NCPackageSelector.h"
 
 
+#define MAX_CACHED_TEXTS	200
+
 using std::endl;
 
 /*
   Textdomain "ncurses-pkg"
 */
 
+NCPkgPackageDetails::TextCache NCPkgPackageDetails::_descriptions;
+NCPkgPackageDetails::TextCache NCPkgPackageDetails::_fileLists;
+NCPkgPackageDetails::TextCache NCPkgPackageDetails::_dependencies;
+
 NCPkgPackageDetails::NCPkgPackageDetails ( YWidget *parent, std::string initial_text, NCPackageSelector *pkger)
     : NCRichText (parent, initial_text)
     , pkg (pkger)
@@ -60,6 +66,32 @@ NCPkgPackageDetails::NCPkgPackageDetails ( YWidget *parent, std::string initial_
 
 }
 
+bool NCPkgPackageDetails::cached( const TextCache & cache, ZyppObj obj, std::string & text )
+{
+    TextCache::const_iterator it = cache.find( obj );
+
+    if ( it == cache.end() )
+        return false;
+
+    text = it->second;
+    return true;
+}
+
+void NCPkgPackageDetails::addToCache( TextCache & cache, ZyppObj obj, const std::string & text )
+{
+    if ( cache.size() >= MAX_CACHED_TEXTS )
+        cache.clear();
+
+    cache[ obj ] = text;
+}
+
+void NCPkgPackageDetails::clearCache()
+{
+    _descriptions.clear();
+    _fileLists.clear();
+    _dependencies.clear();
+}
+
 std::string NCPkgPackageDetails::createRelLine( const zypp::Capabilities & info )
 {
     std::string text = "";
@@ -133,11 +165,15 @@ void NCPkgPackageDetails::longDescription ( ZyppObj pkgPtr )
    if ( !pkgPtr )
        return;
 
-   // text += commonHeader( pkgPtr );
-   text += pkgPtr->description();
+   if ( !cached( _descriptions, pkgPtr, text ) )
+   {
+       // text += commonHeader( pkgPtr );
+       text = createHtmlText( pkgPtr->description() );
+       addToCache( _descriptions, pkgPtr, text );
+   }
 
    // show the description
-   setValue( createHtmlText(text) );
+   setValue( text );
 }
 
 void NCPkgPackageDetails::technicalData( ZyppObj pkgPtr, ZyppSel slbPtr )
@@ -242,12 +278,16 @@ void NCPkgPackageDetails::fileList( ZyppSel slbPtr )
 
    if ( package )
    {
-       text += commonHeader( slbPtr->theObj() );
-       text += NCPkgStrings::ListOfFiles();
-       // get the file list from the package manager/show the list
-       zypp::Package::FileList pkgfilelist( package->filelist() );
-       std::list<std::string> fileList( pkgfilelist.begin(), pkgfilelist.end() );
-       text += createText( fileList, false );
+       if ( !cached( _fileLists, package, text ) )
+       {
+           text += commonHeader( slbPtr->theObj() );
+           text += NCPkgStrings::ListOfFiles();
+           // get the file list from the package manager/show the list
+           zypp::Package::FileList pkgfilelist( package->filelist() );
+           std::list<std::string> fileList( pkgfilelist.begin(), pkgfilelist.end() );
+           text += createText( fileList, false );
+           addToCache( _fileLists, package, text );
+       }
    }
 
    else
@@ -258,7 +298,15 @@ void NCPkgPackageDetails::fileList( ZyppSel slbPtr )
 
 void NCPkgPackageDetails::dependencyList( ZyppObj pkgPtr, ZyppSel slbPtr )
 {
-    std::string text = commonHeader( pkgPtr );
+    std::string text;
+
+    if ( cached( _dependencies, pkgPtr, text ) )
+    {
+        setValue( text );
+        return;
+    }
+
+    text = commonHeader( pkgPtr );
     // show the relations, all of them except provides which is above
     zypp::Dep deptypes[] = {
 	zypp::Dep::PROVIDES,
@@ -284,6 +332,7 @@ void NCPkgPackageDetails::dependencyList( ZyppObj pkgPtr, ZyppSel slbPtr )
         }
     }
 
+    addToCache( _dependencies, pkgPtr, text );
     setValue (text);
 
 }
@@ -308,7 +357,7 @@ std::string NCPkgPackageDetails::createHtmlText( std::string value )
     std::string description = "";
     bool ul_begin = false;
     bool ul_found = false;
-    std::list<NCstring>::const_iterator line;
+    NCtext::const_iterator line;
 
     for ( line = descr.Text().begin(); line != descr.Text().end(); ++line )
     {
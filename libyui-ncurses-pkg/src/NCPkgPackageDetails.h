@@ -40,6 +40,8 @@
 #ifndef NCPkgPackageDetails_h
 #define NCPkgPackageDetails_h
 
+#include <map>
+
 #include <yui/ncurses/NCRichText.h>
 
 #include "NCZypp.h"
@@ -56,6 +58,29 @@ class NCPkgPackageDetails : public NCRichText
 private:
     NCPackageSelector *pkg;
 
+    /**
+     * Texts that only depend on the package, not on its status, so moving
+     * the cursor back and forth in the package list doesn't build them
+     * again each time. They are static because a new details widget is
+     * created each time the details view changes.
+     **/
+    typedef std::map<ZyppObj, std::string> TextCache;
+
+    static TextCache _descriptions;
+    static TextCache _fileLists;
+    static TextCache _dependencies;
+
+    /**
+     * Look up the text for 'obj' in 'cache' and return it in 'text'.
+     * Return 'false' if it is not cached.
+     **/
+    static bool cached( const TextCache & cache, ZyppObj obj, std::string & text );
+
+    /**
+     * Add 'text' for 'obj' to 'cache'. The cache is emptied when it is full.
+     **/
+    static void addToCache( TextCache & cache, ZyppObj obj, const std::string & text );
+
 public:
 
     NCPkgPackageDetails( YWidget *parent, std::string initial_text, NCPackageSelector * pkger );
@@ -77,5 +102,10 @@ public:
     void dependencyList( ZyppObj objPtr, ZyppSel slbPtr );
 
     bool patchDescription( ZyppObj objPtr, ZyppSel selectable );
+
+    /**
+     * Drop all cached texts.
+     **/
+    static void clearCache();
 };
 #endif
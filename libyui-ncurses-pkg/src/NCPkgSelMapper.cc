@@ -41,20 +41,25 @@
 #define YUILogComponent "ncurses-pkg"
 #include <yui/YUILog.h>
 
+#include <yui/YLatencyHistogram.h>
+#include <zypp/sat/Pool.h>
+
 #include "NCPkgSelMapper.h"
 
 
 using std::endl;
 
-
-int			NCPkgSelMapper::_refCount = 0;
-NCPkgSelMapper::Cache	NCPkgSelMapper::_cache;
+int				NCPkgSelMapper::_refCount   = 0;
+bool				NCPkgSelMapper::_cacheValid = false;
+NCPkgSelMapper::Cache		NCPkgSelMapper::_cache;
+unsigned long			NCPkgSelMapper::_lookups    = 0;
+unsigned long			NCPkgSelMapper::_misses     = 0;
+long long			NCPkgSelMapper::_lookupTime = 0;
 
 
 NCPkgSelMapper::NCPkgSelMapper()
 {
-    if ( ++_refCount == 1 )
-	rebuildCache();
+    ++_refCount;
 }
 
 
@@ -62,16 +67,40 @@ NCPkgSelMapper::~NCPkgSelMapper()
 {
     if ( --_refCount == 0 )
     {
+	if ( _cacheValid )
+	{
+	    yuiMilestone() << _lookups << " pkg -> selectable lookups ("
+			   << _misses << " misses) in " << _lookupTime << " us"
+			   << endl;
+	}
+
 	yuiDebug() << "Destroying pkg -> selectable cache" << endl;
-	_cache.clear();
+	Cache().swap( _cache );
+	_cacheValid = false;
+	_lookups    = 0;
+	_misses     = 0;
+	_lookupTime = 0;
     }
 }
 
 
+void NCPkgSelMapper::ensureCache()
+{
+    if ( ! _cacheValid )
+	rebuildCache();
+}
+
+
 void NCPkgSelMapper::rebuildCache()
 {
-    _cache.clear();
     yuiDebug() << "Building pkg -> selectable cache" << endl;
+    YStopWatch stopWatch;
+
+    // Solvable IDs are indices into the satsolver pool, so they are dense
+    // and all of them are below its capacity.
+
+    _cache.assign( zypp::sat::Pool::instance().capacity(), ZyppSel() );
+    unsigned long count = 0;
 
     for ( ZyppPoolIterator sel_it = zyppPkgBegin();
 	  sel_it != zyppPkgEnd();
@@ -87,7 +116,7 @@ void NCPkgSelMapper::rebuildCache()
 	    ZyppPkg installedPkg = tryCastToZyppPkg( sel->installedObj() );
 
 	    if ( installedPkg )
-		_cache.insert( CachePair( installedPkg, sel ) );
+		count += insert( installedPkg, sel );
 	}
 
 	zypp::ui::Selectable::available_iterator it = sel->availableBegin();
@@ -97,29 +126,56 @@ void NCPkgSelMapper::rebuildCache()
 	    ZyppPkg pkg = tryCastToZyppPkg( *it );
 
 	    if ( pkg )
-		_cache.insert( CachePair( pkg, sel ) );
+		count += insert( pkg, sel );
 
 	    ++it;
 	}
     }
 
-    yuiDebug() << "Building pkg -> selectable cache done" << endl;
+    _cacheValid = true;
+
+    yuiMilestone() << "Built pkg -> selectable cache for " << count << " packages "
+		   << "(pool capacity " << _cache.size() << ") in "
+		   << stopWatch.elapsed() / 1000 << " ms" << endl;
+}
+
+
+bool NCPkgSelMapper::insert( ZyppPkg pkg, ZyppSel sel )
+{
+    size_t id = pkg->satSolvable().id();
+
+    if ( id >= _cache.size() )
+	_cache.resize( id + 1 );
+
+    if ( _cache[ id ] )
+	return false;
+
+    _cache[ id ] = sel;
+
+    return true;
 }
 
 
 ZyppSel
 NCPkgSelMapper::findZyppSel( ZyppPkg pkg )
 {
-    NCPkgSelMapper mapper; // This will build a cache, if there is none yet
+    YStopWatch stopWatch;
+    ensureCache();
+
     ZyppSel sel;
+    size_t id = pkg->satSolvable().id();
 
-    NCPkgSelMapper::CacheIterator it = NCPkgSelMapper::_cache.find( pkg );
+    if ( id < _cache.size() )
+	sel = _cache[ id ];
 
-    if ( it != NCPkgSelMapper::_cache.end() )
-	sel = it->second;
-    else
+    if ( ! sel )
+    {
+	++_misses;
 	yuiWarning() << "No selectable found for package %s" << pkg->name().c_str() << endl;
+    }
+
+    ++_lookups;
+    _lookupTime += stopWatch.elapsed();
 
     return sel;
 }
-
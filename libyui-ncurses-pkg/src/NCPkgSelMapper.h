@@ -45,7 +45,7 @@
 #define NCPkgSelMapper_h
 
 #include "NCZypp.h"
-#include <map>
+#include <vector>
 
 
 
@@ -54,13 +54,18 @@
  *
  * All instances of this class share the same cache. The cache remains alive as
  * long as any instance of this class exists.
+ *
+ * The cache is a flat vector indexed by the ID of the package's solvable in
+ * the satsolver pool, so a lookup is a plain array access. It is built on the
+ * first lookup, not when the first instance is created: Most instances are
+ * members of views that may never need it.
  **/
 class NCPkgSelMapper
 {
 public:
 
     /**
-     * Constructor. Builds a cache, if necessary.
+     * Constructor. The cache is built lazily on the first lookup.
      **/
     NCPkgSelMapper();
 
@@ -95,12 +100,28 @@ public:
 
 protected:
 
-    typedef std::map<ZyppPkg, ZyppSel>		Cache;
-    typedef std::pair<ZyppPkg, ZyppSel>		CachePair;
-    typedef Cache::iterator 			CacheIterator;
+    /**
+     * Build the cache if it is not built yet.
+     **/
+    void ensureCache();
+
+    /**
+     * Add 'pkg' with its selectable 'sel' to the cache unless it is already
+     * there. Return 'true' if it was added.
+     **/
+    static bool insert( ZyppPkg pkg, ZyppSel sel );
+
+    typedef std::vector<ZyppSel>		Cache;
 
     static int		_refCount;
+    static bool		_cacheValid;
     static Cache	_cache;
+
+    // Statistics, logged when the cache is destroyed
+
+    static unsigned long	_lookups;
+    static unsigned long	_misses;
+    static long long		_lookupTime;	// microseconds
 };
 
 
@@ -763,6 +763,24 @@ bool NCPkgTable::showInformation()
 }
 
 
+bool NCPkgTable::isCursorKey( wint_t key )
+{
+    switch ( key )
+    {
+	case KEY_UP:
+	case KEY_DOWN:
+	case KEY_NPAGE:
+	case KEY_PPAGE:
+	case KEY_END:
+	case KEY_HOME:
+	    return true;
+
+	default:
+	    return false;
+    }
+}
+
+
 NCursesEvent NCPkgTable::wHandleInput( wint_t key )
 {
     NCursesEvent ret = NCursesEvent::none;
@@ -785,7 +803,10 @@ NCursesEvent NCPkgTable::wHandleInput( wint_t key )
 	case KEY_PPAGE:
 	case KEY_END:
 	case KEY_HOME:
-	    showInformation();
+	    // While the user holds down a cursor key, only the last position
+	    // matters: Don't show the details for each line on the way there.
+	    if ( !isCursorKey( NCurses::pendingKey() ) )
+		showInformation();
 	    break;
 
 	case KEY_SPACE:
@@ -468,6 +468,13 @@ public:
      */
     bool showInformation();
 
+    /**
+     * Return 'true' if 'key' moves the cursor in the table.
+     * @param key The key to check
+     * @return bool
+     */
+    static bool isCursorKey( wint_t key );
+
     /**
      * Ask the user for confirmation of installing a retracted package.
      * This returns 'true' if the user confirmed, 'false' if not.
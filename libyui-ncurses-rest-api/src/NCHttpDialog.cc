@@ -35,18 +35,29 @@ int NCHttpDialog::wait_for_input(int timeout_millisec)
     struct timeval tv;
     fd_set fdset_read, fdset_write, fdset_excpt;
 
-    // infinite timout => do blocking select()
-    timeval *tv_ptr = (timeout_millisec < 0) ? nullptr : &tv;
-
     // remember the original value
     int timeout_millisec_orig = timeout_millisec;
 
     do
     {
+        // answer the suspended wait requests if something changed
+        YHttpServer::yserver()->check_waits();
+
         std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
+        // wake up when a suspended wait request expires before the timeout
+        int select_timeout = timeout_millisec;
+        int wait_timeout = YHttpServer::yserver()->wait_timeout();
+        bool wait_expires = wait_timeout >= 0 && ( timeout_millisec < 0 || wait_timeout < timeout_millisec );
+
+        if ( wait_expires )
+            select_timeout = wait_timeout;
+
+        // infinite timout => do blocking select()
+        timeval *tv_ptr = (select_timeout < 0) ? nullptr : &tv;
+
         tv.tv_sec  = 0;
-        tv.tv_usec = timeout_millisec * 1000;
+        tv.tv_usec = select_timeout * 1000;
 
         FD_ZERO( &fdset_read );
         FD_ZERO( &fdset_write );
@@ -86,6 +97,8 @@ int NCHttpDialog::wait_for_input(int timeout_millisec)
         {
             if ( errno != EINTR )
                 yuiError() << "error in select() (" << errno << ')' << std::endl;
+            else if ( NCurses::screenDumpRequested() )
+                NCurses::waitingForInput();
         }
         else if ( retval != 0 )
         {
@@ -143,6 +156,12 @@ int NCHttpDialog::wait_for_input(int timeout_millisec)
                 }
             }
         }
+        // only a wait request expired, continue waiting for the input
+        else if ( wait_expires )
+        {
+            if ( timeout_millisec > 0 )
+                timeout_millisec -= select_timeout;
+        }
         // no input within timeout
         else
         {
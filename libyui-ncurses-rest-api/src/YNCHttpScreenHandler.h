@@ -0,0 +1,43 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YNCHttpScreenHandler_h
+#define YNCHttpScreenHandler_h
+
+#include <yui/rest-api/YHttpHandler.h>
+
+/**
+ * Handler for GET /screen: The text and the attributes currently displayed
+ * on the terminal, see NCScreenSnapshot for the format.
+ **/
+class YNCHttpScreenHandler : public YHttpHandler
+{
+
+public:
+
+    YNCHttpScreenHandler() {}
+    virtual ~YNCHttpScreenHandler() {}
+
+protected:
+
+    virtual void process_request(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, std::ostream& body, int& error_code,
+        std::string& content_type, bool *redraw);
+
+};
+
+#endif // YNCHttpScreenHandler_h
@@ -23,6 +23,7 @@
 #include <yui/rest-api/YHttpServer.h>
 
 #include "YNCHttpUI.h"
+#include "YNCHttpScreenHandler.h"
 #include "YNCHttpWidgetsActionHandler.h"
 #include "NCHttpWidgetFactory.h"
 #include "NCHttpDialog.h"
@@ -44,6 +45,7 @@ extern YUI * createYNCHttpUI( bool withThreads )
     if (!YHttpServer::yserver()) {
         yuiMilestone() << "Creating HTTP server" << std::endl;
         YHttpServer * yserver = new YHttpServer( new YNCHttpWidgetsActionHandler() );
+        yserver->mount( "/screen", "GET", new YNCHttpScreenHandler() );
         yserver->start();
     }
     if ( ! YNCHttpUI::ui() )
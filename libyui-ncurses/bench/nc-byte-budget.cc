@@ -0,0 +1,576 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+   File:       nc-byte-budget.cc
+
+/-*/
+
+
+// Terminal output byte budget benchmark for the NCurses UI
+//
+// Runs NCurses UI programs in a pseudo terminal, sends them scripted
+// keystrokes and records for each keystroke how many bytes were written to
+// the terminal, how many screen updates (doupdate() calls) that took, and
+// how long it took until the last byte arrived. The results are printed as
+// one JSON object per scenario and line, so they can be compared between
+// builds to catch output regressions.
+//
+// Usage:
+//
+//     nc-byte-budget [-d dir] [-c cols] [-l lines] [-t term]
+//                    scenario-file [scenario-name...]
+//
+// Each non-empty line of the scenario file that doesn't start with '#' is
+// one scenario:
+//
+//     name | command | key key key ...
+//
+// The command is run with /bin/sh in the directory given with -d. Keys are
+// terminfo key names like Down, PageUp, Tab, BTab, Enter, Esc, F1..F24,
+// Space, BSpace, C-x for control characters, M-x for Alt (hotkeys) or single
+// printable characters.
+// "Down*5" is the same as five times "Down".
+//
+// The screen update counts come from the NCurses UI itself: Each time it
+// waits for input, it writes its output totals to the file given in
+// Y2NCURSES_OUTPUT_STATS. That also tells when a keystroke is completely
+// handled, even if it opened a popup with its own event loop.
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <ncursesw/curses.h>
+#include <ncursesw/term.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define STARTUP_TIMEOUT_MS	20000
+#define KEY_TIMEOUT_MS		5000
+#define POLL_MS			10
+
+typedef std::chrono::steady_clock Clock;
+
+
+struct Key
+{
+    std::string name;
+    std::string seq;	// What to send to the terminal
+};
+
+
+struct Scenario
+{
+    std::string	     name;
+    std::string	     command;
+    std::vector<Key> keys;
+};
+
+
+/**
+ * The terminal output caused by the program start or by one key
+ **/
+struct Burst
+{
+    long long bytes;
+    double    ms;	// Until the last byte arrived
+    long long updates;	// -1 if unknown
+};
+
+
+static std::string	dir	    = ".";
+static unsigned short	screenCols  = 80;
+static unsigned short	screenLines = 25;
+static std::string	term	    = "xterm";
+
+
+static void usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog
+	      << " [-d dir] [-c cols] [-l lines] [-t term]"
+	      << " scenario-file [scenario-name...]" << std::endl;
+    exit( 2 );
+}
+
+
+static std::string trimmed( const std::string & str )
+{
+    size_t start = str.find_first_not_of( " \t" );
+
+    if ( start == std::string::npos )
+	return "";
+
+    return str.substr( start, str.find_last_not_of( " \t" ) - start + 1 );
+}
+
+
+/**
+ * Return the terminal input sequence for key 'name' or an empty string if
+ * there is no such key for the current terminal type.
+ **/
+static std::string keySequence( const std::string & name )
+{
+    static const struct { const char * name; const char * capName; } capKeys[] =
+    {
+	{ "Up",		"kcuu1" },
+	{ "Down",	"kcud1" },
+	{ "Left",	"kcub1" },
+	{ "Right",	"kcuf1" },
+	{ "Home",	"khome" },
+	{ "End",	"kend"  },
+	{ "PageUp",	"kpp"	},
+	{ "PageDown",	"knp"	},
+	{ "Insert",	"kich1" },
+	{ "Delete",	"kdch1" },
+	{ "BTab",	"kcbt"	},
+    };
+
+    for ( const auto & key : capKeys )
+    {
+	if ( name == key.name )
+	{
+	    const char * seq = tigetstr( key.capName );
+	    return seq && seq != (char *) -1 ? seq : "";
+	}
+    }
+
+    if ( name.size() > 1 && name[0] == 'F' && isdigit( name[1] ) )
+    {
+	std::string capName = "kf" + name.substr( 1 );
+	const char * seq = tigetstr( capName.c_str() );
+	return seq && seq != (char *) -1 ? seq : "";
+    }
+
+    if ( name == "Tab"	  ) return "\t";
+    if ( name == "Enter"  ) return "\r";
+    if ( name == "Esc"	  ) return "\033";
+    if ( name == "Space"  ) return " ";
+    if ( name == "BSpace" ) return "\177";
+
+    if ( name.size() == 3 && name.compare( 0, 2, "C-" ) == 0 )
+	return std::string( 1, name[2] & 0x1f );
+
+    if ( name.size() == 3 && name.compare( 0, 2, "M-" ) == 0 )
+	return std::string( "\033" ) + name[2];
+
+    if ( name.size() == 1 && isprint( name[0] ) )
+	return name;
+
+    return "";
+}
+
+
+static std::vector<Scenario> readScenarios( const char * fileName )
+{
+    std::vector<Scenario> scenarios;
+    std::ifstream file( fileName );
+
+    if ( !file )
+    {
+	std::cerr << "Can't open " << fileName << std::endl;
+	exit( 2 );
+    }
+
+    std::string line;
+    int lineNo = 0;
+
+    while ( std::getline( file, line ) )
+    {
+	++lineNo;
+	line = trimmed( line );
+
+	if ( line.empty() || line[0] == '#' )
+	    continue;
+
+	size_t sep1 = line.find( '|' );
+	size_t sep2 = sep1 == std::string::npos ? sep1 : line.find( '|', sep1 + 1 );
+
+	if ( sep2 == std::string::npos )
+	{
+	    std::cerr << fileName << ":" << lineNo << ": Expected \"name | command | keys\"" << std::endl;
+	    exit( 2 );
+	}
+
+	Scenario scenario;
+	scenario.name	 = trimmed( line.substr( 0, sep1 ) );
+	scenario.command = trimmed( line.substr( sep1 + 1, sep2 - sep1 - 1 ) );
+
+	std::istringstream keys( line.substr( sep2 + 1 ) );
+	std::string word;
+
+	while ( keys >> word )
+	{
+	    int count = 1;
+	    size_t star = word.rfind( '*' );
+
+	    if ( star != std::string::npos && star > 0 && star + 1 < word.size() )
+	    {
+		count = atoi( word.c_str() + star + 1 );
+		word.erase( star );
+	    }
+
+	    Key key;
+	    key.name = word;
+	    key.seq  = keySequence( word );
+
+	    if ( key.seq.empty() )
+	    {
+		std::cerr << fileName << ":" << lineNo << ": Unknown key \"" << word
+			  << "\" for TERM=" << term << std::endl;
+		exit( 2 );
+	    }
+
+	    scenario.keys.insert( scenario.keys.end(), count, key );
+	}
+
+	scenarios.push_back( scenario );
+    }
+
+    return scenarios;
+}
+
+
+static double millisecSince( Clock::time_point start, Clock::time_point end = Clock::now() )
+{
+    return std::chrono::duration<double, std::milli>( end - start ).count();
+}
+
+
+/**
+ * The screen update totals the NCurses UI reported in the stats file so
+ * far. The UI only appends to that file (one write() per line), so each
+ * read() only parses the new lines.
+ **/
+struct UpdateTotals
+{
+    UpdateTotals( const std::string & fileName )
+	: file( fileName )
+	{}
+
+    /**
+     * Read the lines "<bytes> <screen updates>" the UI appended since the
+     * last call.
+     **/
+    void read()
+    {
+	long long bytes, updates;
+	file.clear();	// Continue after the end of file of the last call
+
+	while ( file >> bytes >> updates )
+	    totals.push_back( updates );
+    }
+
+    std::ifstream	   file;
+    std::vector<long long> totals;
+};
+
+
+/**
+ * Read the output from 'fd' until the NCurses UI reports in 'stats' that it
+ * waits for input again, i.e. until it has more than 'reports' lines. Since
+ * the UI writes that line after the screen update, all output is in the pty
+ * by then, so there is no need to guess when the output is complete. The
+ * time is counted from 'start' to the last byte.
+ *
+ * The stats file is read once per POLL_MS window, not for each chunk of
+ * output, to keep it out of the measured time as far as possible.
+ *
+ * If there is no report within 'timeoutMs', return what arrived until
+ * then; the screen updates are unknown in that case.
+ **/
+static Burst readOutput( int fd, Clock::time_point start,
+			 UpdateTotals & stats, size_t reports, int timeoutMs )
+{
+    Burst burst = { 0, 0.0, -1 };
+    Clock::time_point last = start;
+    Clock::time_point lastCheck = start;
+    bool done = false;
+    char buf[ 4096 ];
+
+    while ( millisecSince( start ) < timeoutMs )
+    {
+	if ( ! done && millisecSince( lastCheck ) >= POLL_MS )
+	{
+	    stats.read();
+	    lastCheck = Clock::now();
+
+	    if ( stats.totals.size() > reports )
+	    {
+		burst.updates = stats.totals.back() - ( reports > 0 ? stats.totals[ reports - 1 ] : 0 );
+		done = true;
+	    }
+	}
+
+	struct pollfd pfd = { fd, POLLIN, 0 };
+	int ret = poll( &pfd, 1, done ? 0 : POLL_MS );
+
+	if ( ret < 0 && errno == EINTR )
+	    continue;
+
+	if ( ret == 0 && !done )
+	    continue;
+
+	if ( ret <= 0 )
+	    break;
+
+	ssize_t len = read( fd, buf, sizeof( buf ) );
+
+	if ( len <= 0 )	// EIO: The program exited
+	    break;
+
+	burst.bytes += len;
+	last = Clock::now();
+    }
+
+    burst.ms = millisecSince( start, burst.bytes ? last : Clock::now() );
+
+    return burst;
+}
+
+
+static void stopChild( pid_t pid )
+{
+    kill( pid, SIGTERM );
+
+    for ( int i = 0; i < 40; i++ )
+    {
+	if ( waitpid( pid, 0, WNOHANG ) == pid )
+	    return;
+
+	usleep( 50 * 1000 );
+    }
+
+    kill( pid, SIGKILL );
+    waitpid( pid, 0, 0 );
+}
+
+
+static std::string jsonString( const std::string & str )
+{
+    std::string ret = "\"";
+
+    for ( char c : str )
+    {
+	if ( c == '"' || c == '\\' )
+	    ret += '\\';
+
+	if ( (unsigned char) c < 0x20 )
+	{
+	    char esc[8];
+	    snprintf( esc, sizeof( esc ), "\\u%04x", c );
+	    ret += esc;
+	}
+	else
+	    ret += c;
+    }
+
+    return ret + "\"";
+}
+
+
+static void printBurst( std::ostream & out, const Burst & burst )
+{
+    char ms[32];
+    snprintf( ms, sizeof( ms ), "%.1f", burst.ms );
+
+    out << "\"bytes\":" << burst.bytes << ",\"ms\":" << ms << ",\"updates\":";
+
+    if ( burst.updates < 0 )
+	out << "null";
+    else
+	out << burst.updates;
+}
+
+
+static bool runScenario( const Scenario & scenario )
+{
+    char statsFile[] = "/tmp/nc-byte-budget.XXXXXX";
+    int statsFd = mkstemp( statsFile );
+
+    if ( statsFd < 0 )
+    {
+	perror( "mkstemp" );
+	return false;
+    }
+
+    close( statsFd );
+    UpdateTotals stats( statsFile );
+
+    struct winsize size = { screenLines, screenCols, 0, 0 };
+    int master;
+    Clock::time_point start = Clock::now();
+    pid_t pid = forkpty( &master, 0, 0, &size );
+
+    if ( pid < 0 )
+    {
+	perror( "forkpty" );
+	unlink( statsFile );
+	return false;
+    }
+
+    if ( pid == 0 )
+    {
+	if ( chdir( dir.c_str() ) != 0 )
+	{
+	    perror( dir.c_str() );
+	    _exit( 127 );
+	}
+
+	unsetenv( "DISPLAY" );	// Make sure to get the NCurses UI
+	unsetenv( "COLUMNS" );
+	unsetenv( "LINES" );
+	setenv( "TERM", term.c_str(), 1 );
+	setenv( "ESCDELAY", "25", 1 );	// Don't measure the Esc key timeout
+	setenv( "Y2NCURSES_OUTPUT_STATS", statsFile, 1 );
+
+	std::string command = "exec " + scenario.command;
+	execl( "/bin/sh", "sh", "-c", command.c_str(), (char *) 0 );
+	_exit( 127 );
+    }
+
+    Burst startup = readOutput( master, start, stats, 0, STARTUP_TIMEOUT_MS );
+    std::vector<Burst> bursts;
+
+    for ( const Key & key : scenario.keys )
+    {
+	stats.read();
+	size_t reports = stats.totals.size();
+	start = Clock::now();
+
+	if ( write( master, key.seq.data(), key.seq.size() ) != (ssize_t) key.seq.size() )
+	{
+	    std::cerr << scenario.name << ": Can't send key " << key.name << std::endl;
+	    break;
+	}
+
+	bursts.push_back( readOutput( master, start, stats, reports, KEY_TIMEOUT_MS ) );
+    }
+
+    stopChild( pid );
+    close( master );
+    unlink( statsFile );
+
+    Burst total = { 0, 0.0, 0 };
+    bool ok = startup.updates >= 0 && bursts.size() == scenario.keys.size();
+
+    if ( startup.updates < 0 )
+	std::cerr << scenario.name << ": No input prompt within " << STARTUP_TIMEOUT_MS << " ms" << std::endl;
+
+    for ( size_t i = 0; i < bursts.size(); i++ )
+    {
+	const Burst & burst = bursts[i];
+
+	if ( burst.updates < 0 )
+	{
+	    std::cerr << scenario.name << ": Key " << i + 1 << " (" << scenario.keys[i].name
+		      << ") was not handled within " << KEY_TIMEOUT_MS << " ms" << std::endl;
+	    ok = false;
+	}
+
+	total.bytes += burst.bytes;
+	total.ms    += burst.ms;
+
+	if ( total.updates >= 0 )
+	    total.updates = burst.updates < 0 ? -1 : total.updates + burst.updates;
+    }
+
+    std::ostringstream out;
+    out << "{\"scenario\":" << jsonString( scenario.name )
+	<< ",\"command\":" << jsonString( scenario.command )
+	<< ",\"term\":" << jsonString( term )
+	<< ",\"cols\":" << screenCols << ",\"lines\":" << screenLines
+	<< ",\"startup\":{";
+
+    printBurst( out, startup );
+    out << "},\"keys\":[";
+
+    for ( size_t i = 0; i < bursts.size(); i++ )
+    {
+	out << ( i ? "," : "" ) << "{\"key\":" << jsonString( scenario.keys[i].name ) << ",";
+	printBurst( out, bursts[i] );
+	out << "}";
+    }
+
+    out << "],\"total\":{";
+    printBurst( out, total );
+    out << "}}";
+
+    std::cout << out.str() << std::endl;
+
+    return ok;
+}
+
+
+int main( int argc, char ** argv )
+{
+    int opt;
+
+    while ( ( opt = getopt( argc, argv, "d:c:l:t:" ) ) != -1 )
+    {
+	switch ( opt )
+	{
+	    case 'd': dir	      = optarg;	       break;
+	    case 'c': screenCols  = atoi( optarg ); break;
+	    case 'l': screenLines = atoi( optarg ); break;
+	    case 't': term	      = optarg;	       break;
+	    default:  usage( argv[0] );
+	}
+    }
+
+    if ( optind >= argc || screenCols == 0 || screenLines == 0 )
+	usage( argv[0] );
+
+    int err;
+
+    if ( setupterm( term.c_str(), STDERR_FILENO, &err ) != OK )
+    {
+	std::cerr << "Unknown terminal type " << term << std::endl;
+	return 2;
+    }
+
+    std::vector<Scenario> scenarios = readScenarios( argv[ optind++ ] );
+    std::vector<std::string> wanted( argv + optind, argv + argc );
+    bool ok = true;
+
+    for ( const Scenario & scenario : scenarios )
+    {
+	bool selected = wanted.empty();
+
+	for ( const std::string & name : wanted )
+	    selected = selected || name == scenario.name;
+
+	if ( selected )
+	    ok = runScenario( scenario ) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
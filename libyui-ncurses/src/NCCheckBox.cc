@@ -110,6 +110,7 @@ void NCCheckBox::setValue( YCheckBoxState state )
     }
 
     Redraw();
+    markChanged();
 
     // trigger the notify event if enabled
     if (old != state && notify())
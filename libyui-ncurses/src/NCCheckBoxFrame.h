@@ -74,7 +74,7 @@ public:
 
     // Do not forget to call Redraw(), so that UI::ChangeWidget works
     // correctly - bug #301370
-    virtual void setValue( bool enable ) { isEnabled = enable; Redraw();}
+    virtual void setValue( bool enable ) { isEnabled = enable; Redraw(); markChanged(); }
 
     virtual bool setKeyboardFocus();
 
@@ -232,6 +232,7 @@ void NCComboBox::setText( const std::string & ntext )
 
     tUpdate();
     Redraw();
+    markChanged();
 }
 
 void NCComboBox::selectItem( YItem * item, bool selected )
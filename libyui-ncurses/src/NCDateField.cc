@@ -117,6 +117,7 @@ void NCDateField::setValue ( const std::string & ntext )
 
     curpos   = buffer.length();
     tUpdate();
+    markChanged();
   }
 }
 
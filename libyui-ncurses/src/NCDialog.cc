@@ -496,7 +496,7 @@ void NCDialog::wRecoded()
 
 	pan->bkgdset( wStyle(). getDumb().text );
 
-	pan->clear();
+	pan->erase();
 	wRedraw();
     }
 }
@@ -808,6 +808,8 @@ wint_t NCDialog::getch( int timeout_millisec )
 {
     wint_t got = WEOF;
 
+    NCurses::waitingForInput();
+
     if ( timeout_millisec < 0 )
     {
 	// wait for input
@@ -815,6 +817,17 @@ wint_t NCDialog::getch( int timeout_millisec )
 
 	got = getinput();
 
+	// interrupted by a screen snapshot request: write it and wait again,
+	// ncurses returns one more ERR after an interrupted read
+	while ( got == WEOF && NCurses::screenDumpRequested() )
+	{
+	    NCurses::waitingForInput();
+	    got = getinput();
+
+	    if ( got == WEOF )
+		got = getinput();
+	}
+
     }
     else if ( timeout_millisec )
     {
@@ -840,6 +853,9 @@ wint_t NCDialog::getch( int timeout_millisec )
 	    }
 
 	    got = getinput();
+
+	    if ( got == WEOF && NCurses::screenDumpRequested() )
+		NCurses::waitingForInput();
 	}
 	while ( got == WEOF && timeout_millisec > 0 );
 
@@ -1250,12 +1266,28 @@ NCursesEvent NCDialog::getInputEvent( wint_t ch )
     {
 	ret = wHandleInput( ch );
 	ret.widget = wActive;
+	markActiveChanged();
     }
 
     return ret;
 }
 
 
+void NCDialog::markActiveChanged()
+{
+    // The key might have changed the active widget without a libyui setter
+    // call (e.g. moving the cursor in a table)
+
+    if ( wActive != static_cast<NCWidget *>( this ) )
+    {
+	YWidget * widget = dynamic_cast<YWidget *>( wActive );
+
+	if ( widget )
+	    widget->markChanged();
+    }
+}
+
+
 NCursesEvent NCDialog::wHandleInput( wint_t ch )
 {
     return wActive->wHandleInput( ch );
@@ -1270,6 +1302,7 @@ NCursesEvent NCDialog::getHotkeyEvent( wint_t key )
     {
 	ret = wHandleHotkey( key );
 	ret.widget = wActive;
+	markActiveChanged();
     }
 
     return ret;
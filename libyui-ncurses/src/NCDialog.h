@@ -78,6 +78,9 @@ private:
     NCursesEvent getInputEvent( wint_t ch );
     NCursesEvent getHotkeyEvent( wint_t key );
 
+    // give the active widget a new change version after handling a key
+    void markActiveChanged();
+
     void grabActive( NCWidget * nactive );
     virtual void grabNotify( NCWidget * mgrab );
     virtual bool wantFocus( NCWidget & ngrab );
@@ -28,6 +28,7 @@
 #include "NCTable.h"
 #include "NCi18n.h"
 
+#include <algorithm>
 #include <fnmatch.h>
 #include <grp.h>
 #include <pwd.h>
@@ -38,6 +39,7 @@ using std::string;
 using std::endl;
 using std::vector;
 using std::list;
+using std::map;
 
 /*
   Textdomain "ncurses"
@@ -45,9 +47,43 @@ using std::list;
 
 
 
+// getpwuid() and getgrgid() can be expensive (NSS, LDAP, ...), and a
+// directory usually contains files of very few users and groups.
+
+static const string & userName( uid_t uid )
+{
+    static map<uid_t, string> cache;
+    map<uid_t, string>::iterator it = cache.find( uid );
+
+    if ( it == cache.end() )
+    {
+	struct passwd * pwdInfo = getpwuid( uid );
+	it = cache.insert( std::make_pair( uid, string( pwdInfo ? pwdInfo->pw_name : "" ) ) ).first;
+    }
+
+    return it->second;
+}
+
+
+static const string & groupName( gid_t gid )
+{
+    static map<gid_t, string> cache;
+    map<gid_t, string>::iterator it = cache.find( gid );
+
+    if ( it == cache.end() )
+    {
+	struct group * groupInfo = getgrgid( gid );
+	it = cache.insert( std::make_pair( gid, string( groupInfo ? groupInfo->gr_name : "" ) ) ).first;
+    }
+
+    return it->second;
+}
+
+
 NCFileInfo::NCFileInfo( string	        fileName,
 			struct stat64 *	statInfo,
-			bool	        link )
+			bool	        link,
+			int		dirFd )
 {
     _name   = fileName;
     _mode   = statInfo->st_mode;
@@ -60,7 +96,7 @@ NCFileInfo::NCFileInfo( string	        fileName,
     {
 	char tmpName[PATH_MAX+1];
 	// get actual file name
-	int len = readlink( fileName.c_str(), tmpName, PATH_MAX );
+	int len = readlinkat( dirFd, fileName.c_str(), tmpName, PATH_MAX );
 
 	if ( len >= 0 )
 	{
@@ -78,15 +114,8 @@ NCFileInfo::NCFileInfo( string	        fileName,
 
     // get user and group name
 
-    struct passwd * pwdInfo  = getpwuid( statInfo->st_uid );
-
-    if ( pwdInfo )
-	_user = pwdInfo->pw_name;
-
-    struct group * groupInfo = getgrgid( statInfo->st_gid );
-
-    if ( groupInfo )
-	_group = groupInfo->gr_name;
+    _user  = userName( statInfo->st_uid );
+    _group = groupName( statInfo->st_gid );
 
     if ( _mode & S_IRUSR )
 	_perm += "r";
@@ -283,6 +312,99 @@ void NCFileSelection::deleteAllItems()
 }
 
 
+static bool typeMatch( bool dirs, mode_t mode )
+{
+    if ( dirs )
+	return S_ISDIR( mode );
+    else
+	return S_ISREG( mode ) || S_ISBLK( mode );
+}
+
+
+bool NCFileSelection::readDirectory( bool dirs )
+{
+    DIR * diskDir = opendir( currentDir.c_str() );
+
+    if ( !diskDir )
+    {
+	yuiError() << "ERROR opening directory: " << currentDir << " errno: "
+		   << strerror( errno ) << endl;
+	return false;
+    }
+
+    deleteAllItems();
+
+    int		    dirFd = dirfd( diskDir );
+    struct dirent * entry;
+    vector<string>  names;
+
+    while (( entry = readdir( diskDir ) ) )
+    {
+	string entryName = entry->d_name;
+
+	if ( entryName == "."
+	     || ( entryName == ".." && currentDir == "/" )
+	     || !acceptEntry( entryName ) )
+	{
+	    continue;
+	}
+
+	// No need to stat() entries of the wrong type. Links and file systems
+	// that don't report the type (DT_UNKNOWN) are checked below.
+
+	if ( entry->d_type != DT_UNKNOWN
+	     && entry->d_type != DT_LNK
+	     && !typeMatch( dirs, DTTOIF( entry->d_type ) ) )
+	{
+	    continue;
+	}
+
+	names.push_back( entryName );
+    }
+
+    // sort the list and fill the table widget with the entries
+    std::sort( names.begin(), names.end() );
+
+    // Draw the first screen right away if there is more to come: stat() can
+    // be slow, e.g. on NFS
+    unsigned firstScreen = win ? win->height() : 0;
+
+    struct stat64 statInfo;
+    struct stat64 linkInfo;
+
+    for ( unsigned i = 0; i < names.size(); ++i )
+    {
+	const string & name = names[i];
+
+	if ( fstatat64( dirFd, name.c_str(), &statInfo, AT_SYMLINK_NOFOLLOW ) == 0 )
+	{
+	    if ( typeMatch( dirs, statInfo.st_mode ) )
+	    {
+		createListEntry( new NCFileInfo( name, &statInfo ) );
+	    }
+	    else if ( S_ISLNK( statInfo.st_mode ) )
+	    {
+		if ( fstatat64( dirFd, name.c_str(), &linkInfo, 0 ) == 0
+		     && typeMatch( dirs, linkInfo.st_mode ) )
+		{
+		    createListEntry( new NCFileInfo( name, &linkInfo, true, dirFd ) );
+		}
+	    }
+	}
+
+	if ( i + 1 == firstScreen && names.size() > firstScreen )
+	{
+	    drawList();
+	    NCurses::Update();
+	}
+    }
+
+    closedir( diskDir );
+
+    return true;
+}
+
+
 bool NCFileTable::createListEntry( NCFileInfo * fileInfo )
 {
     vector<string> data;
@@ -558,84 +680,21 @@ NCursesEvent NCFileTable::wHandleInput( wint_t key )
 
 bool NCFileTable::fillList()
 {
-
-    struct stat64	statInfo;
-    struct stat64	linkInfo;
-    struct dirent *	entry;
-    list<string>	tmpList;
-    list<string>::iterator   it;
-
     fillHeader();	// create the column headers
 
-    DIR * diskDir = opendir( currentDir.c_str() );
-
-    if ( diskDir )
-    {
-	deleteAllItems();
-
-	while (( entry = readdir( diskDir ) ) )
-	{
-	    string entryName = entry->d_name;
-
-	    if ( entryName != "."
-		 && filterMatch( entryName ) )
-	    {
-		tmpList.push_back( entryName );
-	    }
-	}
-
-	// sort the list and fill the table widget with file entries
-	tmpList.sort();
-	it = tmpList.begin();
-
-	while ( it != tmpList.end() )
-	{
-	    string fullName = currentDir + "/" + ( *it );
-
-	    if ( lstat64( fullName.c_str(), &statInfo ) == 0 )
-	    {
-		if ( S_ISREG( statInfo.st_mode ) || S_ISBLK( statInfo.st_mode ) )
-		{
-		    if ((( *it ) == ".." && currentDir != "/" )
-			|| ( *it ) != ".." )
-		    {
-			createListEntry( new NCFileInfo(( *it ), &statInfo ) );
-		    }
-		}
-		else if ( S_ISLNK( statInfo.st_mode ) )
-		{
-		    if ( stat64( fullName.c_str(), &linkInfo ) == 0 )
-		    {
-			if ( S_ISREG( linkInfo.st_mode ) || S_ISBLK( linkInfo.st_mode ) )
-			{
-			    createListEntry( new NCFileInfo(( *it ), &linkInfo, true ) );
-			}
-		    }
-		}
-	    }
-
-	    ++it;
-	}
-
-	drawList();		// draw the list
+    if ( !readDirectory( false ) )
+	return false;
 
-	if ( getNumLines() > 0 )
-	{
-            scrollToFirstItem();
-	    currentFile = getCurrentLine();
-	}
-	else
-	{
-	    currentFile = "";
-	}
+    drawList();		// draw the list
 
-	closedir( diskDir );
+    if ( getNumLines() > 0 )
+    {
+	scrollToFirstItem();
+	currentFile = getCurrentLine();
     }
     else
     {
-	yuiError() << "ERROR opening directory: " << currentDir << " errno: "
-		   << strerror( errno ) << endl;
-	return false;
+	currentFile = "";
     }
 
     return true;
@@ -701,79 +760,16 @@ void NCDirectoryTable::fillHeader()
 
 bool NCDirectoryTable::fillList()
 {
-    struct stat64	statInfo;
-    struct stat64	linkInfo;
-    struct dirent *	entry;
-    list<string>	tmpList;
-    list<string>::iterator   it;
-
     fillHeader();	// create the column headers
 
-    DIR * diskDir = opendir( currentDir.c_str() );
-
-    if ( diskDir )
-    {
-	deleteAllItems();
-
-	while (( entry = readdir( diskDir ) ) )
-	{
-	    string entryName = entry->d_name;
-
-	    if ( entryName != "." )
-	    {
-		tmpList.push_back( entryName );
-	    }
-	}
-
-	// sort the list and fill the table widget with directory entries
-	tmpList.sort();
-
-	it = tmpList.begin();
-
-	while ( it != tmpList.end() )
-	{
-	    string fullName = currentDir + "/" + ( *it );
-
-	    if ( lstat64( fullName.c_str(), &statInfo ) == 0 )
-	    {
-		if ( S_ISDIR( statInfo.st_mode ) )
-		{
-		    if ((( *it ) == ".." && currentDir != "/" )
-			|| ( *it ) != ".." )
-		    {
-			createListEntry( new NCFileInfo(( *it ), &statInfo ) );
-		    }
-		}
-		else if ( S_ISLNK( statInfo.st_mode ) )
-		{
-		    if ( stat64( fullName.c_str(), &linkInfo ) == 0 )
-		    {
-			if ( S_ISDIR( linkInfo.st_mode ) )
-			{
-			    createListEntry( new NCFileInfo(( *it ), &linkInfo, true ) );
-			}
-		    }
-		}
-	    }
-
-	    ++it;
-	}
-
-	drawList();		// draw the list
-	startDir = currentDir;	// set start directory
-
-	if ( getNumLines() > 0 )
-            scrollToFirstItem();
+    if ( !readDirectory( true ) )
+	return false;
 
-	closedir( diskDir );
-    }
-    else
-    {
-	yuiError() << "ERROR opening directory: " << currentDir << " errno: "
-                   << strerror( errno ) << endl;
+    drawList();		// draw the list
+    startDir = currentDir;	// set start directory
 
-	return false;
-    }
+    if ( getNumLines() > 0 )
+	scrollToFirstItem();
 
     return true;
 }
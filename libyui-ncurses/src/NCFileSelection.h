@@ -38,6 +38,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <errno.h>
 
 
@@ -45,10 +46,12 @@ struct NCFileInfo
 {
     /**
      * Constructor from a stat buffer (i.e. based on an lstat64() call).
+     * For links, the link target is read relative to 'dirFd'.
      **/
     NCFileInfo( std::string	fileName,
 		struct stat64	* statInfo,
-		bool link	= false );
+		bool link	= false,
+		int dirFd	= AT_FDCWD );
 
     NCFileInfo();
 
@@ -130,6 +133,25 @@ protected:
 
     NCursesEvent handleKeyEvents( wint_t key );
 
+    /**
+     * Read currentDir and create a list entry for each directory (if
+     * 'dirs' is true) or each regular file or block device (if it is false)
+     * in it, including symlinks to them. The entries are sorted by name.
+     *
+     * The file type is taken from readdir() where the file system provides
+     * it, so entries of the wrong type are skipped without a stat() call.
+     * The first screen of entries is drawn as soon as it is complete.
+     *
+     * Returns 'false' if the directory can't be opened.
+     */
+    bool readDirectory( bool dirs );
+
+    /**
+     * Return 'true' if an entry with this name should be listed.
+     * This default implementation accepts all names.
+     */
+    virtual bool acceptEntry( const std::string & name ) { return true; }
+
 public:
 
     /**
@@ -235,6 +257,8 @@ public:
 
     bool filterMatch( const std::string & fileName );
 
+    virtual bool acceptEntry( const std::string & name ) { return filterMatch( name ); }
+
     std::string getCurrentFile() { return currentFile; }
 
     virtual void fillHeader();
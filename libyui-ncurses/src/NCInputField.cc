@@ -190,6 +190,7 @@ void NCInputField::setValue( const std::string & ntext )
 
     curpos   = buffer.length();
     tUpdate();
+    markChanged();
 
     if (notify() && old_value != ntext)
     {
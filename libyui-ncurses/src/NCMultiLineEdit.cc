@@ -30,6 +30,7 @@
 NCMultiLineEdit::NCMultiLineEdit( YWidget * parent, const std::string & nlabel )
 	: YMultiLineEdit( parent, nlabel )
 	, NCPadWidget( parent )
+	, ctextChanges( 0 )
 {
     // yuiDebug() << std::endl;
     defsze = wsze( 5, 5 ) + wsze( 0, 2 );
@@ -80,19 +81,26 @@ void NCMultiLineEdit::setLabel( const std::string & nlabel )
 void NCMultiLineEdit::setValue( const std::string & ntext )
 {
     DelPad();
-    ctext = NCstring( ntext );
+    ctext  = NCstring( ntext );
+    cvalue = ntext;
     Redraw();
+    markChanged();
 }
 
 
 std::string NCMultiLineEdit::value()
 {
-    if ( myPad() )
+    // Only fetch and recode the text if it was edited since the last call:
+    // This is called very often, and the text might be huge.
+
+    if ( myPad() && myPad()->changes() != ctextChanges )
     {
-	ctext = NCstring( myPad()->getText() );
+	ctext	     = NCstring( myPad()->getText() );
+	cvalue	     = ctext.Str();
+	ctextChanges = myPad()->changes();
     }
 
-    return ctext.Str();
+    return cvalue;
 }
 
 
@@ -130,11 +138,16 @@ NCPad * NCMultiLineEdit::CreatePad()
 void NCMultiLineEdit::DrawPad()
 {
     myPad()->setText( ctext );
+
+    // The pad normalizes the text (no "\r", no trailing newline), so let the
+    // next value() fetch it back once. changes() is never 0 after setText().
+    ctextChanges = 0;
 }
 
 
 void NCMultiLineEdit::setInputMaxLength( int numberOfChars )
 {
+    // This might truncate the text; value() will notice that
     myPad()->setInputMaxLength( numberOfChars );
     YMultiLineEdit::setInputMaxLength( numberOfChars );
 }
@@ -42,6 +42,12 @@ private:
 
     NCstring ctext;
 
+    /// ctext recoded to UTF-8, see value()
+    std::string cvalue;
+
+    /// NCTextPad::changes() when ctext was last in sync with the pad
+    unsigned long ctextChanges;
+
 protected:
 
     /**
@@ -85,6 +85,8 @@ void NCMultiSelectionBox::setCurrentItem( YItem * item )
 {
     if ( item )
 	myPad()->ScrlLine( item->index() );
+
+    markChanged();
 }
 
 
@@ -97,6 +97,7 @@ void NCRadioButton::setValue( bool newval )
 	}
 
 	Redraw();
+	markChanged();
 
 	if (notify())
 	{
@@ -447,7 +447,7 @@ void NCRichText::AdjustPrePad( const wchar_t *osch )
     NCstring nctxt( wtxt );
     NCtext ftext( nctxt );
 
-    std::list<NCstring>::const_iterator line;
+    NCtext::const_iterator line;
     size_t llen = 0;		// longest line
 
     // iterate through NCtext
@@ -0,0 +1,320 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+   File:       NCScreenSnapshot.cc
+
+/-*/
+
+#include <errno.h>
+#include <stdio.h>	// rename()
+#include <string.h>	// strerror()
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#define	 YUILogComponent "ncurses"
+#include <yui/YUILog.h>
+
+#include "NCurses.h"
+#include "NCScreenSnapshot.h"
+
+
+namespace
+{
+    /**
+     * A run of cells in one line with the same colors and attributes.
+     **/
+    struct AttrRun
+    {
+	int    col;
+	int    len;
+	attr_t attrs;
+	short  pair;
+    };
+
+
+    // the attributes reported in the snapshot
+    const struct
+    {
+	attr_t	     attr;
+	const char * name;
+    } attrNames[] =
+    {
+	{ A_BOLD,      "bold"	   },
+	{ A_DIM,       "dim"	   },
+	{ A_REVERSE,   "reverse"   },
+	{ A_UNDERLINE, "underline" },
+	{ A_BLINK,     "blink"	   },
+	{ A_STANDOUT,  "standout"  }
+    };
+
+
+    /**
+     * Return the Unicode character for an ACS (line drawing) character.
+     **/
+    wchar_t acsToUnicode( wchar_t ch )
+    {
+	switch ( ch )
+	{
+	    case 'l': return L'\x250c';	// ┌
+	    case 'k': return L'\x2510';	// ┐
+	    case 'm': return L'\x2514';	// └
+	    case 'j': return L'\x2518';	// ┘
+	    case 't': return L'\x251c';	// ├
+	    case 'u': return L'\x2524';	// ┤
+	    case 'v': return L'\x2534';	// ┴
+	    case 'w': return L'\x252c';	// ┬
+	    case 'n': return L'\x253c';	// ┼
+	    case 'q': return L'\x2500';	// ─
+	    case 'x': return L'\x2502';	// │
+	    case '`': return L'\x25c6';	// ◆
+	    case 'a': return L'\x2592';	// ▒
+	    case 'h': return L'\x2591';	// ░
+	    case '0': return L'\x2588';	// █
+	    case 'f': return L'\x00b0';	// °
+	    case 'g': return L'\x00b1';	// ±
+	    case '~': return L'\x00b7';	// ·
+	    case ',': return L'\x2190';	// ←
+	    case '+': return L'\x2192';	// →
+	    case '-': return L'\x2191';	// ↑
+	    case '.': return L'\x2193';	// ↓
+	    case 'y': return L'\x2264';	// ≤
+	    case 'z': return L'\x2265';	// ≥
+	    case '{': return L'\x03c0';	// π
+	    case '|': return L'\x2260';	// ≠
+	    case '}': return L'\x00a3';	// £
+	    default:  return ch;
+	}
+    }
+
+
+    /**
+     * Append 'ch' to 'out' as UTF-8, escaped for a JSON string.
+     **/
+    void appendJson( std::string & out, wchar_t ch )
+    {
+	unsigned long c = ch;
+
+	if ( c == '"' || c == '\\' )
+	{
+	    out += '\\';
+	    out += (char) c;
+	}
+	else if ( c < 0x20 )
+	{
+	    char buf[8];
+	    snprintf( buf, sizeof( buf ), "\\u%04lx", c );
+	    out += buf;
+	}
+	else if ( c < 0x80 )
+	{
+	    out += (char) c;
+	}
+	else if ( c < 0x800 )
+	{
+	    out += (char) ( 0xc0 | ( c >> 6 ) );
+	    out += (char) ( 0x80 | ( c & 0x3f ) );
+	}
+	else if ( c < 0x10000 )
+	{
+	    out += (char) ( 0xe0 | ( c >> 12 ) );
+	    out += (char) ( 0x80 | ( ( c >> 6 ) & 0x3f ) );
+	    out += (char) ( 0x80 | ( c & 0x3f ) );
+	}
+	else
+	{
+	    out += (char) ( 0xf0 | ( c >> 18 ) );
+	    out += (char) ( 0x80 | ( ( c >> 12 ) & 0x3f ) );
+	    out += (char) ( 0x80 | ( ( c >> 6 ) & 0x3f ) );
+	    out += (char) ( 0x80 | ( c & 0x3f ) );
+	}
+    }
+
+
+    std::string colorName( short color )
+    {
+	static const char * names[] =
+	{
+	    "black", "red", "green", "yellow", "blue", "magenta", "cyan", "white"
+	};
+
+	if ( color < 0 )
+	    return "default";
+
+	if ( color < 8 )
+	    return names[ color ];
+
+	return std::to_string( color );
+    }
+
+
+    void writeRun( std::ostream & out, int row, const AttrRun & run, bool & first )
+    {
+	short fg = -1;
+	short bg = -1;
+	::pair_content( run.pair, &fg, &bg );
+
+	std::string attrs;
+
+	for ( const auto & attr: attrNames )
+	{
+	    if ( run.attrs & attr.attr )
+	    {
+		if ( ! attrs.empty() )
+		    attrs += ' ';
+
+		attrs += attr.name;
+	    }
+	}
+
+	out << ( first ? "\n" : ",\n" )
+	    << "    [ " << row << ", " << run.col << ", " << run.len
+	    << ", \"" << colorName( fg ) << "\", \"" << colorName( bg )
+	    << "\", \"" << attrs << "\" ]";
+
+	first = false;
+    }
+}
+
+
+void NCScreenSnapshot::write( std::ostream & out )
+{
+    WINDOW * scr = ::curscr;
+
+    if ( ! scr )
+	return;
+
+    int rows = getmaxy( scr );
+    int cols = getmaxx( scr );
+
+    // reading the cells moves the cursor of curscr, which is the physical
+    // cursor position ncurses assumes for the next update
+    int cursorRow;
+    int cursorCol;
+    getyx( scr, cursorRow, cursorCol );
+
+    std::vector<std::string> text( rows );
+    std::vector<std::vector<AttrRun> > runs( rows );
+
+    for ( int row = 0; row < rows; ++row )
+    {
+	std::string & line = text[ row ];
+	size_t usedLen = 0;	// without the trailing spaces
+
+	for ( int col = 0; col < cols; ++col )
+	{
+	    cchar_t cell;
+	    wchar_t wch[ CCHARW_MAX + 1 ];
+	    attr_t  attrs = 0;
+	    short   pair  = 0;
+
+	    if ( ::mvwin_wch( scr, row, col, &cell ) == ERR ||
+		 ::getcchar( &cell, wch, &attrs, &pair, 0 ) == ERR )
+	    {
+		wch[0] = L' ';
+		wch[1] = 0;
+	    }
+
+	    int width = 1;
+
+	    if ( attrs & A_ALTCHARSET )
+		wch[0] = acsToUnicode( wch[0] );
+	    else if ( wch[0] == 0 || ( width = ::wcwidth( wch[0] ) ) < 1 )
+		wch[0] = L' ';
+
+	    width = std::max( 1, std::min( width, cols - col ) );
+
+	    // the first character and the combining characters
+	    for ( int i = 0; i < CCHARW_MAX && wch[i]; ++i )
+		appendJson( line, wch[i] );
+
+	    if ( wch[0] != L' ' )
+		usedLen = line.size();
+
+	    attrs &= ~( A_ALTCHARSET | A_COLOR );
+	    std::vector<AttrRun> & lineRuns = runs[ row ];
+
+	    if ( ! lineRuns.empty() && lineRuns.back().attrs == attrs && lineRuns.back().pair == pair )
+		lineRuns.back().len += width;
+	    else
+		lineRuns.push_back( { col, width, attrs, pair } );
+
+	    // skip the continuation cell of a double width character
+	    col += width - 1;
+	}
+
+	line.resize( usedLen );
+    }
+
+    ::wmove( scr, cursorRow, cursorCol );
+
+    out << "{\n"
+	<< "  \"rows\" : "   << rows << ",\n"
+	<< "  \"cols\" : "   << cols << ",\n"
+	<< "  \"cursor\" : [ " << cursorRow << ", " << cursorCol << " ],\n"
+	<< "  \"text\" : [";
+
+    for ( int row = 0; row < rows; ++row )
+	out << ( row ? ",\n" : "\n" ) << "    \"" << text[ row ] << "\"";
+
+    out << "\n  ],\n"
+	<< "  \"attrs\" : [";
+
+    bool first = true;
+
+    for ( int row = 0; row < rows; ++row )
+    {
+	for ( const AttrRun & run: runs[ row ] )
+	{
+	    if ( run.pair != 0 || run.attrs != 0 )
+		writeRun( out, row, run, first );
+	}
+    }
+
+    out << "\n  ]\n"
+	<< "}\n";
+}
+
+
+bool NCScreenSnapshot::save( const std::string & path )
+{
+    std::string tmpPath = path + ".tmp";
+
+    {
+	std::ofstream file( tmpPath );
+	write( file );
+	file.close();
+
+	if ( ! file )
+	{
+	    yuiError() << "Can't write the screen snapshot to " << tmpPath << std::endl;
+	    return false;
+	}
+    }
+
+    if ( ::rename( tmpPath.c_str(), path.c_str() ) != 0 )
+    {
+	yuiError() << "Can't rename " << tmpPath << " to " << path << ": " << strerror( errno ) << std::endl;
+	return false;
+    }
+
+    yuiDebug() << "Saved the screen snapshot to " << path << std::endl;
+
+    return true;
+}
@@ -0,0 +1,67 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+   File:       NCScreenSnapshot.h
+
+/-*/
+
+#ifndef NCScreenSnapshot_h
+#define NCScreenSnapshot_h
+
+#include <iosfwd>
+#include <string>
+
+
+/**
+ * Snapshot of the terminal screen as the user sees it: the characters and
+ * the attributes, read directly from the ncurses screen buffer (curscr), so
+ * nothing is rendered again and the snapshot is exact.
+ *
+ * The snapshot is a JSON object:
+ *
+ *     {
+ *       "rows" : 25,
+ *       "cols" : 80,
+ *       "cursor" : [ 12, 30 ],
+ *       "text" : [ "first line", "second line", ... ],
+ *       "attrs" : [ [ row, col, length, "fg", "bg", "bold reverse" ], ... ]
+ *     }
+ *
+ * The text lines are UTF-8 without the trailing spaces, line drawing
+ * characters are converted to the Unicode box drawing characters. "attrs"
+ * contains one entry for each run of cells with the same colors and
+ * attributes, runs with the default colors and no attributes are left out.
+ **/
+class NCScreenSnapshot
+{
+public:
+
+    /**
+     * Write the snapshot of the current screen to 'out'.
+     **/
+    static void write( std::ostream & out );
+
+    /**
+     * Write the snapshot to the file 'path'. The file is replaced atomically,
+     * readers never see a partial snapshot. Returns 'true' on success.
+     **/
+    static bool save( const std::string & path );
+};
+
+
+#endif // NCScreenSnapshot_h
@@ -93,8 +93,8 @@ std::string NCSelectionBox::getLine( int index )
     {
 	value = line->GetItems()[0];
 	const NClabel label = value->Label();
-	const std::list<NCstring> text = label.getText();
-	std::list<NCstring>::const_iterator it = text.begin();
+	const std::vector<NCstring> & text = label.getText();
+	std::vector<NCstring>::const_iterator it = text.begin();
 
 	while ( it != text.end() )
 	{
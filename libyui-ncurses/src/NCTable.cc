@@ -168,6 +168,7 @@ void NCTable::cellChanged( const YTableCell * changedCell )
     {
         tableCol->SetLabel( changedCell->label() );
         DrawPad();
+        markChanged();
     }
     else
     {
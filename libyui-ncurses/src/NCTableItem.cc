@@ -414,7 +414,7 @@ void NCTableLine::updatePrefix()
     _prefix = new chtype[ prefixLen() ];
     chtype * tagend = &_prefix[ prefixLen()-1 ];
     *tagend-- = ACS_HLINE;
-    *tagend-- = firstChild() ? ACS_TTEE : ACS_HLINE;
+    *tagend-- = firstChild() || hasLazyChildren() ? ACS_TTEE : ACS_HLINE;
 
     if ( _parent )
     {
@@ -455,14 +455,16 @@ void NCTableLine::drawPrefix( NCursesWindow & w,
 
     w.move( at.Pos.L, at.Pos.C + prefixLen() - 2 );
 
-    if ( firstChild() && !isSpecial() )
+    bool closed = firstChild() ? !firstChild()->isVisible() : hasLazyChildren();
+
+    if ( ( firstChild() || closed ) && !isSpecial() )
     {
         w.bkgdset( tableStyle.highlightBG( _vstate,
                                            NCTableCol::HINT,
                                            NCTableCol::SEPARATOR ) );
     }
 
-    if ( firstChild() && !firstChild()->isVisible() )
+    if ( closed )
         w.addch( '+' );
     else
         w.addch( _prefix[ prefixLen() - 2 ] );
@@ -512,6 +514,14 @@ bool NCTableLine::handleInput( wint_t key )
 }
 
 
+bool NCTableLine::hasLazyChildren() const
+{
+    YTreeItem * treeItem = dynamic_cast<YTreeItem *>( _yitem );
+
+    return treeItem && treeItem->hasLazyChildren();
+}
+
+
 void NCTableLine::openBranch()
 {
     if ( firstChild() && ! firstChild()->isVisible() )
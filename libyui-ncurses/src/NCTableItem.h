@@ -214,6 +214,13 @@ public:
      **/
     virtual void setNested( bool val ) { _nested = val; }
 
+    /**
+     * Return 'true' if the item of this line has children that are not
+     * created yet, i.e. it should be shown as a closed branch.
+     * See YTreeItem::hasLazyChildren().
+     **/
+    bool hasLazyChildren() const;
+
     /**
      * Open this tree branch
      **/
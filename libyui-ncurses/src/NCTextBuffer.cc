@@ -0,0 +1,201 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+   File:       NCTextBuffer.cc
+
+/-*/
+
+
+#include <string.h>     // memmove()
+
+#include "NCTextBuffer.h"
+#include "NCtext.h"
+
+#define MIN_GAP_SIZE	1024
+
+
+NCTextBuffer::NCTextBuffer()
+    : _buf( MIN_GAP_SIZE )
+    , _gapStart( 0 )
+    , _gapEnd( MIN_GAP_SIZE )
+    , _gapLine( 0 )
+    , _gapCol( 0 )
+    , _lineLengths( 1, 0 )
+    , _changes( 0 )
+{
+}
+
+
+void NCTextBuffer::setText( const NCtext & text )
+{
+    _lineLengths.clear();
+    _lineLengths.reserve( text.Text().size() );
+
+    size_t len = 0;
+
+    for ( NCtext::const_iterator line = text.begin(); line != text.end(); ++line )
+	len += line->str().length() + 1;
+
+    _buf.clear();
+    _buf.reserve( len + MIN_GAP_SIZE );
+
+    for ( NCtext::const_iterator line = text.begin(); line != text.end(); ++line )
+    {
+	if ( line != text.begin() )
+	    _buf.push_back( L'\n' );
+
+	_buf.insert( _buf.end(), line->str().begin(), line->str().end() );
+	_lineLengths.push_back( line->str().length() );
+    }
+
+    if ( _lineLengths.empty() )
+	_lineLengths.push_back( 0 );
+
+    // Put the gap at the end of the text
+
+    _gapStart = _buf.size();
+    _buf.resize( _buf.size() + MIN_GAP_SIZE );
+    _gapEnd   = _buf.size();
+    _gapLine  = _lineLengths.size() - 1;
+    _gapCol   = _lineLengths.back();
+
+    ++_changes;
+}
+
+
+std::wstring NCTextBuffer::text() const
+{
+    std::wstring ret;
+    ret.reserve( length() );
+    ret.append( _buf.data(), _gapStart );
+    ret.append( _buf.data() + _gapEnd, _buf.size() - _gapEnd );
+
+    return ret;
+}
+
+
+size_t NCTextBuffer::offset( unsigned line, unsigned col ) const
+{
+    // Start from the gap: Its offset is known, and most changes are close to
+    // the previous one.
+
+    size_t pos = _gapStart - _gapCol;	// Start of the gap line
+
+    for ( unsigned l = _gapLine; l < line; ++l )
+	pos += _lineLengths[ l ] + 1;
+
+    for ( unsigned l = line; l < _gapLine; ++l )
+	pos -= _lineLengths[ l ] + 1;
+
+    return pos + col;
+}
+
+
+void NCTextBuffer::moveGap( unsigned line, unsigned col )
+{
+    if ( line == _gapLine && col == _gapCol )
+	return;
+
+    size_t pos = offset( line, col );
+
+    if ( pos < _gapStart )
+    {
+	size_t count = _gapStart - pos;
+	memmove( _buf.data() + _gapEnd - count, _buf.data() + pos, count * sizeof( wchar_t ) );
+	_gapStart -= count;
+	_gapEnd   -= count;
+    }
+    else if ( pos > _gapStart )
+    {
+	size_t count = pos - _gapStart;
+	memmove( _buf.data() + _gapStart, _buf.data() + _gapEnd, count * sizeof( wchar_t ) );
+	_gapStart += count;
+	_gapEnd   += count;
+    }
+
+    _gapLine = line;
+    _gapCol  = col;
+}
+
+
+void NCTextBuffer::assertGap()
+{
+    if ( _gapStart < _gapEnd )
+	return;
+
+    // Double the buffer size so appending is O(1) amortized
+
+    size_t tail	   = _buf.size() - _gapEnd;
+    size_t newSize = _buf.size() * 2 + MIN_GAP_SIZE;
+
+    _buf.resize( newSize );
+    memmove( _buf.data() + newSize - tail, _buf.data() + _gapEnd, tail * sizeof( wchar_t ) );
+    _gapEnd = newSize - tail;
+}
+
+
+void NCTextBuffer::insert( unsigned line, unsigned col, wchar_t ch )
+{
+    moveGap( line, col );
+    assertGap();
+
+    _buf[ _gapStart++ ] = ch;
+
+    if ( ch == L'\n' )
+    {
+	_lineLengths.insert( _lineLengths.begin() + line + 1, _lineLengths[ line ] - col );
+	_lineLengths[ line ] = col;
+	_gapLine = line + 1;
+	_gapCol	 = 0;
+    }
+    else
+    {
+	++_lineLengths[ line ];
+	++_gapCol;
+    }
+
+    ++_changes;
+}
+
+
+bool NCTextBuffer::erase( unsigned line, unsigned col )
+{
+    if ( col < _lineLengths[ line ] )
+    {
+	moveGap( line, col );
+	++_gapEnd;
+	--_lineLengths[ line ];
+    }
+    else if ( line + 1 < _lineLengths.size() )
+    {
+	// Delete the '\n' at the end of the line
+	moveGap( line, col );
+	++_gapEnd;
+	_lineLengths[ line ] += _lineLengths[ line + 1 ];
+	_lineLengths.erase( _lineLengths.begin() + line + 1 );
+    }
+    else
+    {
+	return false;
+    }
+
+    ++_changes;
+
+    return true;
+}
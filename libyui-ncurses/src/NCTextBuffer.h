@@ -0,0 +1,129 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+   File:       NCTextBuffer.h
+
+/-*/
+
+
+#ifndef NCTextBuffer_h
+#define NCTextBuffer_h
+
+#include <string>
+#include <vector>
+
+class NCtext;
+
+
+/**
+ * Text model for editable multi-line text: A gap buffer with the whole text
+ * (lines separated by '\n') and an index with the length of each line.
+ *
+ * Positions are given as (line, column) where the column is the character
+ * index within the line. The gap is moved to the position of each change,
+ * so typing or deleting characters at the cursor is O(1) amortized; moving
+ * the gap costs O(distance). The line index is a vector, so accessing the
+ * length of any line is O(1).
+ **/
+class NCTextBuffer
+{
+public:
+
+    /**
+     * Constructor. The buffer starts with one empty line.
+     **/
+    NCTextBuffer();
+
+    /**
+     * Replace the content with the lines of 'text'.
+     **/
+    void setText( const NCtext & text );
+
+    /**
+     * Return the content with lines separated by '\n'.
+     * There is no '\n' after the last line.
+     **/
+    std::wstring text() const;
+
+    /**
+     * Return the number of characters including the line separators.
+     * This is the same as text().length(), just without copying the text.
+     **/
+    size_t length() const { return _buf.size() - ( _gapEnd - _gapStart ); }
+
+    /**
+     * Return the number of lines. This is always at least 1.
+     **/
+    unsigned lines() const { return _lineLengths.size(); }
+
+    /**
+     * Return the number of characters in line 'line'.
+     **/
+    unsigned lineLength( unsigned line ) const { return _lineLengths[ line ]; }
+
+    /**
+     * Insert 'ch' at 'line', 'col'. A '\n' splits the line.
+     **/
+    void insert( unsigned line, unsigned col, wchar_t ch );
+
+    /**
+     * Delete the character at 'line', 'col'. At the end of a line, this joins
+     * it with the next line.
+     *
+     * Return 'false' if there is nothing to delete.
+     **/
+    bool erase( unsigned line, unsigned col );
+
+    /**
+     * Return a counter that is incremented with each change. Users can
+     * compare it to a previously saved value to find out if anything changed
+     * since then.
+     **/
+    unsigned long changes() const { return _changes; }
+
+private:
+
+    /**
+     * Return the text offset (not counting the gap) of 'line', 'col'.
+     * This costs O(number of lines between 'line' and the gap).
+     **/
+    size_t offset( unsigned line, unsigned col ) const;
+
+    /**
+     * Move the gap to 'line', 'col'.
+     **/
+    void moveGap( unsigned line, unsigned col );
+
+    /**
+     * Make sure the gap has room for at least one more character.
+     **/
+    void assertGap();
+
+
+    std::vector<wchar_t>	_buf;
+    size_t			_gapStart;
+    size_t			_gapEnd;
+    unsigned			_gapLine;
+    unsigned			_gapCol;
+    std::vector<unsigned>	_lineLengths;
+    unsigned long		_changes;
+};
+
+
+#endif // NCTextBuffer_h
@@ -27,6 +27,7 @@
 #include "NCTextPad.h"
 
 #include <limits.h>
+#include <vector>
 
 using std::endl;
 
@@ -37,8 +38,6 @@ using std::endl;
 
 NCTextPad::NCTextPad( int l, int c, const NCWidget & p )
 	: NCPad( l, c, p )
-	, lines( 1U, 0 )
-	, cline( lines.begin() )
 	, curson( false )
 	, InputMaxLength( -1 )
 {
@@ -151,20 +150,14 @@ int NCTextPad::setpos( const wpos & newpos )
 {
     wpos npos( newpos.between( 0, wpos( maxy(), maxx() ) ) );
 
-    if ( (unsigned) npos.L >= lines.size() )
+    if ( (unsigned) npos.L >= buffer.lines() )
     {
-	npos.L = lines.size() - 1;
-	cline = lines.end();
-	--cline;
-    }
-    else if ( npos.L != curs.L )
-    {
-	advance( cline, npos.L - curs.L );
+	npos.L = buffer.lines() - 1;
     }
 
-    if ( (unsigned) npos.C > *cline )
+    if ( (unsigned) npos.C > buffer.lineLength( npos.L ) )
     {
-	npos.C = *cline;
+	npos.C = buffer.lineLength( npos.L );
     }
 
     bool ocurs = curson;
@@ -207,9 +200,8 @@ bool NCTextPad::handleInput( wint_t key )
 	    }
 	    else if ( curs.L )
 	    {
-		--cline;
 		--curs.L;
-		curs.C = ( *cline );
+		curs.C = buffer.lineLength( curs.L );
 	    }
 	    else
 	    {
@@ -223,7 +215,6 @@ bool NCTextPad::handleInput( wint_t key )
 
 	    if ( curs.L )
 	    {
-		--cline;
 		--curs.L;
 	    }
 	    else
@@ -236,13 +227,12 @@ bool NCTextPad::handleInput( wint_t key )
 
 	case KEY_RIGHT:
 
-	    if ( (unsigned) curs.C < ( *cline ) )
+	    if ( (unsigned) curs.C < buffer.lineLength( curs.L ) )
 	    {
 		++curs.C;
 	    }
-	    else if ( (unsigned) curs.L + 1 < lines.size() )
+	    else if ( (unsigned) curs.L + 1 < buffer.lines() )
 	    {
-		++cline;
 		++curs.L;
 		curs.C = 0;
 	    }
@@ -256,9 +246,8 @@ bool NCTextPad::handleInput( wint_t key )
 
 	case KEY_DOWN:
 
-	    if ( (unsigned) curs.L + 1 < lines.size() )
+	    if ( (unsigned) curs.L + 1 < buffer.lines() )
 	    {
-		++cline;
 		++curs.L;
 	    }
 	    else
@@ -285,7 +274,7 @@ bool NCTextPad::handleInput( wint_t key )
 
 	case KEY_NPAGE:
 
-	    if ( (unsigned) curs.L + 1 < lines.size() )
+	    if ( (unsigned) curs.L + 1 < buffer.lines() )
 	    {
 		setpos( wpos( curs.L + 3, curs.C ) );
 	    }
@@ -310,9 +299,9 @@ bool NCTextPad::handleInput( wint_t key )
 	case KEY_SRIGHT:
 	case KEY_END:
 
-	    if ( (unsigned) curs.C < ( *cline ) )
+	    if ( (unsigned) curs.C < buffer.lineLength( curs.L ) )
 	    {
-		curs.C = ( *cline );
+		curs.C = buffer.lineLength( curs.L );
 	    }
 	    break;
 
@@ -332,7 +321,7 @@ bool NCTextPad::handleInput( wint_t key )
 	default:
 	    // if we are at limit of input
 
-	    if ( InputMaxLength >= 0 && InputMaxLength < (int) getText().length() )
+	    if ( InputMaxLength >= 0 && InputMaxLength < (int) buffer.length() )
 	    {
 		beep = true;
 		update = false;
@@ -369,7 +358,7 @@ bool NCTextPad::insert( wint_t key )
 	return false;
     }
 
-    assertWidth( ++( *cline ) );
+    assertWidth( buffer.lineLength( curs.L ) + 1 );
 
     cchar_t cchar;
     attr_t attr = 0;
@@ -391,26 +380,26 @@ bool NCTextPad::insert( wint_t key )
 #ifdef NCURSES_EXT_COLORS
     cchar.ext_color = 0;
 #endif
-    ret = ins_wch( curs.L, curs.C++, &cchar );
+    ret = ins_wch( curs.L, curs.C, &cchar );
+    if (ret != OK)
+	return false;
 
-    return (ret == OK);
+    buffer.insert( curs.L, curs.C++, key );
+
+    return true;
 }
 
 
 
 bool NCTextPad::openLine()
 {
-    assertHeight( lines.size() + 1 );
-    std::list<unsigned>::iterator newl( cline );
-    newl = lines.insert( ++newl, 0 );
+    assertHeight( buffer.lines() + 1 );
+    buffer.insert( curs.L, curs.C, L'\n' );
 
     if ( curs.C == 0 )
     {
 	// eazy at line begin: new empty line above
 	insertln();
-
-	( *newl ) = ( *cline );
-	( *cline ) = 0;
     }
     else
     {
@@ -418,20 +407,17 @@ bool NCTextPad::openLine()
 	move( curs.L + 1, 0 );
 	insertln();
 
-	if ( (unsigned) curs.C < ( *cline ) )
+	unsigned newlen = buffer.lineLength( curs.L + 1 );
+
+	if ( newlen > 0 )
 	{
 	    // copy down rest of line
-	    ( *newl ) = ( *cline ) - curs.C;
-	    ( *cline ) = curs.C;
-
 	    move( curs.L, curs.C );
-	    copywin( *this, curs.L, curs.C, curs.L + 1, 0, curs.L + 1, ( *newl ), false );
+	    copywin( *this, curs.L, curs.C, curs.L + 1, 0, curs.L + 1, newlen, false );
 	    clrtoeol();
 	}
     }
 
-    cline = newl;
-
     ++curs.L;
     curs.C = 0;
 
@@ -448,31 +434,27 @@ bool NCTextPad::delch( bool previous )
 	    --curs.C;
 	else if ( curs.L )
 	{
-	    --cline;
 	    --curs.L;
-	    curs.C = ( *cline );
+	    curs.C = buffer.lineLength( curs.L );
 	}
 	else
 	    return false;
     }
 
-    if ( (unsigned) curs.C < *cline )
+    if ( (unsigned) curs.C < buffer.lineLength( curs.L ) )
     {
 	// eazy not at line end
-	--( *cline );
+	buffer.erase( curs.L, curs.C );
 
 	NCPad::delch( curs.L, curs.C );
     }
-    else if ( (unsigned) curs.L + 1 < lines.size() )
+    else if ( (unsigned) curs.L + 1 < buffer.lines() )
     {
 	// at line end: join with next line
-	std::list<unsigned>::iterator nextl( cline );
-	++nextl;
-	( *cline ) += ( *nextl );
-	lines.erase( nextl );
+	buffer.erase( curs.L, curs.C );
 
-	assertWidth(( *cline ) );
-	copywin( *this, curs.L + 1, 0, curs.L, curs.C, curs.L, ( *cline ), false );
+	assertWidth( buffer.lineLength( curs.L ) );
+	copywin( *this, curs.L + 1, 0, curs.L, curs.C, curs.L, buffer.lineLength( curs.L ), false );
 
 	move( curs.L + 1, 0 );
 	deleteln();
@@ -497,6 +479,8 @@ void NCTextPad::setText( const NCtext & ntext )
     assertSze( wsze( ntext.Lines(), ntext.Columns() + 1 ) );
     curs = 0;
 
+    buffer.setText( ntext );
+
     cchar_t cchar;
     attr_t attr = 0;
     short int color = 0;
@@ -504,15 +488,14 @@ void NCTextPad::setText( const NCtext & ntext )
 
     wchar_t wch[2];
     wch[1] = L'\0';
-    lines.clear();
 
+    std::vector<cchar_t> cline;
     unsigned cl = 0;
 
     for ( NCtext::const_iterator line = ntext.begin(); line != ntext.end(); ++line )
     {
-	lines.push_back(( *line ).str().length() );
-
-	unsigned cc = 0;
+	cline.clear();
+	cline.reserve( line->str().length() );
 
 	for ( std::wstring::const_iterator c = line->str().begin(); c != line->str().end(); c++ )
 	{
@@ -532,16 +515,18 @@ void NCTextPad::setText( const NCtext & ntext )
 #ifdef NCURSES_EXT_COLORS
 	    cchar.ext_color = 0;
 #endif
-	    ins_wch( cl, cc++, &cchar );
+	    cline.push_back( cchar );
 	}
 
-	cl++;
-    }
+	// The pad was just cleared: Write the whole line at once instead of
+	// inserting character by character, which shifts the rest of the line
+	// each time.
 
-    if ( lines.empty() )
-	lines.push_back( 0U );
+	if ( ! cline.empty() )
+	    mvwadd_wchnstr( w, cl, 0, cline.data(), cline.size() );
 
-    cline = lines.begin();
+	cl++;
+    }
 
     if ( ocurs )
 	cursorOn();
@@ -553,48 +538,14 @@ void NCTextPad::setText( const NCtext & ntext )
 
 std::wstring NCTextPad::getText() const
 {
-    // just for inch(x,y) call, which isn't const due to
-    // hw cursor movement, but that's of no interest here.
-    NCTextPad * myself = const_cast<NCTextPad *>( this );
-
-    cchar_t cchar;
-    std::wstring ret;
-    unsigned l = 0;
-    wchar_t wch[CCHARW_MAX+1];
-    attr_t attr;
-    short int colorpair;
-
-    for ( std::list<unsigned>::const_iterator cgetl( lines.begin() ); cgetl != lines.end(); ++cgetl )
-    {
-	for ( unsigned c = 0; c < ( *cgetl ); ++c )
-	{
-	    myself->in_wchar( l, c, &cchar );
-	    getcchar( &cchar, wch, &attr, &colorpair, NULL );
-
-	    //replace right arrow back for horizontal tab - see setText method above (#142509)
-
-	    if ( wch[0] == 8677 )
-		wch[0] = 9;
-
-	    ret += wch[0];
-	}
-
-	++l;
-	// do not append \n after the very last line (bnc #573553)
-	if ( l < lines.size() )
-	{
-	    ret += L"\n";
-	}
-    }
-
-    return ret;
+    return buffer.text();
 }
 
 
 std::ostream & operator<<( std::ostream & str, const NCTextPad & obj )
 {
     str << "at " << obj.CurPos() << " on " << wsze( obj.height(), obj.width() )
-    << " lines " << obj.lines.size() << " (" << *obj.cline << ")";
+    << " lines " << obj.buffer.lines() << " (" << obj.buffer.lineLength( obj.CurPos().L ) << ")";
     return str;
 }
 
@@ -602,7 +553,7 @@ void NCTextPad::setInputMaxLength( int nr )
 {
     // if there is more text then the maximum number of chars,
     // truncate the text and update the buffer
-    if ( nr >= 0 && nr < (int) getText().length() )
+    if ( nr >= 0 && nr < (int) buffer.length() )
     {
 	NCstring newtext = getText().substr( 0, nr );
 	setText( newtext );
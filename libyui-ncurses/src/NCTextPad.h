@@ -26,10 +26,10 @@
 #define NCTextPad_h
 
 #include <iosfwd>
-#include <list>
 
 #include "NCPad.h"
 #include "NCtext.h"
+#include "NCTextBuffer.h"
 
 
 class NCTextPad : public NCPad
@@ -42,8 +42,8 @@ class NCTextPad : public NCPad
 
 private:
 
-    std::list<unsigned>	     lines;
-    std::list<unsigned>::iterator cline;
+    /// The text; the pad only displays it
+    NCTextBuffer buffer;
 
     wpos curs;
     bool curson;
@@ -83,6 +83,12 @@ public:
     void setText( const NCtext & ntext );
     std::wstring getText() const;
 
+    /// Number of characters of the text (including newlines)
+    size_t textLength() const { return buffer.length(); }
+
+    /// Counter that is incremented with each change of the text
+    unsigned long changes() const { return buffer.changes(); }
+
     // limits  the input to numberOfChars characters and truncates the text
     // if appropriate
     void setInputMaxLength( int nr );
@@ -130,6 +130,7 @@ void NCTimeField::setValue ( const std::string & ntext )
     fldstart = 0;
 
     tUpdate();
+    markChanged();
   }
 }
 
@@ -222,8 +222,18 @@ void NCTree::setLabel( const string & nlabel )
 
 void NCTree::rebuildTree()
 {
+    // After the application added lazy children (see YTree::childrenLoaded()),
+    // the item indices after them change anyway since they are the line
+    // numbers in the pad: Simply build the pad again, which only costs as
+    // much as the items loaded so far, and keep the current item.
+
+    YTreeItem * current = loadedItem() ? getCurrentItem() : 0;
+
     DelPad();
     Redraw();
+
+    if ( current && myPad() )
+	myPad()->ShowItem( getTreeLine( current->index() ) );
 }
 
 
@@ -252,31 +262,12 @@ void NCTree::CreateTreeLines( NCTreeLine * parentLine,
     NCTreeLine * line = new NCTreeLine( parentLine, treeItem, _multiSelect );
     pad->Append( line );
 
-    if ( item->selected() )
+    if ( item->selected() && _multiSelect )
     {
-        // Retrieve the position of the item
-        int at = treeItem->index();
-
-        NCTreeLine * currentLine = 0;
-        NCTableCol * currentCol = 0;
-
-        if ( _multiSelect )
-        {
-            currentLine = modifyTreeLine( at );
+        NCTableCol * currentCol = line->GetCol(0);
 
-            if ( currentLine )
-                currentCol = currentLine->GetCol(0);
-
-            if ( currentCol )
-            {
-                currentCol->setPrefix( currentLine->indentationStr() + "[x] " );
-            }
-        }
-
-        // Highlight the selected item and expand the tree if it is in a
-        // currently hidden branch
-
-        pad->ShowItem( getTreeLine( at ) );
+        if ( currentCol )
+            currentCol->setPrefix( line->indentationStr() + "[x] " );
     }
 
     // Recursively create TreeLines for the children of this item
@@ -314,6 +305,18 @@ void NCTree::DrawPad()
 	CreateTreeLines( 0, myPad(), *it );
     }
 
+    // Highlight the selected items and expand the tree if they are in a
+    // currently hidden branch. Do this only now: It formats the lines, and
+    // the tree graphics need the siblings and children of each line.
+
+    for ( unsigned i = 0; i < myPad()->Lines(); ++i )
+    {
+	const NCTreeLine * line = getTreeLine( i );
+
+	if ( line && line->YItem()->selected() )
+	    myPad()->ShowItem( line );
+    }
+
     NCPadWidget::DrawPad();
 }
 
@@ -323,6 +326,23 @@ NCursesEvent NCTree::wHandleInput( wint_t key )
     NCursesEvent ret = NCursesEvent::none;
     YTreeItem * oldCurrentItem = getCurrentItem();
 
+    if ( oldCurrentItem && oldCurrentItem->hasLazyChildren() )
+    {
+	switch ( key )
+	{
+	    case KEY_IC:
+	    case '+':
+	    case KEY_SPACE:
+		// The application has to create the children first; it will
+		// call childrenLoaded() when it's done.
+
+		oldCurrentItem->setOpen( true );
+		setExpandedItem( oldCurrentItem );
+
+		return NCursesEvent::ItemExpanded;
+	}
+    }
+
     // Call the pad's input handler via NCPadWidget::handleInput()
     // which may call its base pad class's input handler
     // which may call the current item's input handler.
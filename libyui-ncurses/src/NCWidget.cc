@@ -345,7 +345,7 @@ void NCWidget::wDelete()
 	    ch->Value()->wDelete();
 	}
 
-	win->clear();
+	win->erase();
 
 	delete win;
 	win = 0;
@@ -445,7 +445,7 @@ void NCWidget::Redraw( bool sub )
 
     if ( sub )
     {
-	win->clear();
+	win->erase();
 	wRedraw();
 
 	for ( tnode<NCWidget *> * ch = Fchild(); ch; ch = ch->Nsibling() )
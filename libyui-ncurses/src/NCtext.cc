@@ -38,6 +38,7 @@ const NCstring NCtext::emptyStr;
 
 
 NCtext::NCtext( const NCstring & nstr )
+    : mmaxColumns( 0 )
 {
     lset( nstr );
 }
@@ -45,6 +46,7 @@ NCtext::NCtext( const NCstring & nstr )
 
 
 NCtext::NCtext( const NCstring & nstr, size_t columns )
+    : mmaxColumns( 0 )
 {
     lbrset( nstr, columns );
 }
@@ -58,44 +60,32 @@ NCtext::~NCtext()
 
 void NCtext::lset( const NCstring & ntext )
 {
-    // FIXME: rewrite this function so one understands it
-
     mtext.clear();
-    mtext.push_back( "" );
-
-    if ( ntext.str().empty() )
-	return;
+    mcolumns.clear();
+    mmaxColumns = 0;
 
     std::wstring text( ntext.str() );
 
-    std::wstring::size_type spos = 0;
-
-    std::wstring::size_type cpos = std::wstring::npos;
-
-    bool sawnl = false;		// saw new line
-
     // handle DOS text
     boost::erase_all( text, L"\r" );
 
-    while (( cpos = text.find( L'\n', spos ) ) != std::wstring::npos )
-    {
-	if ( sawnl )
-	    mtext.push_back( "" );
-
-	mtext.back() = NCstring( mtext.back().str() + text.substr( spos, cpos - spos ) );
+    // One line per newline; a trailing newline doesn't start another line
 
-	sawnl = true;
+    std::wstring::size_type spos = 0;
+    std::wstring::size_type cpos = std::wstring::npos;
 
+    while (( cpos = text.find( L'\n', spos ) ) != std::wstring::npos )
+    {
+	addLine( NCstring( text.substr( spos, cpos - spos ) ) );
 	spos = cpos + 1;
     }
 
     if ( spos < text.size() )
-    {
-	if ( sawnl )
-	    mtext.push_back( "" );
+	addLine( NCstring( text.substr( spos ) ) );
 
-	mtext.back() = NCstring( mtext.back().str() + text.substr( spos ) );
-    }
+    // There is always at least one (maybe empty) line
+    if ( mtext.empty() )
+	addLine( "" );
 }
 
 
@@ -103,6 +93,8 @@ void NCtext::lset( const NCstring & ntext )
 void NCtext::lbrset( const NCstring & ntext, size_t columns )
 {
     mtext.clear();
+    mcolumns.clear();
+    mmaxColumns = 0;
 
     if ( ntext.str().empty() )
 	return;
@@ -124,17 +116,17 @@ void NCtext::lbrset( const NCstring & ntext, size_t columns )
 
 	if ( line.size() <= columns )
 	{
-	    mtext.push_back( NCstring( line ) );
+	    addLine( NCstring( line ) );
 	}
 	else
 	{
 	    size_t start = columns;
-	    mtext.push_back( NCstring( line.substr( 0, columns ) ) );
+	    addLine( NCstring( line.substr( 0, columns ) ) );
 
 	    while ( start < line.size() )
 	    {
 		// yuiDebug() << "Add: " << line.substr( start, columns ) << std::endl;
-		mtext.push_back( NCstring( L'~' + line.substr( start, columns - 1 ) ) );
+		addLine( NCstring( L'~' + line.substr( start, columns - 1 ) ) );
 		start += columns - 1;
 	    }
 	}
@@ -146,15 +138,61 @@ void NCtext::lbrset( const NCstring & ntext, size_t columns )
 
     if ( spos < text.size() )
     {
-	mtext.push_back( NCstring( text.substr( spos ) ) );
+	addLine( NCstring( text.substr( spos ) ) );
     }
 }
 
 
 
+void NCtext::addLine( const NCstring & line )
+{
+    size_t columns = lineColumns( line );
+
+    mtext.push_back( line );
+    mcolumns.push_back( columns );
+
+    if ( columns > mmaxColumns )
+	mmaxColumns = columns;
+}
+
+
+
+void NCtext::recalcColumns()
+{
+    mmaxColumns = 0;
+
+    for ( size_t i = 0; i < mtext.size(); ++i )
+    {
+	mcolumns[i] = lineColumns( mtext[i] );
+
+	if ( mcolumns[i] > mmaxColumns )
+	    mmaxColumns = mcolumns[i];
+    }
+}
+
+
+
+size_t NCtext::lineColumns( const NCstring & line )
+{
+    size_t len = 0;
+    const std::wstring & wstr = line.str();
+
+    for ( std::wstring::const_iterator wstr_it = wstr.begin(); wstr_it != wstr.end(); ++wstr_it )
+    {
+	if ( iswprint( *wstr_it ) )
+	    len += wcwidth( *wstr_it );
+	else if ( *wstr_it == L'\t' )
+	    len += NCurses::tabsize();
+    }
+
+    return len;
+}
+
+
+
 unsigned NCtext::Lines() const
 {
-    if ( mtext.size() == 1 && mtext.front().Str() == "" )
+    if ( mtext.size() == 1 && mtext.front().str().empty() )
     {
 	return 0;
     }
@@ -166,36 +204,14 @@ unsigned NCtext::Lines() const
 
 void NCtext::append( const NCstring &line )
 {
-    mtext.push_back( line );
+    addLine( line );
 }
 
 
 
 size_t NCtext::Columns() const
 {
-    size_t llen = 0;		// longest line
-    size_t tmp_len = 0;		// width of current line
-
-    const_iterator line;		// iterator for list <NCstring> mtext
-    std::wstring::const_iterator wstr_it;	// iterator for std::wstring
-
-    for ( line = mtext.begin(); line != mtext.end(); ++line )
-    {
-	tmp_len = 0;
-
-	for ( wstr_it = ( *line ).str().begin(); wstr_it != ( *line ).str().end() ; ++wstr_it )
-	{
-	    if ( iswprint( *wstr_it ) )
-		tmp_len += wcwidth( *wstr_it );
-	    else if ( *wstr_it == L'\t' )
-		tmp_len += NCurses::tabsize();
-	}
-
-	if ( tmp_len > llen )
-	    llen = tmp_len;
-    }
-
-    return llen;
+    return mmaxColumns;
 }
 
 
@@ -205,12 +221,7 @@ const NCstring & NCtext::operator[]( std::wstring::size_type idx ) const
     if ( idx >= Lines() )
 	return emptyStr;
 
-    const_iterator line = mtext.begin();
-
-    for ( ; idx; --idx, ++line )
-	;
-
-    return *line;
+    return mtext[ idx ];
 }
 
 
@@ -238,6 +249,9 @@ void NClabel::stripHotkey()
 	    break;
 	}
     }
+
+    // Removing the hotkey marker (and un-escaping "&&") changed line widths
+    recalcColumns();
 }
 
 
@@ -26,7 +26,7 @@
 #define NCtext_h
 
 #include <iosfwd>
-#include <list>
+#include <vector>
 
 #include "NCstring.h"
 #include "NCWidget.h"
@@ -41,8 +41,8 @@ class NCtext
 
 public:
 
-    typedef std::list<NCstring>::iterator	   iterator;
-    typedef std::list<NCstring>::const_iterator const_iterator;
+    typedef std::vector<NCstring>::iterator	     iterator;
+    typedef std::vector<NCstring>::const_iterator const_iterator;
 
 private:
 
@@ -50,11 +50,26 @@ private:
 
 protected:
 
-    std::list<NCstring> mtext;
+    std::vector<NCstring> mtext;
+
+    /// Display width of each line in mtext, calculated when it is added
+    std::vector<size_t> mcolumns;
+
+    /// Display width of the widest line
+    size_t mmaxColumns;
 
     virtual void lset( const NCstring & ntext );
     void lbrset( const NCstring & ntext, size_t columns );
 
+    /// Add a line and cache its display width
+    void addLine( const NCstring & line );
+
+    /// Recalculate the cached display widths after lines were changed in place
+    void recalcColumns();
+
+    /// Display width of 'line' in terminal columns
+    static size_t lineColumns( const NCstring & line );
+
 public:
 
     NCtext( const NCstring & nstr = "" );
@@ -67,7 +82,7 @@ public:
 
     void append( const NCstring & line );
 
-    const std::list<NCstring> & Text() const { return mtext; }
+    const std::vector<NCstring> & Text() const { return mtext; }
 
     const NCstring &	   operator[]( std::wstring::size_type idx ) const;
 
@@ -108,7 +123,7 @@ public:
 
     wsze     size()   const { return wsze( Lines(), Columns() ); }
 
-    const std::list<NCstring> & getText() const { return Text(); }
+    const std::vector<NCstring> & getText() const { return Text(); }
 
     void drawAt( NCursesWindow & w, chtype style, chtype hotstyle,
 		 const wrect & dim,
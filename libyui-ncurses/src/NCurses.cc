@@ -32,14 +32,18 @@
 
 #define  YUILogComponent "ncurses"
 #include <yui/YUILog.h>
+#include <yui/YMacro.h>
+#include <yui/YLatencyHistogram.h>
 #include "NCurses.h"
 #include "NCDialog.h"
+#include "NCScreenSnapshot.h"
 
 #include "stdutil.h"
 #include <signal.h>
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <fcntl.h>
 #include <fnmatch.h>
 
@@ -48,9 +52,18 @@ using stdutil::form;
 
 NCurses * NCurses::myself = 0;
 std::set<NCDialog*> NCurses::_knownDlgs;
+int	  NCurses::_ioStatsFd	    = -1;
+pid_t	  NCurses::_ioStatsThread   = 0;
+int	  NCurses::_statsFileFd	    = -1;
+long long NCurses::_bytesWritten    = 0;
+long long NCurses::_screenUpdates   = 0;
+long long NCurses::_reportedUpdates = -1;
+std::string NCurses::_screenDumpPath;
+volatile sig_atomic_t NCurses::_screenDumpRequested = 0;
 const NCursesEvent NCursesEvent::Activated( NCursesEvent::button, YEvent::Activated );
 const NCursesEvent NCursesEvent::SelectionChanged( NCursesEvent::button, YEvent::SelectionChanged );
 const NCursesEvent NCursesEvent::ValueChanged( NCursesEvent::button, YEvent::ValueChanged );
+const NCursesEvent NCursesEvent::ItemExpanded( NCursesEvent::button, YEvent::ItemExpanded );
 
 
 
@@ -161,6 +174,20 @@ NCurses::~NCurses()
     if ( theTerm )
 	::delscreen( theTerm );
 
+    if ( countingOutput() )
+    {
+	yuiMilestone() << "Terminal output: " << _bytesWritten << " bytes in "
+		       << _screenUpdates << " screen updates" << std::endl;
+	::close( _ioStatsFd );
+	_ioStatsFd = -1;
+    }
+
+    if ( _statsFileFd >= 0 )
+    {
+	::close( _statsFileFd );
+	_statsFileFd = -1;
+    }
+
     yuiMilestone() << "NCurses down" << std::endl;
 }
 
@@ -192,6 +219,43 @@ void NCurses::init()
     << std::endl;
     yuiMilestone() << "TERM=" << envTerm << std::endl;
 
+    const char * outputStats = getenv( "Y2NCURSES_OUTPUT_STATS" );
+
+    if ( outputStats )
+    {
+	openIoStats();
+
+	if ( _ioStatsFd < 0 )
+	    yuiError() << "Can't count the terminal output: " << strerror( errno ) << std::endl;
+	else
+	    yuiMilestone() << "Counting the terminal output" << std::endl;
+
+	if ( _ioStatsFd >= 0 && outputStats[0] == '/' )
+	{
+	    _statsFileFd = open( outputStats, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644 );
+
+	    if ( _statsFileFd < 0 )
+		yuiError() << "Can't write the output stats: " << outputStats << ": " << strerror( errno ) << std::endl;
+	}
+    }
+
+    const char * screenDump = getenv( "Y2NCURSES_SCREEN_DUMP" );
+
+    if ( screenDump && screenDump[0] == '/' )
+    {
+	_screenDumpPath = screenDump;
+
+	// No SA_RESTART: waiting for input has to be interrupted to write
+	// the snapshot right away
+	struct sigaction action;
+	memset( &action, 0, sizeof( action ) );
+	action.sa_handler = requestScreenDump;
+	sigemptyset( &action.sa_mask );
+	sigaction( SIGUSR1, &action, 0 );
+
+	yuiMilestone() << "Writing screen snapshots to " << _screenDumpPath << " on SIGUSR1" << std::endl;
+    }
+
     signal( SIGINT, SIG_IGN );	// ignore Ctrl C
 
     //rip off the top line
@@ -416,8 +480,19 @@ void NCurses::Update()
 {
     if ( myself && myself->initialized() )
     {
-	//myself->stdpan->refresh();
-	myself->stdpan->redraw();
+	YStopWatch stopWatch;
+	long long bytesBefore = threadBytesWritten();
+
+	// Only copy the changed parts of the panels to the screen: Widget
+	// windows are created with syncok(), so each change is propagated to
+	// the dialog's panel window, and update_panels() takes care of the
+	// overlapping panels.
+	myself->stdpan->refresh();
+
+	countUpdate( bytesBefore );
+
+	if ( YMacro::playing() )
+	    YMacro::recordTiming( "render", stopWatch.elapsed() );
     }
 }
 
@@ -427,10 +502,21 @@ void NCurses::Refresh()
     if ( myself && myself->initialized() )
     {
 	yuiDebug() << "start refresh ..." << std::endl;
+	YStopWatch stopWatch;
+	long long bytesBefore = threadBytesWritten();
+
+	// Repaint the whole terminal (Ctrl-L): The screen may have been
+	// garbled by some other output.
 	SetTitle( myself->title_t );
 	SetStatusLine( myself->status_line );
 	::clearok( ::stdscr, true );
 	myself->stdpan->refresh();
+
+	countUpdate( bytesBefore );
+
+	if ( YMacro::playing() )
+	    YMacro::recordTiming( "render", stopWatch.elapsed() );
+
 	yuiDebug() << "done refresh ..." << std::endl;
     }
 }
@@ -457,21 +543,107 @@ void NCurses::Redraw()
 	    pan = ::panel_above( pan );
 	}
 
-	// TBD: initialize all dialogs rewdraw
-	Refresh();
+	// All dialogs are drawn anew, but curses still knows what is on the
+	// screen: No need to clear and repaint the whole terminal.
+	long long bytesBefore = threadBytesWritten();
+
+	SetTitle( myself->title_t );
+	SetStatusLine( myself->status_line );
+	myself->stdpan->redraw();
+
+	countUpdate( bytesBefore );
 
 	yuiDebug() << "done redraw ..." << std::endl;
     }
 }
 
 
+void NCurses::openIoStats()
+{
+    // The I/O counters of the calling thread only: Other threads (the
+    // application, the REST API server, ...) write to other files meanwhile
+    _ioStatsThread = syscall( SYS_gettid );
+    _ioStatsFd	   = open( form( "/proc/self/task/%d/io", (int) _ioStatsThread ).c_str(),
+			   O_RDONLY | O_CLOEXEC );
+}
+
+
+long long NCurses::threadBytesWritten()
+{
+    if ( _ioStatsFd < 0 )
+	return 0;
+
+    // With a separate UI thread the screen updates don't happen in the
+    // thread that called init()
+    if ( syscall( SYS_gettid ) != _ioStatsThread )
+    {
+	::close( _ioStatsFd );
+	openIoStats();
+
+	if ( _ioStatsFd < 0 )
+	{
+	    yuiError() << "Can't count the terminal output: " << strerror( errno ) << std::endl;
+	    return 0;
+	}
+    }
+
+    char buf[512];
+    ssize_t len = ::pread( _ioStatsFd, buf, sizeof( buf ) - 1, 0 );
+
+    if ( len <= 0 )
+	return 0;
+
+    buf[ len ] = 0;
+    const char * wchar = strstr( buf, "wchar: " );
+
+    return wchar ? atoll( wchar + 7 ) : 0;
+}
+
+
+void NCurses::countUpdate( long long bytesBefore )
+{
+    ++_screenUpdates;
+
+    if ( _ioStatsFd >= 0 )
+	_bytesWritten += threadBytesWritten() - bytesBefore;
+}
+
+
+void NCurses::requestScreenDump( int signal )
+{
+    _screenDumpRequested = 1;
+}
+
+
+void NCurses::waitingForInput()
+{
+    if ( _screenDumpRequested )
+    {
+	_screenDumpRequested = 0;
+	NCScreenSnapshot::save( _screenDumpPath );
+    }
+
+    if ( _statsFileFd < 0 || _screenUpdates == _reportedUpdates )
+	return;
+
+    // One write() per line so readers never see a partial line
+    char line[80];
+    int len = snprintf( line, sizeof( line ), "%lld %lld\n", _bytesWritten, _screenUpdates );
+
+    if ( ::write( _statsFileFd, line, len ) != len )
+	yuiError() << "Can't write the output stats: " << strerror( errno ) << std::endl;
+
+    _reportedUpdates = _screenUpdates;
+}
+
+
 void NCurses::SetTitle( const std::string & str )
 {
     if ( myself && myself->title_w )
     {
 	myself->title_t = str;
 	::wbkgd( myself->title_w, myself->style()( NCstyle::AppTitle ) );
-	::wclear( myself->title_w );
+	::werase( myself->title_w );	// not wclear(): that would repaint the whole screen
 
 	yuiDebug() << "Draw title called" << std::endl;
 
@@ -532,6 +704,41 @@ void NCurses::drawTitle()
 }
 
 
+wint_t NCurses::pendingKey()
+{
+    // Read the key the same way as NCDialog::getinput() and push it back
+
+    wint_t key = WEOF;
+    ::nodelay( ::stdscr, true );
+
+    if ( NCstring::terminalEncoding() == "UTF-8" )
+    {
+	int ret = ::get_wch( &key );
+
+	if ( ret == KEY_CODE_YES )
+	    ::ungetch( key );
+	else if ( ret == OK )
+	    ::unget_wch( key );
+	else
+	    key = WEOF;
+    }
+    else
+    {
+	int ch = ::getch();
+
+	if ( ch != ERR )
+	{
+	    ::ungetch( ch );
+	    key = ch;
+	}
+    }
+
+    ::nodelay( ::stdscr, false );
+
+    return key;
+}
+
+
 
 void NCurses::RememberDlg( NCDialog * dlg_r )
 {
@@ -633,7 +840,9 @@ void NCurses::ResizeEvent()
 	SetStatusLine( myself->status_line );
 	//update the screen
 	::touchwin( myself->status_w );
+	long long bytesBefore = threadBytesWritten();
 	::doupdate();
+	countUpdate( bytesBefore );
 
 	yuiDebug() << "done resize ..." << std::endl;
     }
@@ -35,6 +35,7 @@
 #include <yui/YMenuItem.h>
 
 #include <ncursesw/curses.h>	/* curses.h: #define  NCURSES_CH_T cchar_t */
+#include <signal.h>
 #include <wchar.h>
 
 #include "ncursesw.h"
@@ -134,6 +135,7 @@ public:
     static const NCursesEvent Activated;
     static const NCursesEvent SelectionChanged;
     static const NCursesEvent ValueChanged;
+    static const NCursesEvent ItemExpanded;
 };
 
 extern std::ostream & operator<<( std::ostream & str, const NCursesEvent & obj );
@@ -211,6 +213,52 @@ public:
 
     static void drawTitle();
 
+    /**
+     * Return the next key waiting in the input queue without removing it,
+     * or WEOF if there is none. Widgets can use this to skip expensive
+     * updates that the next key would make obsolete anyway, e.g. while the
+     * user holds down a cursor key.
+     **/
+    static wint_t pendingKey();
+
+    /**
+     * Return 'true' if the output to the terminal is counted. This is
+     * switched on with the environment variable Y2NCURSES_OUTPUT_STATS and
+     * needs the per thread I/O counters in /proc.
+     **/
+    static bool countingOutput() { return _ioStatsFd >= 0; }
+
+    /**
+     * Return the number of bytes written to the terminal by screen updates
+     * so far. This is always 0 if countingOutput() is 'false'.
+     **/
+    static long long bytesWritten() { return _bytesWritten; }
+
+    /**
+     * Return the number of screen updates (doupdate() calls) so far.
+     **/
+    static long long screenUpdates() { return _screenUpdates; }
+
+    /**
+     * Report that the UI is about to wait for input, i.e. it is done with the
+     * previous input. If Y2NCURSES_OUTPUT_STATS is set to an absolute path
+     * and there were screen updates since the last report, this appends the
+     * totals so far as one line "<bytes> <screen updates>" to that file.
+     * Tools driving the UI use this to find out when a keystroke is handled.
+     *
+     * This also writes the screen snapshot requested with SIGUSR1 if
+     * Y2NCURSES_SCREEN_DUMP is set to an absolute path (see
+     * NCScreenSnapshot).
+     **/
+    static void waitingForInput();
+
+    /**
+     * Return 'true' if a screen snapshot was requested and not written yet.
+     * Waiting for input is interrupted by the request, the input loop should
+     * call waitingForInput() and continue waiting.
+     **/
+    static bool screenDumpRequested() { return _screenDumpRequested; }
+
 public:
     // actually not for public use
     static void ForgetDlg( NCDialog * dlg_r );
@@ -220,6 +268,42 @@ public:
 
 private:
     static std::set<NCDialog*> _knownDlgs;
+
+    /**
+     * Open the I/O counters of the calling thread.
+     **/
+    static void openIoStats();
+
+    /**
+     * Return the number of bytes the calling thread has passed to write()
+     * so far, or 0 if the output is not counted.
+     *
+     * During a screen update this thread only writes the output buffer of
+     * curses to the terminal: Curses uses write() on the terminal file
+     * descriptor directly, not the output stream passed to newterm().
+     **/
+    static long long threadBytesWritten();
+
+    /**
+     * Count one screen update that started when threadBytesWritten()
+     * returned 'bytesBefore'.
+     **/
+    static void countUpdate( long long bytesBefore );
+
+    /**
+     * Signal handler for SIGUSR1: Request a screen snapshot.
+     **/
+    static void requestScreenDump( int signal );
+
+    static int	     _ioStatsFd;
+    static pid_t     _ioStatsThread;
+    static int	     _statsFileFd;
+    static long long _bytesWritten;
+    static long long _screenUpdates;
+    static long long _reportedUpdates;
+
+    static std::string		 _screenDumpPath;
+    static volatile sig_atomic_t _screenDumpRequested;
 };
 
 
@@ -353,6 +353,11 @@ NCursesWindow::NCursesWindow( NCursesWindow& win, int l, int c,
 
     // yuiDebug() << "created " << wpos(begin_y, begin_x) << wsze(l, c) << std::endl;
 
+    // Propagate each change to the parent windows, so the dialog's panel
+    // window knows which lines have to be copied to the screen. Otherwise
+    // every panel would have to be touched completely for each update.
+    ::syncok( w, TRUE );
+
     par = &win;
     sib = win.subwins;
     win.subwins = this;
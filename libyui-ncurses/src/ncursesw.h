@@ -1736,8 +1736,14 @@ public:
 			    int dminrow, int dmincol,
 			    int dmaxrow, int dmaxcol, bool overlay = TRUE )
     {
-	return ::copywin( w, win.w, sminrow, smincol, dminrow, dmincol,
-			  dmaxrow, dmaxcol, (int) ( overlay ? 1 : 0 ) );
+	int ret = ::copywin( w, win.w, sminrow, smincol, dminrow, dmincol,
+			     dmaxrow, dmaxcol, (int) ( overlay ? 1 : 0 ) );
+
+	// copywin() does not propagate the change to the parent windows
+	// like all other output functions do for syncok() windows
+	::wsyncup( win.w );
+
+	return ret;
     }
 
     // -------------------------------------------------------------------------
@@ -0,0 +1,192 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the NCTextBuffer class: Check the gap buffer
+// against a plain std::wstring with the same edits.
+
+#define BOOST_TEST_MODULE NCTextBuffer_tests
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "NCTextBuffer.h"
+#include "NCtext.h"
+
+#define RANDOM_EDITS	200000
+#define MAX_LENGTH	3000
+
+using std::wstring;
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+/**
+ * Return the length of each line of 'text'.
+ **/
+std::vector<unsigned> lineLengths( const wstring & text )
+{
+    std::vector<unsigned> lengths( 1, 0 );
+
+    for ( wchar_t ch : text )
+    {
+        if ( ch == L'\n' )
+            lengths.push_back( 0 );
+        else
+            ++lengths.back();
+    }
+
+    return lengths;
+}
+
+/**
+ * Return the offset of 'line', 'col' in 'text'.
+ **/
+size_t offset( const wstring & text, unsigned line, unsigned col )
+{
+    size_t pos = 0;
+
+    for ( ; line > 0; --line )
+        pos = text.find( L'\n', pos ) + 1;
+
+    return pos + col;
+}
+
+/**
+ * Check that 'buffer' has the same content and line index as 'text'.
+ **/
+void checkBuffer( const NCTextBuffer & buffer, const wstring & text )
+{
+    BOOST_REQUIRE( buffer.text() == text );
+    BOOST_REQUIRE_EQUAL( buffer.length(), text.length() );
+
+    std::vector<unsigned> lengths = lineLengths( text );
+    BOOST_REQUIRE_EQUAL( buffer.lines(), lengths.size() );
+
+    for ( unsigned line = 0; line < lengths.size(); ++line )
+        BOOST_REQUIRE_EQUAL( buffer.lineLength( line ), lengths[ line ] );
+}
+
+
+BOOST_AUTO_TEST_CASE( empty )
+{
+    NCTextBuffer buffer;
+
+    checkBuffer( buffer, L"" );
+    BOOST_CHECK( ! buffer.erase( 0, 0 ) );
+    BOOST_CHECK_EQUAL( buffer.changes(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( set_text )
+{
+    NCTextBuffer buffer;
+    buffer.setText( NCtext( NCstring( "first\n\nthird line" ) ) );
+
+    checkBuffer( buffer, L"first\n\nthird line" );
+    BOOST_CHECK_EQUAL( buffer.changes(), 1 );
+
+    buffer.setText( NCtext( NCstring( "" ) ) );
+    checkBuffer( buffer, L"" );
+}
+
+BOOST_AUTO_TEST_CASE( split_and_join )
+{
+    NCTextBuffer buffer;
+    buffer.setText( NCtext( NCstring( "abcdef" ) ) );
+
+    buffer.insert( 0, 3, L'\n' );
+    checkBuffer( buffer, L"abc\ndef" );
+
+    // delete the '\n' at the end of the first line
+    BOOST_CHECK( buffer.erase( 0, 3 ) );
+    checkBuffer( buffer, L"abcdef" );
+
+    // nothing to delete at the end of the last line
+    BOOST_CHECK( ! buffer.erase( 0, 6 ) );
+    BOOST_CHECK_EQUAL( buffer.changes(), 3 );
+}
+
+BOOST_AUTO_TEST_CASE( random_edits )
+{
+    // a fixed seed so a failure can be reproduced
+    std::mt19937 random( 42 );
+    const wchar_t chars[] = L"ab \nä中";
+
+    NCTextBuffer buffer;
+    wstring	 text;
+    std::vector<unsigned> lengths = lineLengths( text );
+
+    for ( int i = 0; i < RANDOM_EDITS; i++ )
+    {
+        unsigned line = random() % lengths.size();
+        unsigned col  = random() % ( lengths[ line ] + 1 );
+
+        // Mostly insert until the text is long enough, then mostly erase
+        // so the text length stays around MAX_LENGTH; also edit in runs
+        // at the same position like typing does.
+
+        bool insert = random() % MAX_LENGTH >= text.length() / 2;
+        int  count  = 1 + random() % 8;
+
+        for ( int n = 0; n < count; n++ )
+        {
+            if ( insert )
+            {
+                wchar_t ch = chars[ random() % ( sizeof( chars ) / sizeof( wchar_t ) - 1 ) ];
+                text.insert( offset( text, line, col ), 1, ch );
+                buffer.insert( line, col, ch );
+
+                if ( ch == L'\n' )
+                {
+                    ++line;
+                    col = 0;
+                }
+                else
+                {
+                    ++col;
+                }
+            }
+            else
+            {
+                size_t pos = offset( text, line, col );
+                bool erased = buffer.erase( line, col );
+
+                BOOST_REQUIRE_EQUAL( erased, pos < text.length() );
+
+                if ( erased )
+                    text.erase( pos, 1 );
+            }
+        }
+
+        lengths = lineLengths( text );
+
+        if ( i % 1000 == 0 )
+            checkBuffer( buffer, text );
+    }
+
+    checkBuffer( buffer, text );
+}
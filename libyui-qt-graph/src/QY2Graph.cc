@@ -24,10 +24,23 @@
 #include <QKeyEvent>
 #include <QWheelEvent>
 #include <QGraphicsSceneMouseEvent>
+#include <QStyleOptionGraphicsItem>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
 
 #include "QY2Graph.h"
 
 
+// Below this level of detail (roughly the zoom factor) nodes and edges are
+// drawn simplified: no labels, no arrows and no antialiasing.
+#define LOD_THRESHOLD 0.4
+
+
+// Graphviz uses global state and is not thread-safe.
+static QMutex graphvizMutex;
+
+
 QY2Graph::QY2Graph(const std::string& filename, const std::string& layoutAlgorithm, QWidget* parent)
     : QGraphicsView(parent)
 {
@@ -48,18 +61,24 @@ QY2Graph::QY2Graph(graph_t* graph, QWidget* parent)
 
 QY2Graph::~QY2Graph()
 {
+    abandonLayoutThread();
 }
 
 
 void
 QY2Graph::init()
 {
+    layoutThread = 0;
+
     setRenderHint(QPainter::Antialiasing);
     setRenderHint(QPainter::TextAntialiasing);
     setDragMode(QGraphicsView::ScrollHandDrag);
     setTransformationAnchor(AnchorUnderMouse);
     setResizeAnchor(AnchorUnderMouse);
 
+    // All items restore the painter state themselves
+    setOptimizationFlags(QGraphicsView::DontSavePainterState);
+
     scene = new QGraphicsScene(this);
     scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
     setScene(scene);
@@ -117,6 +136,9 @@ QY2Graph::scaleView(qreal scaleFactor)
 	scaleFactor = 0.1 / f;
 
     scale(scaleFactor, scaleFactor);
+
+    // Antialiasing is expensive and pointless for the simplified rendering
+    setRenderHint(QPainter::Antialiasing, scaleFactor * f >= LOD_THRESHOLD);
 }
 
 
@@ -219,50 +241,78 @@ QY2Graph::drawArrow(const QLineF& line, const QColor& color, QPainter* painter)
 void
 QY2Graph::renderGraph(const std::string& filename, const std::string& layoutAlgorithm)
 {
-    FILE* fp = fopen(filename.c_str(), "r");
-    if (fp)
-    {
-	GVC_t* gvc = gvContext();
-	if (gvc != NULL)
-	{
-#ifdef WITH_CGRAPH
-	    graph_t* graph = agread(fp, NULL);
-#else
-	    graph_t* graph = agread(fp);
-#endif
-	    if (graph != NULL)
-	    {
-		if (gvLayout(gvc, graph, const_cast<char*>(layoutAlgorithm.c_str())) == 0)
-		{
-		    renderGraph(graph);
+    abandonLayoutThread();
+    clearGraph();
 
-		    gvFreeLayout(gvc, graph);
-		}
-		else
-		{
-		    qCritical("gvLayout() failed");
-		}
+    layoutThread = new QY2GraphLayoutThread(filename, layoutAlgorithm, this);
 
-		agclose(graph);
-	    }
-	    else
-	    {
-		qCritical("agread() failed");
-	    }
+    connect(layoutThread, SIGNAL(finished()),
+	    this, SLOT(layoutThreadFinished()));
 
-	    gvFreeContext(gvc);
-	}
-	else
-	{
-	    qCritical("gvContext() failed");
-	}
+    showBusyMessage(tr("Layouting graph..."));
+    setCursor(Qt::BusyCursor);
 
-	fclose(fp);
-    }
-    else
+    layoutThread->start();
+}
+
+
+void
+QY2Graph::layoutThreadFinished()
+{
+    QY2GraphLayoutThread* thread = layoutThread;
+
+    if (thread == NULL || sender() != thread)
+	return;
+
+    layoutThread = 0;
+    unsetCursor();
+    clearGraph();
+
+    if (thread->graph() != NULL)
     {
-	qCritical("failed to open %s", filename.c_str());
+	QElapsedTimer timer;
+	timer.start();
+
+	renderGraph(thread->graph());
+
+	qDebug("graph layout: %lld ms, rendering: %lld ms",
+	       (long long) thread->elapsed(), (long long) timer.elapsed());
+
+	emit graphRendered();
     }
+
+    // This frees the graph
+    thread->deleteLater();
+}
+
+
+void
+QY2Graph::abandonLayoutThread()
+{
+    if (layoutThread == NULL)
+	return;
+
+    disconnect(layoutThread, 0, this, 0);
+    layoutThread->setParent(0);
+
+    // Graphviz can't be interrupted, so let the thread finish in the background.
+    // deleteLater() may safely be called twice if it finished in the meantime.
+    connect(layoutThread, SIGNAL(finished()),
+	    layoutThread, SLOT(deleteLater()));
+
+    if (layoutThread->isFinished())
+	layoutThread->deleteLater();
+
+    layoutThread = 0;
+    unsetCursor();
+}
+
+
+void
+QY2Graph::showBusyMessage(const QString& text)
+{
+    QGraphicsSimpleTextItem* item = scene->addSimpleText(text);
+    scene->setSceneRect(item->boundingRect().adjusted(-5, -5, +5, +5));
 }
 
 
@@ -328,11 +378,18 @@ QY2Graph::drawLabel(const textlabel_t* textlabel, QPainter* painter) const
     QFont font(textlabel->fontname, textlabel->fontsize);
     font.setPixelSize(textlabel->fontsize);
 
-    if (!font.exactMatch())
+    // Font matching is expensive, so check (and warn) only once per font
+    // and not for each of possibly thousands of nodes.
+    if (!checkedFonts.contains(font.key()))
     {
-	QFontInfo fontinfo(font);
-	qWarning("replacing font \"%s\" by font \"%s\"", font.family().toUtf8().data(),
-		 fontinfo.family().toUtf8().data());
+	checkedFonts.insert(font.key());
+
+	if (!font.exactMatch())
+	{
+	    QFontInfo fontinfo(font);
+	    qWarning("replacing font \"%s\" by font \"%s\"", font.family().toUtf8().data(),
+		     fontinfo.family().toUtf8().data());
+	}
     }
 
     painter->setFont(font);
@@ -357,8 +414,18 @@ QY2Graph::clearGraph()
 void
 QY2Graph::renderGraph(graph_t* graph)
 {
+    // A pending layout thread would draw its graph over this one when done
+    abandonLayoutThread();
+
+    // The node and edge attributes are read with graphviz calls, too
+    QMutexLocker locker(&graphvizMutex);
+
     clearGraph();
 
+    // Maintaining the BSP tree while adding thousands of items is much more
+    // expensive than building it once afterwards.
+    scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
     if (GD_charset(graph) != 0)
     {
 	qWarning("unsupported charset");
@@ -373,9 +440,9 @@ QY2Graph::renderGraph(graph_t* graph)
     for (node_t* node = agfstnode(graph); node != NULL; node = agnxtnode(graph, node))
     {
 	QPicture picture;
-	QPainter painter(&picture);
+	QPainter painter;
 
-	painter.begin(this);
+	painter.begin(&picture);
 	drawLabel(ND_label(node), &painter);
 	painter.end();
 
@@ -437,6 +504,10 @@ QY2Graph::renderGraph(graph_t* graph)
 	    }
 	}
     }
+
+    // The items never move, so a BSP tree with the default (automatically
+    // chosen) depth is ideal.
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
 }
 
 
@@ -497,6 +568,17 @@ QY2Node::QY2Node(const QPainterPath& path, const QPicture& picture, const QStrin
 void
 QY2Node::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+    if (option->levelOfDetailFromTransform(painter->worldTransform()) < LOD_THRESHOLD)
+    {
+	// Zoomed out far: The label would be unreadable anyway
+	painter->save();
+	painter->setPen(pen());
+	painter->setBrush(brush());
+	painter->drawRect(path().boundingRect());
+	painter->restore();
+	return;
+    }
+
     painter->save();
     QGraphicsPathItem::paint(painter, option, widget);
     painter->restore();
@@ -522,6 +604,18 @@ QY2Edge::boundingRect() const
 void
 QY2Edge::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+    if (option->levelOfDetailFromTransform(painter->worldTransform()) < LOD_THRESHOLD)
+    {
+	// Zoomed out far: A straight line without arrows is good enough
+	const QPainterPath& p = path();
+
+	painter->save();
+	painter->setPen(pen());
+	painter->drawLine(QPointF(p.elementAt(0)), p.currentPosition());
+	painter->restore();
+	return;
+    }
+
     painter->save();
     QGraphicsPathItem::paint(painter, option, widget);
     painter->restore();
@@ -529,3 +623,86 @@ QY2Edge::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidge
     picture.play(painter);
 }
 
+
+
+QY2GraphLayoutThread::QY2GraphLayoutThread(const std::string& filename,
+					   const std::string& layoutAlgorithm, QObject* parent)
+    : QThread(parent),
+      filename(filename),
+      layoutAlgorithm(layoutAlgorithm),
+      gvc(NULL),
+      graph_(NULL),
+      layouted(false),
+      elapsedMillisec(0)
+{
+}
+
+
+QY2GraphLayoutThread::~QY2GraphLayoutThread()
+{
+    wait();
+
+    QMutexLocker locker(&graphvizMutex);
+
+    if (graph_ != NULL)
+    {
+	if (layouted)
+	    gvFreeLayout(gvc, graph_);
+
+	agclose(graph_);
+    }
+
+    if (gvc != NULL)
+	gvFreeContext(gvc);
+}
+
+
+void
+QY2GraphLayoutThread::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QMutexLocker locker(&graphvizMutex);
+
+    FILE* fp = fopen(filename.c_str(), "r");
+    if (fp)
+    {
+	gvc = gvContext();
+	if (gvc != NULL)
+	{
+#ifdef WITH_CGRAPH
+	    graph_ = agread(fp, NULL);
+#else
+	    graph_ = agread(fp);
+#endif
+	    if (graph_ != NULL)
+	    {
+		if (gvLayout(gvc, graph_, const_cast<char*>(layoutAlgorithm.c_str())) == 0)
+		{
+		    layouted = true;
+		}
+		else
+		{
+		    qCritical("gvLayout() failed");
+		}
+	    }
+	    else
+	    {
+		qCritical("agread() failed");
+	    }
+	}
+	else
+	{
+	    qCritical("gvContext() failed");
+	}
+
+	fclose(fp);
+    }
+    else
+    {
+	qCritical("failed to open %s", filename.c_str());
+    }
+
+    elapsedMillisec = timer.elapsed();
+}
@@ -31,11 +31,23 @@
 #include <QPicture>
 #include <QContextMenuEvent>
 #include <QMouseEvent>
+#include <QThread>
+#include <QSet>
+
+
+class QY2GraphLayoutThread;
 
 
 /**
  * The QY2Graph widget shows a graph layouted by graphviz in a
  * QGraphicsView/QGraphicsScene.
+ *
+ * When rendering a graph from a file, reading and layouting is done in a
+ * worker thread so the UI does not freeze for huge graphs; a busy message
+ * is shown in the meantime.
+ *
+ * Nodes and edges use a simplified level-of-detail rendering (no labels,
+ * no arrows, simple shapes) when zoomed out far.
  */
 class QY2Graph : public QGraphicsView
 {
@@ -54,12 +66,26 @@ public:
 
     void clearGraph();
 
+    /**
+     * Return true while a graph is being layouted in the worker thread.
+     */
+    bool isLayouting() const { return layoutThread != 0; }
+
 signals:
 
     void backgroundContextMenuEvent(QContextMenuEvent* event);
     void nodeContextMenuEvent(QContextMenuEvent* event, const QString& name);
     void nodeDoubleClickEvent(QMouseEvent* event, const QString& name);
 
+    /**
+     * Emitted when a graph from a file was layouted and rendered.
+     */
+    void graphRendered();
+
+protected slots:
+
+    void layoutThreadFinished();
+
 protected:
 
     void keyPressEvent(QKeyEvent* event);
@@ -73,8 +99,20 @@ private:
 
     void scaleView(qreal scaleFactor);
 
+    /**
+     * Detach a still running layout thread from this widget. It will delete
+     * itself (and its graph) when finished.
+     */
+    void abandonLayoutThread();
+
+    void showBusyMessage(const QString& text);
+
     QGraphicsScene* scene;
 
+    QY2GraphLayoutThread* layoutThread;
+
+    mutable QSet<QString> checkedFonts;
+
     QRectF graphRect;
 
     QPointF gToQ(const pointf& p, bool upside_down = true) const;
@@ -104,6 +142,51 @@ private:
 };
 
 
+/**
+ * Worker thread reading a graph from a file and layouting it with graphviz.
+ *
+ * Graphviz is not thread-safe, so all graphviz calls in here are serialized
+ * with a global mutex. The graph and its layout are freed in the destructor.
+ */
+class QY2GraphLayoutThread : public QThread
+{
+    Q_OBJECT
+
+public:
+
+    QY2GraphLayoutThread(const std::string& filename, const std::string& layoutAlgorithm,
+			 QObject* parent = 0);
+
+    virtual ~QY2GraphLayoutThread();
+
+    /**
+     * The layouted graph or 0 if reading or layouting failed.
+     * Only valid after the thread finished.
+     */
+    graph_t* graph() const { return layouted ? graph_ : 0; }
+
+    /**
+     * Time spent reading and layouting in milliseconds.
+     */
+    qint64 elapsed() const { return elapsedMillisec; }
+
+protected:
+
+    virtual void run();
+
+private:
+
+    std::string filename;
+    std::string layoutAlgorithm;
+
+    GVC_t* gvc;
+    graph_t* graph_;
+    bool layouted;
+    qint64 elapsedMillisec;
+
+};
+
+
 class QY2Node : public QObject, public QGraphicsPathItem
 {
     Q_OBJECT
@@ -42,17 +42,13 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define YQPkgChangeLogView_h
 
 #include <zypp/Changelog.h>
-#include "YQPkgGenericDetailsView.h"
-
-
-using std::list;
-using std::string;
+#include "YQPkgTextListView.h"
 
 
 /**
- * @short Display a pkg's file list
+ * @short Display a pkg's change log
  **/
-class YQPkgChangeLogView : public YQPkgGenericDetailsView
+class YQPkgChangeLogView : public YQPkgTextListView
 {
     Q_OBJECT
 
@@ -68,27 +64,15 @@ public:
      **/
     virtual ~YQPkgChangeLogView();
 
-    /**
-     * Show details for the specified package:
-     * In this case the package description.
-     * Overwritten from YQPkgGenericDetailsView.
-     **/
-    virtual void showDetails( ZyppSel selectable );
-
 protected:
 
     /**
-     * Format a change log list in HTML
+     * Add the change log of 'pkg' to 'lines': For each entry a line with the
+     * date and the author, then the indented text.
+     *
+     * Implemented from YQPkgTextListView.
      **/
-    QString changeLogTable( const zypp::Changelog & changeLog ) const;
-
-    /**
-     * Format an info message about not displayed changes.
-     * @param  missing Number of missing entris
-     * @param  pkg     Package name (with version)
-     * @return         Translated message
-     */
-    QString notDisplayedChanges(int missing, const std::string &pkg);
+    virtual void addContentLines( ZyppPkg pkg, Lines & lines ) const;
 };
 
 
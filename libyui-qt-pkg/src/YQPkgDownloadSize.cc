@@ -0,0 +1,148 @@
+/**************************************************************************
+Copyright (C) 2020 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*/
+
+
+#define YUILogComponent "qt-pkg"
+#include <yui/YUILog.h>
+
+#include <set>
+#include <yui/YLatencyHistogram.h>
+#include <zypp/Patch.h>
+
+#include "YQPkgDownloadSize.h"
+
+
+using std::endl;
+using std::set;
+
+typedef zypp::Patch::Contents			ZyppPatchContents;
+typedef zypp::Patch::Contents::const_iterator	ZyppPatchContentsIterator;
+
+
+YQPkgDownloadSize::YQPkgDownloadSize()
+    : _collected( false )
+    , _total( 0 )
+{
+}
+
+
+YQPkgDownloadSize::~YQPkgDownloadSize()
+{
+    // NOP
+}
+
+
+void
+YQPkgDownloadSize::collect()
+{
+    YStopWatch stopWatch;
+    set<ZyppSel> patchSelectables;
+
+    for ( ZyppPoolIterator patches_it = zyppPatchesBegin();
+	  patches_it != zyppPatchesEnd();
+	  ++patches_it )
+    {
+	ZyppPatch patch = tryCastToZyppPatch( (*patches_it)->theObj() );
+
+	if ( patch )
+	{
+	    ZyppPatchContents patchContents( patch->contents() );
+
+	    for ( ZyppPatchContentsIterator contents_it = patchContents.begin();
+		  contents_it != patchContents.end();
+		  ++contents_it )
+	    {
+		ZyppPkg pkg =  zypp::make<zypp::Package>(*contents_it);
+		ZyppSel sel;
+
+		if ( pkg )
+		    sel = _selMapper.findZyppSel( pkg );
+
+		// The same package could be in more than one patch, but of
+		// course it will be downloaded only once.
+
+		if ( sel && patchSelectables.insert( sel ).second )
+		{
+		    Entry entry;
+		    entry.sel  = sel;
+		    entry.size = 0;
+		    _entries.push_back( entry );
+		}
+	    }
+	}
+    }
+
+    _collected = true;
+
+    yuiDebug() << "Collected " << _entries.size() << " patch packages in "
+	       << stopWatch.elapsed() / 1000 << " millisec"
+	       << endl;
+}
+
+
+bool
+YQPkgDownloadSize::toInstall( ZyppSel sel )
+{
+    switch ( sel->status() )
+    {
+	case S_Install:
+	case S_AutoInstall:
+	case S_Update:
+	case S_AutoUpdate:
+	    return true;
+
+	case S_Del:
+	case S_AutoDel:
+	case S_NoInst:
+	case S_KeepInstalled:
+	case S_Taboo:
+	case S_Protected:
+	    return false;
+
+	    // intentionally omitting 'default' branch so the compiler can
+	    // catch unhandled enum states
+    }
+
+    return false;
+}
+
+
+FSize
+YQPkgDownloadSize::totalSize()
+{
+    if ( ! _collected )
+	collect();
+
+    for ( Entry & entry: _entries )
+    {
+	zypp::ByteCount::SizeType size = 0;
+
+	if ( toInstall( entry.sel ) && entry.sel->candidateObj() )
+	    size = entry.sel->candidateObj()->installSize();
+
+	if ( size != entry.size )
+	{
+	    _total    += size - entry.size;
+	    entry.size = size;
+	}
+    }
+
+    return FSize( boost::multiprecision::cpp_int( _total ) );
+}
@@ -0,0 +1,98 @@
+/**************************************************************************
+Copyright (C) 2020 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*/
+
+#ifndef YQPkgDownloadSize_h
+#define YQPkgDownloadSize_h
+
+#include <vector>
+#include <yui/FSize.h>
+
+#include "YQZypp.h"
+#include "YQPkgSelMapper.h"
+
+
+/**
+ * @short Running total of the download size of all patch packages that
+ * are going to be installed or updated.
+ *
+ * The packages of all patches are collected only once (on the first call),
+ * each selectable only once even if it belongs to more than one patch: It
+ * will be downloaded only once. After that, an update only compares the
+ * status of each of these selectables with the status it had at the last
+ * update and adjusts the total for those that changed. This avoids walking
+ * the contents of every patch and looking up their selectables again after
+ * each status change.
+ *
+ * The collected selectables stay valid as long as the package selector is
+ * open: The ZyppPool only changes (e.g. with the repository manager) after
+ * the package selector was closed, and restoring the saved states when it
+ * is cancelled only changes the statuses.
+ *
+ * libzypp does not notify about status changes (the solver changes
+ * statuses without any callback), so totalSize() has to check them all;
+ * but that is one status() call per selectable, not a rebuild.
+ **/
+class YQPkgDownloadSize
+{
+public:
+
+    /**
+     * Constructor. Nothing is collected yet.
+     **/
+    YQPkgDownloadSize();
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YQPkgDownloadSize();
+
+    /**
+     * Return the total size of the patch packages that are going to be
+     * installed or updated, taking any status changes since the last call
+     * into account.
+     **/
+    FSize totalSize();
+
+protected:
+
+    /**
+     * Collect the selectables of all patch packages.
+     **/
+    void collect();
+
+    /**
+     * Return 'true' if 'sel' is going to be installed or updated.
+     **/
+    static bool toInstall( ZyppSel sel );
+
+    struct Entry
+    {
+	ZyppSel				sel;
+	zypp::ByteCount::SizeType	size;	// the size that is counted, 0 if not
+    };
+
+    std::vector<Entry>		_entries;
+    bool			_collected;
+    zypp::ByteCount::SizeType	_total;
+    YQPkgSelMapper		_selMapper;
+};
+
+
+#endif // ifndef YQPkgDownloadSize_h
@@ -45,17 +45,13 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include <yui/qt/YQi18n.h>
 #include <yui/qt/utf8.h>
 
-#include <QRegExp>
-
 #include "YQPkgFileListView.h"
-#include "YQPkgDescriptionDialog.h"
-
 
-#define MAX_LINES 500
+using std::string;
 
 
 YQPkgFileListView::YQPkgFileListView( QWidget * parent )
-    : YQPkgGenericDetailsView( parent )
+    : YQPkgTextListView( parent )
 {
 }
 
@@ -67,72 +63,27 @@ YQPkgFileListView::~YQPkgFileListView()
 
 
 void
-YQPkgFileListView::showDetails( ZyppSel selectable )
+YQPkgFileListView::addContentLines( ZyppPkg pkg, Lines & lines ) const
 {
-    _selectable = selectable;
-
-    if ( ! selectable )
-    {
-	clear();
-	return;
-    }
-
-    QString html = htmlHeading( selectable,
-				false ); // showVersion
-
-    ZyppPkg installed = tryCastToZyppPkg( selectable->installedObj() );
-
-    if ( installed )
-    {
-        // ma@: It might be worth passing Package::FileList directly
-        // instead of copying _all_ filenames into a list first.
-        // Package::FileList is a query, so it does not eat much memory.
-        zypp::Package::FileList f( installed->filelist() );
-        std::list<std::string> tmp( f.begin(), f.end() );
-	html += formatFileList( tmp );
-    }
-    else
-    {
-	html += "<p><i>" + _( "Information only available for installed packages." ) + "</i></p>";
-    }
-
-    setHtml( html );
-}
-
+    // Package::FileList is a query, so this is the only copy of the file
+    // names that is kept.
 
+    zypp::Package::FileList fileList( pkg->filelist() );
+    unsigned long count = 0;
 
-QString YQPkgFileListView::formatFileList( const list<string> & fileList ) const
-{
-    QString html;
-    unsigned line_count = 0;
-
-    for ( list<string>::const_iterator it = fileList.begin();
-	  it != fileList.end() && line_count < MAX_LINES;
-	  ++it, ++line_count )
+    for ( zypp::Package::FileList::iterator it = fileList.begin();
+	  it != fileList.end();
+	  ++it, ++count )
     {
-	QString line = htmlEscape( fromUTF8( *it ) );
-
-	if ( line.contains( "/bin/"  ) ||
-	     line.contains( "/sbin/" )	 )
-	{
-	    line = "<b>" + line + "</b>";
-	}
+	string file = *it;
+	bool isBinary = file.find( "/bin/"  ) != string::npos ||
+			file.find( "/sbin/" ) != string::npos;
 
-	html += line + "<br>";
+	lines.push_back( Line( file, isBinary ) );
     }
 
-    if ( fileList.size() > MAX_LINES )
-    {
-	html += "...<br>";
-	html += "...<br>";
-    }
-    else
-    {
-        // %1 is the total number of files in a file list
-        html += "<br>" + _( "%1 files total" ).arg( (unsigned long) fileList.size() );
-    }
+    lines.push_back( Line() );
 
-    return "<p>" + html + "</p>";
+    // %1 is the total number of files in a file list
+    lines.push_back( Line( toUTF8( _( "%1 files total" ).arg( count ) ) ) );
 }
-
-
@@ -41,17 +41,13 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef YQPkgFileListView_h
 #define YQPkgFileListView_h
 
-#include "YQPkgGenericDetailsView.h"
-
-
-using std::list;
-using std::string;
+#include "YQPkgTextListView.h"
 
 
 /**
  * @short Display a pkg's file list
  **/
-class YQPkgFileListView : public YQPkgGenericDetailsView
+class YQPkgFileListView : public YQPkgTextListView
 {
     Q_OBJECT
 
@@ -67,19 +63,14 @@ public:
      **/
     virtual ~YQPkgFileListView();
 
-    /**
-     * Show details for the specified package:
-     * In this case the package description.
-     * Overwritten from YQPkgGenericDetailsView.
-     **/
-    virtual void showDetails( ZyppSel selectable );
-
 protected:
 
     /**
-     * Format a file list in HTML
+     * Add the file list of 'pkg' to 'lines'.
+     *
+     * Implemented from YQPkgTextListView.
      **/
-    QString formatFileList( const list<string> & fileList ) const;
+    virtual void addContentLines( ZyppPkg pkg, Lines & lines ) const;
 };
 
 
@@ -61,10 +61,6 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "QY2LayoutUtils.h"
 
 
-typedef zypp::Patch::Contents			ZyppPatchContents;
-typedef zypp::Patch::Contents::const_iterator	ZyppPatchContentsIterator;
-
-using std::set;
 using std::endl;
 
 #define ENABLE_TOTAL_DOWNLOAD_SIZE	0
@@ -133,73 +129,10 @@ YQPkgPatchFilterView::~YQPkgPatchFilterView()
 void
 YQPkgPatchFilterView::updateTotalDownloadSize()
 {
-    set<ZyppSel> selectablesToInstall;
     QElapsedTimer calcTime;
     calcTime.start();
 
-    for ( ZyppPoolIterator patches_it = zyppPatchesBegin();
-	  patches_it != zyppPatchesEnd();
-	  ++patches_it )
-    {
-	ZyppPatch patch = tryCastToZyppPatch( (*patches_it)->theObj() );
-
-	if ( patch )
-	{
-	    ZyppPatchContents patchContents( patch->contents() );
-
-	    for ( ZyppPatchContentsIterator contents_it = patchContents.begin();
-		  contents_it != patchContents.end();
-		  ++contents_it )
-	    {
-		ZyppPkg pkg =  zypp::make<zypp::Package>(*contents_it);
-		ZyppSel sel;
-
-		if ( pkg )
-		    sel = _selMapper.findZyppSel( pkg );
-
-		if ( sel )
-		{
-		    switch ( sel->status() )
-		    {
-			case S_Install:
-			case S_AutoInstall:
-			case S_Update:
-			case S_AutoUpdate:
-			    // Insert the patch contents selectables into a set,
-			    // don't immediately sum up their sizes: The same
-			    // package could be in more than one patch, but of
-			    // course it will be downloaded only once.
-
-			    selectablesToInstall.insert( sel );
-			    break;
-
-			case S_Del:
-			case S_AutoDel:
-			case S_NoInst:
-			case S_KeepInstalled:
-			case S_Taboo:
-			case S_Protected:
-			    break;
-
-			    // intentionally omitting 'default' branch so the compiler can
-			    // catch unhandled enum states
-		    }
-
-		}
-	    }
-	}
-    }
-
-
-    FSize totalSize = 0;
-
-    for ( set<ZyppSel>::iterator it = selectablesToInstall.begin();
-	  it != selectablesToInstall.end();
-	  ++it )
-    {
-	if ( (*it)->candidateObj() )
-	    totalSize += zypp::ByteCount::SizeType((*it)->candidateObj()->installSize());
-    }
+    FSize totalSize = _downloadSize.totalSize();
 
 #if ENABLE_TOTAL_DOWNLOAD_SIZE
     _totalDownloadSize->setText( totalSize.asString().c_str() );
@@ -43,6 +43,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "YQZypp.h"
 #include "YQPkgSelMapper.h"
+#include "YQPkgDownloadSize.h"
 #include <QLabel>
 
 
@@ -111,6 +112,7 @@ protected:
     QLabel *			_totalDownloadSize;
 
     YQPkgSelMapper		_selMapper;
+    YQPkgDownloadSize		_downloadSize;
 };
 
 
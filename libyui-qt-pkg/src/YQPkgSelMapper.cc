@@ -41,19 +41,25 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define YUILogComponent "qt-pkg"
 #include <yui/YUILog.h>
 
+#include <yui/YLatencyHistogram.h>
+#include <zypp/sat/Pool.h>
+
 #include "YQPkgSelMapper.h"
 
 
 using std::endl;
 
-int			YQPkgSelMapper::_refCount = 0;
-YQPkgSelMapper::Cache	YQPkgSelMapper::_cache;
+int				YQPkgSelMapper::_refCount   = 0;
+bool				YQPkgSelMapper::_cacheValid = false;
+YQPkgSelMapper::Cache		YQPkgSelMapper::_cache;
+unsigned long			YQPkgSelMapper::_lookups    = 0;
+unsigned long			YQPkgSelMapper::_misses     = 0;
+long long			YQPkgSelMapper::_lookupTime = 0;
 
 
 YQPkgSelMapper::YQPkgSelMapper()
 {
-    if ( ++_refCount == 1 )
-	rebuildCache();
+    ++_refCount;
 }
 
 
@@ -61,16 +67,40 @@ YQPkgSelMapper::~YQPkgSelMapper()
 {
     if ( --_refCount == 0 )
     {
-	yuiDebug() << "Destroying pkg -> selectable cache"  << endl;
-	_cache.clear();
+	if ( _cacheValid )
+	{
+	    yuiMilestone() << _lookups << " pkg -> selectable lookups ("
+			   << _misses << " misses) in " << _lookupTime << " us"
+			   << endl;
+	}
+
+	yuiDebug() << "Destroying pkg -> selectable cache" << endl;
+	Cache().swap( _cache );
+	_cacheValid = false;
+	_lookups    = 0;
+	_misses     = 0;
+	_lookupTime = 0;
     }
 }
 
 
+void YQPkgSelMapper::ensureCache()
+{
+    if ( ! _cacheValid )
+	rebuildCache();
+}
+
+
 void YQPkgSelMapper::rebuildCache()
 {
-    _cache.clear();
     yuiDebug() << "Building pkg -> selectable cache" << endl;
+    YStopWatch stopWatch;
+
+    // Solvable IDs are indices into the satsolver pool, so they are dense
+    // and all of them are below its capacity.
+
+    _cache.assign( zypp::sat::Pool::instance().capacity(), ZyppSel() );
+    unsigned long count = 0;
 
     for ( ZyppPoolIterator sel_it = zyppPkgBegin();
 	  sel_it != zyppPkgEnd();
@@ -86,7 +116,7 @@ void YQPkgSelMapper::rebuildCache()
 	    ZyppPkg installedPkg = tryCastToZyppPkg( sel->installedObj() );
 
 	    if ( installedPkg )
-		_cache.insert( CachePair( installedPkg, sel ) );
+		count += insert( installedPkg, sel );
 	}
 
 	zypp::ui::Selectable::available_iterator it = sel->availableBegin();
@@ -96,29 +126,56 @@ void YQPkgSelMapper::rebuildCache()
 	    ZyppPkg pkg = tryCastToZyppPkg( *it );
 
 	    if ( pkg )
-		_cache.insert( CachePair( pkg, sel ) );
+		count += insert( pkg, sel );
 
 	    ++it;
 	}
     }
 
-    yuiDebug() << "Building pkg -> selectable cache done" << endl;
+    _cacheValid = true;
+
+    yuiMilestone() << "Built pkg -> selectable cache for " << count << " packages "
+		   << "(pool capacity " << _cache.size() << ") in "
+		   << stopWatch.elapsed() / 1000 << " ms" << endl;
+}
+
+
+bool YQPkgSelMapper::insert( ZyppPkg pkg, ZyppSel sel )
+{
+    size_t id = pkg->satSolvable().id();
+
+    if ( id >= _cache.size() )
+	_cache.resize( id + 1 );
+
+    if ( _cache[ id ] )
+	return false;
+
+    _cache[ id ] = sel;
+
+    return true;
 }
 
 
 ZyppSel
 YQPkgSelMapper::findZyppSel( ZyppPkg pkg )
 {
-    YQPkgSelMapper mapper; // This will build a cache, if there is none yet
+    YStopWatch stopWatch;
+    ensureCache();
+
     ZyppSel sel;
+    size_t id = pkg->satSolvable().id();
 
-    YQPkgSelMapper::CacheIterator it = YQPkgSelMapper::_cache.find( pkg );
+    if ( id < _cache.size() )
+	sel = _cache[ id ];
 
-    if ( it != YQPkgSelMapper::_cache.end() )
-	sel = it->second;
-    else
+    if ( ! sel )
+    {
+	++_misses;
 	yuiWarning() << "No selectable found for package " << pkg->name() << endl;
+    }
+
+    ++_lookups;
+    _lookupTime += stopWatch.elapsed();
 
     return sel;
 }
-
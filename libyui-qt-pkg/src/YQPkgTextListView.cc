@@ -0,0 +1,291 @@
+/**************************************************************************
+Copyright (C) 2020 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*/
+
+
+#define YUILogComponent "qt-pkg"
+#include <yui/YUILog.h>
+#include <yui/YUIException.h>
+
+#include <yui/qt/YQi18n.h>
+#include <yui/qt/utf8.h>
+
+#include <algorithm>
+#include <QAbstractListModel>
+#include <QApplication>
+#include <QClipboard>
+#include <QFont>
+#include <QKeyEvent>
+#include <QTabWidget>
+
+#include "YQPkgTextListView.h"
+
+// Upper limit for the number of lines of all packages in the cache
+#define MAX_CACHED_LINES	200000
+
+
+using std::endl;
+using std::string;
+
+
+/**
+ * Model for YQPkgTextListView: Returns the lines as QStrings only when the
+ * view asks for them, i.e. only for the visible ones.
+ **/
+class YQPkgTextListModel : public QAbstractListModel
+{
+public:
+
+    YQPkgTextListModel( QObject * parent )
+	: QAbstractListModel( parent )
+	{}
+
+    void setLines( YQPkgTextListView::LinesPtr lines )
+    {
+	beginResetModel();
+	_lines = lines;
+	endResetModel();
+    }
+
+    YQPkgTextListView::LinesPtr lines() const { return _lines; }
+
+    virtual int rowCount( const QModelIndex & parent ) const
+    {
+	return parent.isValid() || ! _lines ? 0 : _lines->size();
+    }
+
+    virtual QVariant data( const QModelIndex & index, int role ) const
+    {
+	if ( ! _lines || index.row() < 0 || index.row() >= (int) _lines->size() )
+	    return QVariant();
+
+	const YQPkgTextListView::Line & line = (*_lines)[ index.row() ];
+
+	switch ( role )
+	{
+	    case Qt::DisplayRole:
+		return fromUTF8( line.text );
+
+	    case Qt::FontRole:
+		if ( line.emphasized )
+		{
+		    QFont font;
+		    font.setBold( true );
+
+		    return font;
+		}
+		break;
+	}
+
+	return QVariant();
+    }
+
+private:
+
+    YQPkgTextListView::LinesPtr _lines;
+};
+
+
+
+YQPkgTextListView::YQPkgTextListView( QWidget * parent )
+    : QListView( parent )
+    , _cachedLines( 0 )
+{
+    _selectable = 0;
+    _parentTab  = dynamic_cast<QTabWidget *> (parent);
+
+    if ( _parentTab )
+    {
+        connect( _parentTab, &QTabWidget::currentChanged,
+                 this,       &YQPkgTextListView::reloadTab );
+    }
+
+    _model = new YQPkgTextListModel( this );
+    YUI_CHECK_NEW( _model );
+    setModel( _model );
+
+    // All lines have the same height, so the view doesn't need to ask the
+    // model about each line to lay them out.
+    setUniformItemSizes( true );
+    setSelectionMode( QAbstractItemView::ExtendedSelection );
+    setEditTriggers( QAbstractItemView::NoEditTriggers );
+}
+
+
+YQPkgTextListView::~YQPkgTextListView()
+{
+    // NOP
+}
+
+
+QSize
+YQPkgTextListView::minimumSizeHint() const
+{
+    return QSize( 0, 0 );
+}
+
+
+void
+YQPkgTextListView::reloadTab( int newCurrent )
+{
+    if ( _parentTab && _parentTab->widget(newCurrent) == this )
+    {
+	showDetailsIfVisible( _selectable );
+    }
+}
+
+
+void
+YQPkgTextListView::showDetailsIfVisible( ZyppSel selectable )
+{
+    _selectable = selectable;
+
+    if ( _parentTab )		// Is this view embedded into a tab widget?
+    {
+	if ( _parentTab->currentWidget() == this )  // Is this page the topmost?
+	{
+	    showDetails( selectable );
+	}
+    }
+    else	// No tab parent - simply show data unconditionally.
+    {
+	showDetails( selectable );
+    }
+}
+
+
+void
+YQPkgTextListView::showDetails( ZyppSel selectable )
+{
+    _selectable = selectable;
+
+    if ( ! selectable )
+    {
+	clear();
+	return;
+    }
+
+    ZyppPkg installed = tryCastToZyppPkg( selectable->installedObj() );
+
+    if ( installed )
+    {
+	LinesPtr lines = linesFor( installed );
+
+	if ( lines != _model->lines() )
+	    _model->setLines( lines );
+    }
+    else
+    {
+	Lines * lines = new Lines();
+	ZyppObj zyppObj = selectable->theObj();
+
+	if ( zyppObj )
+	    lines->push_back( Line( zyppObj->name() + " - " + zyppObj->summary(), true ) );
+
+	lines->push_back( Line() );
+	lines->push_back( Line( toUTF8( _( "Information only available for installed packages." ) ) ) );
+
+	_model->setLines( LinesPtr( lines ) );
+    }
+}
+
+
+void
+YQPkgTextListView::clear()
+{
+    _model->setLines( LinesPtr() );
+}
+
+
+YQPkgTextListView::LinesPtr
+YQPkgTextListView::linesFor( ZyppPkg pkg )
+{
+    std::map<ZyppPkg, LinesPtr>::const_iterator it = _cache.find( pkg );
+
+    if ( it != _cache.end() )
+	return it->second;
+
+    Lines * lines = new Lines();
+    lines->push_back( Line( pkg->name() + " - " + pkg->summary(), true ) );
+    lines->push_back( Line() );
+    addContentLines( pkg, *lines );
+
+    yuiDebug() << pkg->name() << ": " << lines->size() << " lines" << endl;
+
+    LinesPtr linesPtr( lines );
+    _cache[ pkg ] = linesPtr;
+    _cacheOrder.push_back( pkg );
+    _cachedLines += lines->size();
+
+    // Drop the oldest packages from the cache. The one just added stays in
+    // the model even if it alone exceeds the limit.
+
+    while ( _cachedLines > MAX_CACHED_LINES && ! _cacheOrder.empty() )
+    {
+	ZyppPkg oldest = _cacheOrder.front();
+	_cacheOrder.pop_front();
+
+	_cachedLines -= _cache[ oldest ]->size();
+	_cache.erase( oldest );
+    }
+
+    return linesPtr;
+}
+
+
+void
+YQPkgTextListView::addTextLines( const string & text,
+				 Lines &	lines,
+				 const string & indent )
+{
+    string::size_type start = 0;
+
+    while ( start <= text.size() )
+    {
+	string::size_type end = text.find( '\n', start );
+
+	if ( end == string::npos )
+	    end = text.size();
+
+	lines.push_back( Line( indent + text.substr( start, end - start ) ) );
+	start = end + 1;
+    }
+}
+
+
+void
+YQPkgTextListView::keyPressEvent( QKeyEvent * event )
+{
+    if ( event && event->matches( QKeySequence::Copy ) )
+    {
+	QStringList selectedLines;
+	QModelIndexList selected = selectionModel()->selectedIndexes();
+	std::sort( selected.begin(), selected.end() );
+
+	foreach ( const QModelIndex & index, selected )
+	    selectedLines << _model->data( index, Qt::DisplayRole ).toString();
+
+	QApplication::clipboard()->setText( selectedLines.join( "\n" ) );
+	event->accept();
+
+	return;
+    }
+
+    QListView::keyPressEvent( event );
+}
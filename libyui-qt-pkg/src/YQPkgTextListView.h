@@ -0,0 +1,172 @@
+/**************************************************************************
+Copyright (C) 2020 SUSE LLC
+All Rights Reserved.
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*/
+
+
+#ifndef YQPkgTextListView_h
+#define YQPkgTextListView_h
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <QListView>
+
+#include "YQZypp.h"
+
+
+class QKeyEvent;
+class QTabWidget;
+class YQPkgTextListModel;
+
+
+/**
+ * @short Abstract base class for details views that show long lists of
+ * plain text lines for an installed package, like the file list or the
+ * change log.
+ *
+ * Unlike YQPkgGenericDetailsView, this does not build one HTML document for
+ * the rich text browser: The lines are stored as they come from libzypp
+ * (UTF-8), and the list view only formats the lines that are currently
+ * visible while scrolling. So there is no need to truncate huge lists, and
+ * the memory usage is that of the raw text.
+ *
+ * The lines of the last packages are cached (up to MAX_CACHED_LINES in
+ * total) so switching back to a package is instant.
+ **/
+class YQPkgTextListView : public QListView
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * One line of text. 'emphasized' lines are displayed in bold.
+     **/
+    struct Line
+    {
+	Line( const std::string & text = std::string(), bool emphasized = false )
+	    : text( text )
+	    , emphasized( emphasized )
+	    {}
+
+	std::string	text;
+	bool		emphasized;
+    };
+
+    typedef std::vector<Line>			Lines;
+    typedef std::shared_ptr<const Lines>	LinesPtr;
+
+
+protected:
+
+    /**
+     * Constructor.
+     **/
+    YQPkgTextListView( QWidget * parent );
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YQPkgTextListView();
+
+
+public:
+
+    /**
+     * Returns the minimum size required for this widget.
+     * Inherited from QWidget.
+     **/
+    virtual QSize minimumSizeHint() const;
+
+
+public slots:
+
+    /**
+     * Show details for the specified package.
+     * Delayed ( optimized ) display if this is embedded into a QTabWidget
+     * parent: In this case, wait until this page becomes visible.
+     **/
+    void showDetailsIfVisible( ZyppSel selectable );
+
+    /**
+     * Show details for the specified package: The lines from
+     * addContentLines() for its installed version.
+     **/
+    virtual void showDetails( ZyppSel selectable );
+
+    /**
+     * Clear the view.
+     **/
+    void clear();
+
+
+protected slots:
+
+    /**
+     * Show data for the last package.
+     **/
+    void reloadTab( int newCurrent );
+
+
+protected:
+
+    /**
+     * Add the lines to display for the installed package 'pkg' to 'lines'.
+     * This is only called if they are not in the cache.
+     *
+     * Implement this in derived classes.
+     **/
+    virtual void addContentLines( ZyppPkg pkg, Lines & lines ) const = 0;
+
+    /**
+     * Add the lines of 'text' to 'lines', each one indented by 'indent'.
+     **/
+    static void addTextLines( const std::string & text,
+			      Lines &		  lines,
+			      const std::string & indent = std::string() );
+
+    /**
+     * Copy the selected lines to the clipboard on the "copy" key.
+     *
+     * Reimplemented from QAbstractItemView.
+     **/
+    virtual void keyPressEvent( QKeyEvent * event );
+
+    /**
+     * Return the lines for 'pkg' from the cache or create them and add them
+     * to the cache.
+     **/
+    LinesPtr linesFor( ZyppPkg pkg );
+
+
+    // Data members
+
+    QTabWidget	*		_parentTab;
+    ZyppSel			_selectable;
+    YQPkgTextListModel *	_model;
+
+    std::map<ZyppPkg, LinesPtr>	_cache;
+    std::deque<ZyppPkg>		_cacheOrder;
+    size_t			_cachedLines;
+};
+
+
+#endif // ifndef YQPkgTextListView_h
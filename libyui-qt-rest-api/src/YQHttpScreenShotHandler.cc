@@ -0,0 +1,55 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <QWidget>
+
+#include <yui/YDialog.h>
+#include <yui/qt/YQScreenShot.h>
+
+#include "YQHttpScreenShotHandler.h"
+
+
+void YQHttpScreenShotHandler::process_request(struct MHD_Connection* connection,
+    const char* url, const char* method, const char* upload_data,
+    size_t* upload_data_size, std::ostream& body, int& error_code,
+    std::string& content_type, bool *redraw)
+{
+    const char* format_name = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "format");
+    YQScreenShot::Format format = format_name ? YQScreenShot::format(format_name) : YQScreenShot::PNG;
+    YDialog * dialog = YDialog::topmostDialog(false);
+
+    content_type = "application/json";
+
+    if (format == YQScreenShot::UnknownFormat) {
+        error_code = handle_error(body, "Unknown screenshot format (use png, qoi or ppm)", MHD_HTTP_BAD_REQUEST);
+    }
+    else if (!dialog) {
+        error_code = handle_error(body, "No dialog is open", MHD_HTTP_NOT_FOUND);
+    }
+    else {
+        QWidget * window = ((QWidget *) dialog->widgetRep())->window();
+        QByteArray data = YQScreenShot::encode(YQScreenShot::grab(window), format);
+
+        if (data.isEmpty()) {
+            error_code = handle_error(body, "Encoding the screenshot failed", MHD_HTTP_INTERNAL_SERVER_ERROR);
+        }
+        else {
+            body.write(data.constData(), data.size());
+            error_code = MHD_HTTP_OK;
+            content_type = YQScreenShot::mimeType(format);
+        }
+    }
+}
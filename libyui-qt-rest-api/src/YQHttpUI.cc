@@ -14,15 +14,20 @@
 */
 
 
+#include <QAbstractEventDispatcher>
 #include <QThread>
 #include <QSocketNotifier>
+#include <QEvent>
+#include <QTimer>
 
 #define  YUILogComponent "qt-rest-api"
 #include <yui/YUILog.h>
 
+#include <yui/YDialog.h>
 #include <yui/rest-api/YHttpServer.h>
 
 #include "YQHttpUI.h"
+#include "YQHttpScreenShotHandler.h"
 #include "YQHttpWidgetsActionHandler.h"
 
 
@@ -53,6 +58,7 @@ void YQHttpUI::initUI()
     receiver->createHttpNotifiers();
 
     _signalReceiver = receiver;
+    qApp->installEventFilter( receiver );
     _busyCursorTimer = new QTimer( _signalReceiver );
     _busyCursorTimer->setSingleShot( true );
     QObject::connect( _busyCursorTimer, &pclass(_busyCursorTimer)::timeout,
@@ -90,6 +96,15 @@ extern YUI * createYQHttpUI( bool withThreads )
 YQHttpUISignalReceiver::YQHttpUISignalReceiver()
     : YQUISignalReceiver()
 {
+    _waitTimer = new QTimer( this );
+    _waitTimer->setSingleShot( true );
+    QObject::connect( _waitTimer, &pclass(_waitTimer)::timeout,
+                      this,       &pclass(this)::checkWaits );
+
+    // the application might have changed the UI before it waits for the
+    // next event, check the waits only then and not after each change
+    QObject::connect( QAbstractEventDispatcher::instance(), &QAbstractEventDispatcher::aboutToBlock,
+                      this, &pclass(this)::checkWaits );
 }
 
 void
@@ -103,6 +118,49 @@ YQHttpUISignalReceiver::httpData()
     createHttpNotifiers();
 }
 
+void YQHttpUISignalReceiver::checkWaits()
+{
+    YHttpServer * server = YHttpServer::yserver();
+
+    if ( !server )
+        return;
+
+    server->check_waits();
+
+    int timeout = server->wait_timeout();
+
+    if ( timeout >= 0 )
+        _waitTimer->start( timeout );
+    else
+        _waitTimer->stop();
+}
+
+bool YQHttpUISignalReceiver::eventFilter( QObject * obj, QEvent * event )
+{
+    switch ( event->type() )
+    {
+        case QEvent::KeyPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::Wheel:
+            // The input might change the widget that receives it without a
+            // libyui setter call: give that widget a new change version
+            for ( QObject * receiver = obj; receiver; receiver = receiver->parent() )
+            {
+                if ( YWidget * widget = dynamic_cast<YWidget *>( receiver ) )
+                {
+                    widget->markChanged();
+                    break;
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return YQUISignalReceiver::eventFilter( obj, event );
+}
+
 void YQHttpUISignalReceiver::clearHttpNotifiers() {
     yuiDebug() << "Clearing HTTP notifiers..." << std::endl;
 
@@ -120,6 +178,7 @@ void YQHttpUISignalReceiver::createHttpNotifiers()
     if (!YHttpServer::yserver()) {
         yuiMilestone() << "Creating the YHttpServer..." << std::endl;
         YHttpServer * yserver = new YHttpServer( new YQHttpWidgetsActionHandler() );
+        yserver->mount( "/screenshot", "GET", new YQHttpScreenShotHandler() );
         yserver->start();
     }
 
@@ -35,6 +35,7 @@
 #define pclass(ptr) std::remove_reference<decltype(*ptr)>::type
 
 class QSocketNotifier;
+class QTimer;
 class YQHttpUISignalReceiver;
 
 
@@ -77,12 +78,26 @@ public:
 public slots:
     void httpData();
 
+    /**
+     * Answer the suspended wait requests if the UI changed and schedule
+     * the next check for the nearest wait timeout. This is called whenever
+     * the Qt event loop is about to wait for new events.
+     **/
+    void checkWaits();
+
 public:
     void clearHttpNotifiers();
     void createHttpNotifiers();
 
+    /**
+     * Application wide event filter: Mark the topmost dialog as changed on
+     * user input, the widgets don't report each change the user makes.
+     **/
+    bool eventFilter( QObject * obj, QEvent * event ) override;
+
 private:
     std::vector<QSocketNotifier*>  _http_notifiers;
+    QTimer *                       _waitTimer;
 };
 
 /**
@@ -29,6 +29,7 @@
 #include <yui/YSettings.h>
 
 #include "QY2Styler.h"
+#include "YQStartupTrace.h"
 #include <QDebug>
 #include <QFile>
 #include <QString>
@@ -72,6 +73,7 @@ QY2Styler::styler()
     if ( ! styler )
     {
         // yuiDebug() << "Creating QY2Styler singleton" << endl;
+        YQStartupTrace::Phase phase( "style sheet" );
 
         QString y2style = getenv("Y2STYLE");
         QString y2altstyle = getenv("Y2ALTSTYLE");
@@ -48,6 +48,7 @@
 #include "YQi18n.h"
 
 #include "YQApplication.h"
+#include "YQStartupTrace.h"
 #include "YQPackageSelectorPluginStub.h"
 #include "YQGraphPluginStub.h"
 #include "YQContextMenu.h"
@@ -74,6 +75,13 @@ using std::endl;
 // Note that this is also set in LANG_FONTS_FILE
 static const char * default_font_family = "Sans Serif";
 
+// Loading the Qt translations is deferred until the first dialog is on the
+// screen, see loadDeferredQtTranslations(). There is only one YQApplication
+// instance; keeping this here instead of in the class keeps its layout
+// compatible.
+static bool deferQtTranslations	  = true;
+static bool qtTranslationsPending = false;
+
 
 
 YQApplication::YQApplication()
@@ -113,6 +121,20 @@ YQApplication::~YQApplication()
 
 static string glob_language = "";
 
+
+/**
+ * Recalculate the layout of the topmost dialog, e.g. after the layout
+ * direction changed.
+ **/
+static void recalcTopmostDialogLayout()
+{
+    YDialog * dialog = YDialog::topmostDialog( false ); // don't throw
+
+    if ( dialog )
+	dialog->recalcLayout();
+}
+
+
 void
 YQApplication::setLanguage( const string & language,
 			    const string & encoding )
@@ -126,18 +148,22 @@ YQApplication::setLanguage( const string & language,
     setLangFonts( language, encoding );
 
     if ( oldReverseLayout != YApplication::reverseLayout() )
-    {
-	YDialog * dialog = YDialog::topmostDialog( false ); // don't throw
-
-	if ( dialog )
-	    dialog->recalcLayout();
-    }
+	recalcTopmostDialogLayout();
 }
 
 
 void
 YQApplication::loadPredefinedQtTranslations()
 {
+    if ( deferQtTranslations )
+    {
+	// Only the predefined Qt dialogs need them, not the first dialog;
+	// loadDeferredQtTranslations() loads them once that is on the screen
+	qtTranslationsPending = true;
+	return;
+    }
+
+    YQStartupTrace::Phase phase( "Qt translations" );
     QString path = QLibraryInfo::location(QLibraryInfo::TranslationsPath);
     QString language;
 
@@ -179,6 +205,27 @@ YQApplication::loadPredefinedQtTranslations()
 }
 
 
+void
+YQApplication::loadDeferredQtTranslations()
+{
+    if ( ! deferQtTranslations )
+	return;
+
+    deferQtTranslations = false;
+
+    if ( ! qtTranslationsPending )
+	return;
+
+    qtTranslationsPending = false;
+
+    bool oldReverseLayout = YApplication::reverseLayout();
+    loadPredefinedQtTranslations();
+
+    if ( oldReverseLayout != YApplication::reverseLayout() )
+	recalcTopmostDialogLayout();
+}
+
+
 void
 YQApplication::setLayoutDirection( const string & language )
 {
@@ -222,6 +269,8 @@ YQApplication::setLayoutDirection( const string & language )
 void
 YQApplication::setLangFonts( const string & language, const string & encoding )
 {
+    YQStartupTrace::Phase phase( "language fonts" );
+
     if ( ! _langFonts )
     {
 	_langFonts = new QSettings( LANG_FONTS_FILE, QSettings::IniFormat );
@@ -498,6 +547,7 @@ YQApplication::askForExistingDirectory( const string & startDir,
 					const string & headline )
 {
     normalCursor();
+    loadDeferredQtTranslations();
 
     QString dirName =
 	QFileDialog::getExistingDirectory( 0,				// parent
@@ -516,6 +566,7 @@ YQApplication::askForExistingFile( const string & startWith,
 				   const string & headline )
 {
     normalCursor();
+    loadDeferredQtTranslations();
 
     QFileDialog* dialog = new QFileDialog( 0,				// parent
                                            fromUTF8( headline ),	// caption
@@ -584,6 +635,8 @@ YQApplication::askForSaveFileName( const QString & startWith,
     // Leave the mouse cursor alone - this function might be called from
     // some other widget, not only from UI::AskForSaveFileName().
 
+    YQUI::yqApp()->loadDeferredQtTranslations();
+
     fileName = QFileDialog::getSaveFileName( parent,		// parent
                                              headline,		// caption
                                              startWith,		// dir
@@ -82,9 +82,19 @@ public:
     /**
      * Load translations for Qt's predefined dialogs like file selection box
      * etc.
+     *
+     * Until the first dialog is painted this only notes that the
+     * translations are needed, see loadDeferredQtTranslations().
      **/
     void loadPredefinedQtTranslations();
 
+    /**
+     * Load the translations for the predefined Qt dialogs if that was
+     * deferred until the first dialog is on the screen; nothing is deferred
+     * any more after this call.
+     **/
+    void loadDeferredQtTranslations();
+
     /**
      * Set the layout direction (left-to-right or right-to-left) from
      * 'language'.
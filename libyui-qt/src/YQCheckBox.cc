@@ -94,6 +94,8 @@ YQCheckBox::setValue( YCheckBoxState newValue )
 	    setCheckState(Qt::PartiallyChecked);
 	    break;
     }
+
+    markChanged();
 }
 
 
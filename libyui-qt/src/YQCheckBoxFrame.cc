@@ -75,6 +75,7 @@ void YQCheckBoxFrame::setValue( bool newValue )
 {
     setChecked( newValue );
     setEnabled( newValue );
+    markChanged();
 }
 
 
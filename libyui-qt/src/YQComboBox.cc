@@ -134,6 +134,8 @@ void YQComboBox::setText( const string & newValue )
     {
 	yuiError() << this << ": Rejecting invalid value \"" << newValue << "\"" << endl;
     }
+
+    markChanged();
 }
 
 
@@ -84,6 +84,7 @@ void YQDateField::setValue( const string & newValue )
     _qt_dateEdit->blockSignals(true);
     _qt_dateEdit->setDate( QDate::fromString( fromUTF8( newValue ), Qt::ISODate ) );
     _qt_dateEdit->blockSignals(false);
+    markChanged();
 }
 
 
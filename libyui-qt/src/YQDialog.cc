@@ -293,6 +293,21 @@ YQDialog::resizeEvent( QResizeEvent * event )
 }
 
 
+void
+YQDialog::paintEvent( QPaintEvent * event )
+{
+    QWidget::paintEvent( event );
+
+    static bool firstPaint = true;
+
+    if ( firstPaint )
+    {
+	firstPaint = false;
+	YQUI::ui()->firstDialogPainted();
+    }
+}
+
+
 YQGenericButton *
 YQDialog::findDefaultButton()
 {
@@ -280,6 +280,7 @@ protected:
     virtual void keyPressEvent	( QKeyEvent	* event );
     virtual void focusInEvent	( QFocusEvent	* event );
     virtual void resizeEvent	( QResizeEvent	* event );
+    virtual void paintEvent	( QPaintEvent	* event );
 
 
     //
@@ -25,8 +25,10 @@
 
 #include <qlabel.h>
 #include <qtimer.h>
+#include <QSocketNotifier>
 #define YUILogComponent "qt-ui"
 #include <yui/YUILog.h>
+#include <yui/YFileSizeTracker.h>
 
 #include "utf8.h"
 #include "YQUI.h"
@@ -38,6 +40,27 @@
 using std::string;
 
 
+/**
+ * Listener that updates a YQDownloadProgress from the YFileSizeTracker
+ * only when the size of its file actually changed.
+ **/
+class YQDownloadProgressListener: public YFileSizeListener
+{
+public:
+
+    YQDownloadProgressListener( YQDownloadProgress * widget )
+	: _widget( widget )
+	{}
+
+    virtual void fileSizeChanged( const string & filename, YFileSize_t newSize )
+	{ _widget->pollFileSize(); }
+
+private:
+
+    YQDownloadProgress * _widget;
+};
+
+
 YQDownloadProgress::YQDownloadProgress( YWidget *	parent,
 					const string & 	label,
 					const string &	filename,
@@ -63,19 +86,20 @@ YQDownloadProgress::YQDownloadProgress( YWidget *	parent,
     _qt_progressBar->setRange( 0, 100 ); // Using percent
     _qt_progressBar->setValue( currentPercent() );
 
-    _timer = new QTimer( this );
-
-    connect( _timer, 	&pclass(_timer)::timeout,
-	     this,	&pclass(this)::pollFileSize );
+    _listener = new YQDownloadProgressListener( this );
+    YUI_CHECK_NEW( _listener );
+    YFileSizeTracker::instance()->addFile( filename, _listener );
 
-    _timer->setSingleShot(false);
-    _timer->start( 250 );// millisec
+    YQFileSizeTrackerNotifier::ref();
 }
 
 
 YQDownloadProgress::~YQDownloadProgress()
 {
-    // NOP
+    YFileSizeTracker::instance()->removeFile( filename(), _listener );
+    delete _listener;
+
+    YQFileSizeTrackerNotifier::unref();
 }
 
 
@@ -90,7 +114,9 @@ YQDownloadProgress::setLabel( const string & label )
 void
 YQDownloadProgress::setFilename( const string & filename )
 {
+    YFileSizeTracker::instance()->removeFile( this->filename(), _listener );
     YDownloadProgress::setFilename( filename );
+    YFileSizeTracker::instance()->addFile( filename, _listener );
     _qt_progressBar->setValue( currentPercent() );
 }
 
@@ -139,3 +165,91 @@ YQDownloadProgress::setSize( int newWidth, int newHeight )
     resize( newWidth, newHeight );
 }
 
+
+
+
+
+YQFileSizeTrackerNotifier * YQFileSizeTrackerNotifier::_instance = 0;
+int			    YQFileSizeTrackerNotifier::_refCount = 0;
+
+
+YQFileSizeTrackerNotifier::YQFileSizeTrackerNotifier()
+    : QObject()
+    , _notifier( 0 )
+{
+    YFileSizeTracker * tracker = YFileSizeTracker::instance();
+
+    if ( tracker->fd() >= 0 )
+    {
+	_notifier = new QSocketNotifier( tracker->fd(), QSocketNotifier::Read, this );
+	YUI_CHECK_NEW( _notifier );
+
+	connect( _notifier,	&pclass(_notifier)::activated,
+		 this,		&pclass(this)::processEvents );
+    }
+
+    _timer = new QTimer( this );
+    YUI_CHECK_NEW( _timer );
+
+    connect( _timer,	&pclass(_timer)::timeout,
+	     this,	&pclass(this)::processEvents );
+
+    _timer->setSingleShot( false );
+}
+
+
+YQFileSizeTrackerNotifier::~YQFileSizeTrackerNotifier()
+{
+    // NOP
+}
+
+
+void
+YQFileSizeTrackerNotifier::ref()
+{
+    if ( ! _instance )
+    {
+	_instance = new YQFileSizeTrackerNotifier();
+	YUI_CHECK_NEW( _instance );
+    }
+
+    _refCount++;
+    _instance->updateTimer();
+}
+
+
+void
+YQFileSizeTrackerNotifier::unref()
+{
+    if ( --_refCount <= 0 )
+    {
+	delete _instance;
+	_instance = 0;
+	_refCount = 0;
+    }
+}
+
+
+void
+YQFileSizeTrackerNotifier::processEvents()
+{
+    YFileSizeTracker::instance()->processEvents();
+    updateTimer();
+}
+
+
+void
+YQFileSizeTrackerNotifier::updateTimer()
+{
+    YFileSizeTracker * tracker = YFileSizeTracker::instance();
+
+    if ( tracker->fd() < 0 || tracker->needsPolling() )
+    {
+	if ( ! _timer->isActive() )
+	    _timer->start( tracker->pollInterval() );
+    }
+    else
+    {
+	_timer->stop();
+    }
+}
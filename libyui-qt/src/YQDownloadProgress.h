@@ -30,7 +30,10 @@
 #include <yui/YDownloadProgress.h>
 
 class YQWidgetCaption;
+class YFileSizeListener;
 class QProgressBar;
+class QSocketNotifier;
+class QTimer;
 
 
 class YQDownloadProgress : public QFrame, public YDownloadProgress
@@ -113,7 +116,57 @@ protected:
 
     YQWidgetCaption *	_caption;
     QProgressBar *	_qt_progressBar;
+    YFileSizeListener *	_listener;	// calls pollFileSize() on size changes
+};
+
+
+/**
+ * Helper class that feeds the YFileSizeTracker from the Qt event loop:
+ * It watches the tracker's inotify file descriptor and only runs a timer
+ * while there are files that need to be polled.
+ *
+ * There is only one instance that is shared between all YQDownloadProgress
+ * widgets; it is created with the first and deleted with the last one.
+ **/
+class YQFileSizeTrackerNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Create the shared instance if necessary and add a reference to it.
+     **/
+    static void ref();
+
+    /**
+     * Remove a reference and delete the shared instance with the last one.
+     **/
+    static void unref();
+
+protected slots:
+
+    /**
+     * Let the tracker process its pending events.
+     **/
+    void processEvents();
+
+protected:
+
+    YQFileSizeTrackerNotifier();
+    virtual ~YQFileSizeTrackerNotifier();
+
+    /**
+     * Start or stop the poll timer depending on whether the tracker
+     * currently needs polling.
+     **/
+    void updateTimer();
+
+    QSocketNotifier *	_notifier;
     QTimer *		_timer;
+
+    static YQFileSizeTrackerNotifier *	_instance;
+    static int				_refCount;
 };
 
 
@@ -105,6 +105,8 @@ void YQInputField::setValue( const string & newText )
     {
 	yuiError() << this << ": Rejecting invalid value \"" << newText << "\"" << endl;
     }
+
+    markChanged();
 }
 
 
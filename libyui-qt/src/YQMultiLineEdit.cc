@@ -86,6 +86,7 @@ void YQMultiLineEdit::setValue( const string & text )
     YQSignalBlocker sigBlocker( _qt_textEdit );
 
     _qt_textEdit->setText( fromUTF8( text ) );
+    markChanged();
 }
 
 
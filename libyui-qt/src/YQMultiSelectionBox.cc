@@ -225,6 +225,8 @@ YQMultiSelectionBox::setCurrentItem( YItem * yItem )
 	// This does NOT change the item's check box!
 	// (see explanations in YQMultiSelectionBox::currentItem() avove)
     }
+
+    markChanged();
 }
 
 
@@ -178,6 +178,8 @@ void YQPartitionSplitter::setValue( int newValue )
 	_barGraph->setValue( freeSegment,    freeSize );
 	_barGraph->setValue( newPartSegment, newValue );
     }
+
+    markChanged();
 }
 
 
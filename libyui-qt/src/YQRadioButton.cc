@@ -121,6 +121,8 @@ void YQRadioButton::setValue( bool newValue )
 	if ( group )
 	    group->uncheckOtherButtons( this );
     }
+
+    markChanged();
 }
 
 
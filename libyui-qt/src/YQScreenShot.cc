@@ -0,0 +1,322 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:	      YQScreenShot.cc
+
+/-*/
+
+
+#include <QBuffer>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QWidget>
+
+#define YUILogComponent "qt-ui"
+#include <yui/YUILog.h>
+
+#include "YQScreenShot.h"
+#include "utf8.h"
+
+using std::endl;
+
+
+// QImage maps the PNG "quality" 0..100 to the zlib compression level 9..0,
+// 80 is level 1: almost as small as the default level 6, but much faster
+#define FAST_PNG_QUALITY	80
+
+// Images waiting in the queue take memory, don't encode too many at once
+#define MAX_WRITER_THREADS	2
+
+#define QOI_OP_INDEX	0x00
+#define QOI_OP_DIFF	0x40
+#define QOI_OP_LUMA	0x80
+#define QOI_OP_RUN	0xc0
+#define QOI_OP_RGB	0xfe
+#define QOI_MAX_RUN	62
+
+
+/**
+ * Encode an RGB32 image in the QOI format, see the specification at
+ * https://qoiformat.org/qoi-specification.pdf .
+ **/
+static QByteArray qoiEncode( const QImage & image )
+{
+    int width  = image.width();
+    int height = image.height();
+
+    // worst case: one QOI_OP_RGB per pixel + header + end marker
+    QByteArray result( width * height * 4 + 14 + 8, Qt::Uninitialized );
+    uchar * out = (uchar *) result.data();
+    uchar * pos = out;
+
+    *pos++ = 'q';
+    *pos++ = 'o';
+    *pos++ = 'i';
+    *pos++ = 'f';
+
+    for ( int val: { width, height } )
+    {
+	*pos++ = val >> 24;
+	*pos++ = val >> 16;
+	*pos++ = val >> 8;
+	*pos++ = val;
+    }
+
+    *pos++ = 3;	// channels: RGB
+    *pos++ = 0;	// colorspace: sRGB with linear alpha
+
+    // the alpha channel is always 255 in RGB32, it's left out of the
+    // comparisons but it is part of the hash
+    QRgb index[ 64 ] = { 0 };
+    bool indexUsed[ 64 ] = { false };
+    QRgb prev = qRgb( 0, 0, 0 );
+    int  run  = 0;
+
+    for ( int y = 0; y < height; y++ )
+    {
+	const QRgb * line = (const QRgb *) image.constScanLine( y );
+
+	for ( int x = 0; x < width; x++ )
+	{
+	    QRgb px = line[ x ];
+
+	    if ( px == prev )
+	    {
+		if ( ++run == QOI_MAX_RUN )
+		{
+		    *pos++ = QOI_OP_RUN | ( run - 1 );
+		    run = 0;
+		}
+
+		continue;
+	    }
+
+	    if ( run > 0 )
+	    {
+		*pos++ = QOI_OP_RUN | ( run - 1 );
+		run = 0;
+	    }
+
+	    int r = qRed( px );
+	    int g = qGreen( px );
+	    int b = qBlue( px );
+	    int hash = ( r * 3 + g * 5 + b * 7 + 255 * 11 ) % 64;
+
+	    if ( indexUsed[ hash ] && index[ hash ] == px )
+	    {
+		*pos++ = QOI_OP_INDEX | hash;
+	    }
+	    else
+	    {
+		index[ hash ]	  = px;
+		indexUsed[ hash ] = true;
+
+		// the differences wrap around like in the reference encoder
+		int vr = (signed char) ( r - qRed( prev ) );
+		int vg = (signed char) ( g - qGreen( prev ) );
+		int vb = (signed char) ( b - qBlue( prev ) );
+		int vg_r = vr - vg;
+		int vg_b = vb - vg;
+
+		if ( vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2 )
+		{
+		    *pos++ = QOI_OP_DIFF | ( vr + 2 ) << 4 | ( vg + 2 ) << 2 | ( vb + 2 );
+		}
+		else if ( vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8 )
+		{
+		    *pos++ = QOI_OP_LUMA | ( vg + 32 );
+		    *pos++ = ( vg_r + 8 ) << 4 | ( vg_b + 8 );
+		}
+		else
+		{
+		    *pos++ = QOI_OP_RGB;
+		    *pos++ = r;
+		    *pos++ = g;
+		    *pos++ = b;
+		}
+	    }
+
+	    prev = px;
+	}
+    }
+
+    if ( run > 0 )
+	*pos++ = QOI_OP_RUN | ( run - 1 );
+
+    // end marker
+    for ( int i = 0; i < 7; i++ )
+	*pos++ = 0;
+
+    *pos++ = 1;
+
+    result.resize( pos - out );
+
+    return result;
+}
+
+
+/**
+ * Job for the writer thread pool.
+ **/
+class YQScreenShotWriter : public QRunnable
+{
+public:
+
+    YQScreenShotWriter( const QImage & image, const QString & fileName, YQScreenShot::Format format )
+	: _image( image )
+	, _fileName( fileName )
+	, _format( format )
+	{}
+
+    virtual void run()
+    {
+	YQScreenShot::save( _image, _fileName, _format );
+    }
+
+private:
+
+    QImage		 _image;
+    QString		 _fileName;
+    YQScreenShot::Format _format;
+};
+
+
+static QThreadPool * writerPool()
+{
+    static QThreadPool * pool = 0;
+
+    if ( ! pool )
+    {
+	pool = new QThreadPool();
+	pool->setMaxThreadCount( MAX_WRITER_THREADS );
+    }
+
+    return pool;
+}
+
+
+QImage YQScreenShot::grab( QWidget * widget )
+{
+    qreal ratio = widget->devicePixelRatioF();
+    QImage image( widget->size() * ratio, QImage::Format_RGB32 );
+    image.setDevicePixelRatio( ratio );
+
+    widget->render( &image );
+
+    return image;
+}
+
+
+QByteArray YQScreenShot::encode( const QImage & image, Format format )
+{
+    if ( format == QOI )
+	return qoiEncode( image.convertToFormat( QImage::Format_RGB32 ) );
+
+    QByteArray result;
+    QBuffer buffer( &result );
+    buffer.open( QIODevice::WriteOnly );
+    bool ok = false;
+
+    switch ( format )
+    {
+	case PNG:
+	    ok = image.save( &buffer, "PNG", FAST_PNG_QUALITY );
+	    break;
+
+	case PPM:
+	    ok = image.save( &buffer, "PPM" );
+	    break;
+
+	default:
+	    break;
+    }
+
+    if ( ! ok )
+    {
+	yuiError() << "Encoding the screen shot failed" << endl;
+	result.clear();
+    }
+
+    return result;
+}
+
+
+bool YQScreenShot::save( const QImage & image, const QString & fileName, Format format )
+{
+    QByteArray data = encode( image, format );
+
+    if ( data.isEmpty() )
+	return false;
+
+    QSaveFile file( fileName );
+
+    if ( ! file.open( QIODevice::WriteOnly )	   ||
+	 file.write( data ) != data.size() ||
+	 ! file.commit() )
+    {
+	yuiError() << "Couldn't save screen shot " << fileName << ": " << file.errorString() << endl;
+	return false;
+    }
+
+    yuiDebug() << "Saved screen shot " << fileName << " (" << data.size() << " bytes)" << endl;
+
+    return true;
+}
+
+
+void YQScreenShot::saveInBackground( const QImage & image, const QString & fileName, Format format )
+{
+    // QImage is implicitly shared and the pixels are never changed
+    // afterwards, so the copy for the thread is cheap
+    writerPool()->start( new YQScreenShotWriter( image, fileName, format ) );
+}
+
+
+void YQScreenShot::waitForPending()
+{
+    writerPool()->waitForDone();
+}
+
+
+YQScreenShot::Format YQScreenShot::format( const QString & name )
+{
+    QString lower = name.toLower();
+
+    if ( lower == "png" )
+	return PNG;
+    else if ( lower == "qoi" )
+	return QOI;
+    else if ( lower == "ppm" || lower == "raw" )
+	return PPM;
+
+    return UnknownFormat;
+}
+
+
+const char * YQScreenShot::mimeType( Format format )
+{
+    switch ( format )
+    {
+	case PNG:	return "image/png";
+	case QOI:	return "image/qoi";
+	case PPM:	return "image/x-portable-pixmap";
+	default:	return "application/octet-stream";
+    }
+}
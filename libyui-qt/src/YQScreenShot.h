@@ -0,0 +1,102 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:	      YQScreenShot.h
+
+/-*/
+
+#ifndef YQScreenShot_h
+#define YQScreenShot_h
+
+#include <QByteArray>
+#include <QImage>
+#include <QString>
+
+class QWidget;
+
+
+/**
+ * Helper class for screen shots: Render a widget off-screen and encode the
+ * image in memory, in a file or in a background thread.
+ *
+ * The supported formats are all much faster to write than a PNG with the
+ * default compression:
+ *
+ *   PNG  PNG with zlib compression level 1
+ *   QOI  "Quite OK Image" format (https://qoiformat.org), lossless, about
+ *	  as small as a fast PNG and several times faster to encode
+ *   PPM  uncompressed binary PPM ("raw"), no encoding at all
+ **/
+class YQScreenShot
+{
+public:
+
+    enum Format
+    {
+	UnknownFormat = 0,
+	PNG,
+	QOI,
+	PPM
+    };
+
+    /**
+     * Render 'widget' with all its children to an image.
+     *
+     * Unlike grabbing the window from the screen this does not need a round
+     * trip to the X server and works even if the window is covered or not
+     * mapped.
+     **/
+    static QImage grab( QWidget * widget );
+
+    /**
+     * Encode 'image' in 'format'. Returns an empty byte array on error.
+     **/
+    static QByteArray encode( const QImage & image, Format format );
+
+    /**
+     * Encode 'image' and save it to 'fileName'. The file is replaced
+     * atomically, readers never see a half written file.
+     * Returns 'true' on success.
+     **/
+    static bool save( const QImage & image, const QString & fileName, Format format );
+
+    /**
+     * Encode and save 'image' in a background thread and return
+     * immediately. Errors are only logged.
+     **/
+    static void saveInBackground( const QImage & image, const QString & fileName, Format format );
+
+    /**
+     * Wait until all screen shots passed to saveInBackground() are written.
+     **/
+    static void waitForPending();
+
+    /**
+     * Return the format for a format name or a file name suffix ("png",
+     * "qoi", "ppm", case insensitive) or UnknownFormat.
+     **/
+    static Format format( const QString & name );
+
+    /**
+     * Return the MIME type of 'format'.
+     **/
+    static const char * mimeType( Format format );
+};
+
+
+#endif // ifndef YQScreenShot_h
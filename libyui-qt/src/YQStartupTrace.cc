@@ -0,0 +1,219 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:	      YQStartupTrace.cc
+
+/-*/
+
+
+#include <stdlib.h>	// getenv()
+#include <unistd.h>	// sysconf()
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define YUILogComponent "qt-ui"
+#include <yui/YUILog.h>
+
+#include "YQStartupTrace.h"
+
+using std::endl;
+using std::string;
+
+#define ENV_STARTUP_TRACE	"Y2QT_STARTUP_TRACE"
+
+
+namespace
+{
+    struct TracePhase
+    {
+	const char * name;
+	long long    start;	// µs since the start of the trace
+	long long    end;
+    };
+
+    enum TraceState
+    {
+	NotStarted,
+	Running,
+	Finished
+    };
+
+    TraceState		    traceState = NotStarted;
+    YStopWatch		    traceClock;
+    long long		    firstDialogTime = 0;
+    std::vector<TracePhase> tracePhases;
+
+
+    string ms( long long usec )
+    {
+	std::ostringstream str;
+	str.setf( std::ios::fixed );
+	str.precision( 1 );
+	str << usec / 1000.0;
+
+	return str.str();
+    }
+
+
+    /**
+     * Return the time from the process start until now in milliseconds
+     * from /proc or -1 if that is not available.
+     **/
+    long long processAgeMs()
+    {
+	std::ifstream statFile( "/proc/self/stat" );
+	std::ifstream uptimeFile( "/proc/uptime" );
+	string stat;
+	double uptime = 0.0;
+
+	if ( ! std::getline( statFile, stat ) || ! ( uptimeFile >> uptime ) )
+	    return -1;
+
+	// the command in field 2 may contain blanks, start after its ')';
+	// the start time is field 22, in clock ticks since the boot
+	string::size_type pos = stat.rfind( ')' );
+
+	if ( pos == string::npos )
+	    return -1;
+
+	std::istringstream fields( stat.substr( pos + 2 ) );
+	string field;
+
+	for ( int i = 3; i < 22 && fields >> field; i++ )
+	    ;
+
+	unsigned long long startTicks = 0;
+	long ticksPerSec = sysconf( _SC_CLK_TCK );
+
+	if ( ! ( fields >> startTicks ) || ticksPerSec <= 0 )
+	    return -1;
+
+	return (long long) ( uptime * 1000 ) - (long long) ( startTicks * 1000 / ticksPerSec );
+    }
+}
+
+
+void YQStartupTrace::start()
+{
+    if ( traceState != NotStarted )
+	return;
+
+    traceState = Running;
+    traceClock.restart();
+}
+
+
+bool YQStartupTrace::running()
+{
+    return traceState == Running;
+}
+
+
+void YQStartupTrace::firstDialogPainted()
+{
+    if ( traceState != Running )
+	return;
+
+    firstDialogTime = traceClock.elapsed();
+    traceState	    = Finished;
+
+    // nested phases end before the enclosing one
+    std::stable_sort( tracePhases.begin(), tracePhases.end(),
+		      []( const TracePhase & a, const TracePhase & b )
+		      { return a.start < b.start; } );
+
+    write();
+    tracePhases.clear();
+}
+
+
+void YQStartupTrace::addPhase( const char * name, long long start, long long end )
+{
+    if ( traceState == Running )
+	tracePhases.push_back( { name, start, end } );
+}
+
+
+void YQStartupTrace::write()
+{
+    yuiMilestone() << "First dialog painted after " << ms( firstDialogTime ) << " ms" << endl;
+
+    for ( const TracePhase & phase: tracePhases )
+    {
+	yuiMilestone() << "  Startup phase " << phase.name
+		       << ": " << ms( phase.end - phase.start ) << " ms"
+		       << " (at " << ms( phase.start ) << " ms)" << endl;
+    }
+
+    const char * path = getenv( ENV_STARTUP_TRACE );
+
+    if ( ! path || path[0] != '/' )
+	return;
+
+    // the process age now minus the time since the start of the trace
+    long long processStart = processAgeMs();
+
+    if ( processStart >= 0 )
+	processStart = std::max( 0LL, processStart - firstDialogTime / 1000 );
+
+    std::ofstream file( path );
+
+    file << "{\n";
+
+    if ( processStart >= 0 )
+	file << "  \"process_start_ms\" : " << processStart << ",\n";
+
+    file << "  \"first_dialog_ms\" : " << ms( firstDialogTime ) << ",\n"
+	 << "  \"phases\" : [";
+
+    for ( size_t i = 0; i < tracePhases.size(); i++ )
+    {
+	const TracePhase & phase = tracePhases[ i ];
+
+	file << ( i ? ",\n" : "\n" )
+	     << "    { \"name\" : \"" << phase.name << "\""
+	     << ", \"start_ms\" : " << ms( phase.start )
+	     << ", \"duration_ms\" : " << ms( phase.end - phase.start ) << " }";
+    }
+
+    file << "\n  ]\n"
+	 << "}\n";
+
+    file.close();
+
+    if ( ! file )
+	yuiError() << "Can't write the startup trace to " << path << endl;
+}
+
+
+YQStartupTrace::Phase::Phase( const char * name )
+    : _name( name )
+    , _start( traceState == Running ? traceClock.elapsed() : 0 )
+{
+}
+
+
+YQStartupTrace::Phase::~Phase()
+{
+    if ( traceState == Running )
+	addPhase( _name, _start, traceClock.elapsed() );
+}
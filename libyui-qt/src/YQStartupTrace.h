@@ -0,0 +1,100 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:	      YQStartupTrace.h
+
+/-*/
+
+#ifndef YQStartupTrace_h
+#define YQStartupTrace_h
+
+#include <yui/YLatencyHistogram.h>	// YStopWatch
+
+
+/**
+ * Trace of the UI startup: How long the initialization phases (creating the
+ * QApplication, loading the style sheet, the fonts etc.) take and when the
+ * first dialog is painted.
+ *
+ * The trace starts when the YQUI object is created and ends when the first
+ * dialog is painted. It is written to the log, and as JSON to the file set in
+ * the Y2QT_STARTUP_TRACE environment variable (an absolute path):
+ *
+ *     {
+ *       "process_start_ms" : 85,
+ *       "first_dialog_ms" : 412.3,
+ *       "phases" : [ { "name" : "QApplication", "start_ms" : 0.2, "duration_ms" : 61.7 }, ... ]
+ *     }
+ *
+ * "process_start_ms" is the time from the process start to the start of the
+ * trace (with a resolution of the kernel clock ticks), the other times are
+ * relative to the start of the trace. Phases can be nested.
+ *
+ * Usage:
+ *
+ *     {
+ *         YQStartupTrace::Phase phase( "style sheet" );
+ *         ...
+ *     }
+ **/
+class YQStartupTrace
+{
+public:
+
+    /**
+     * Start the trace. Only the first call has any effect.
+     **/
+    static void start();
+
+    /**
+     * Finish the trace when the first dialog is painted and write it.
+     * Only the first call has any effect.
+     **/
+    static void firstDialogPainted();
+
+    /**
+     * Return 'true' if the trace is running, i.e. the first dialog is not
+     * painted yet.
+     **/
+    static bool running();
+
+    /**
+     * Record the time between the construction and the destruction of this
+     * object as a startup phase. This does nothing after the startup.
+     **/
+    class Phase
+    {
+    public:
+
+	Phase( const char * name );
+	~Phase();
+
+    private:
+
+	const char * _name;
+	long long    _start;
+    };
+
+private:
+
+    static void addPhase( const char * name, long long start, long long end );
+    static void write();
+};
+
+
+#endif // ifndef YQStartupTrace_h
@@ -307,6 +307,7 @@ YQTable::cellChanged( const YTableCell * cell )
     YUI_CHECK_PTR( clone );
 
     clone->updateCell( cell );
+    markChanged();
 }
 
 
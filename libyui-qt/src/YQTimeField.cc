@@ -82,6 +82,7 @@ void YQTimeField::setValue( const string & newValue )
     _qt_timeEdit->blockSignals(true);
     _qt_timeEdit->setTime(  QTime::fromString( fromUTF8( newValue ), Qt::ISODate ) );
     _qt_timeEdit->blockSignals(false);
+    markChanged();
 }
 
 
@@ -396,6 +396,7 @@ void YQTimezoneSelector::setCurrentZone( const string &_zone, bool zoom )
 
     d->blink->start();
     update();
+    markChanged();
 }
 
 
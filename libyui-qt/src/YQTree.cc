@@ -124,6 +124,15 @@ void YQTree::setLabel( const string & label )
 
 void YQTree::rebuildTree()
 {
+    YTreeItem  * item  = loadedItem();
+    YQTreeItem * clone = item ? (YQTreeItem *) item->data() : 0;
+
+    if ( clone )
+    {
+	addLoadedChildren( item, clone );
+	return;
+    }
+
     YQSignalBlocker sigBlocker( _qt_treeWidget );
     _qt_treeWidget->clear();
 
@@ -132,6 +141,22 @@ void YQTree::rebuildTree()
 }
 
 
+void YQTree::addLoadedChildren( YTreeItem * item, YQTreeItem * clone )
+{
+    // Only clone the new children instead of the complete tree
+
+    YQSignalBlocker sigBlocker( _qt_treeWidget );
+
+    buildDisplayTree( clone, item->childrenBegin(), item->childrenEnd() );
+
+    if ( ! item->hasLazyChildren() )
+	clone->setChildIndicatorPolicy( QTreeWidgetItem::DontShowIndicatorWhenChildless );
+
+    clone->setOpen( item->isOpen() );
+    _qt_treeWidget->resizeColumnToContents( 0 );
+}
+
+
 void YQTree::buildDisplayTree( YQTreeItem * parentItem, YItemIterator begin, YItemIterator end )
 {
     for ( YItemIterator it = begin; it < end; ++it )
@@ -220,8 +245,19 @@ void YQTree::slotItemExpanded( QTreeWidgetItem * qItem )
     YQTreeItem * item = dynamic_cast<YQTreeItem *> (qItem);
 
     if ( item )
+    {
 	item->setOpen( true );
 
+	if ( item->origItem()->hasLazyChildren() )
+	{
+	    // Let the application create the children; it will call
+	    // childrenLoaded() when it's done.
+
+	    setExpandedItem( item->origItem() );
+	    YQUI::ui()->sendEvent( new YWidgetEvent( this, YEvent::ItemExpanded ) );
+	}
+    }
+
     _qt_treeWidget->resizeColumnToContents( 0 );
 }
 
@@ -506,6 +542,9 @@ void YQTreeItem::init( YQTree *		tree,
 
     if ( tree->hasMultiSelection() )
 	setCheckState(0,Qt::Unchecked);
+
+    if ( _origItem->hasLazyChildren() )
+	setChildIndicatorPolicy( QTreeWidgetItem::ShowIndicator );
 }
 
 
@@ -67,6 +67,9 @@ public:
      * The application should call this (once) after all items have been added
      * with addItem(). YTree::addItems() calls this automatically.
      *
+     * When called from YTree::childrenLoaded(), this only clones the new
+     * children of the loaded item, not the complete tree.
+     *
      * Implemented from YTree.
      **/
     virtual void rebuildTree();
@@ -204,6 +207,12 @@ protected:
      **/
     void openBranch( YQTreeItem * item );
 
+    /**
+     * Clone the children the application added to 'item' after an
+     * ItemExpanded event as children of its display item 'clone'.
+     **/
+    void addLoadedChildren( YTreeItem * item, YQTreeItem * clone );
+
     /**
      * Build a tree of items that will be displayed (YQTreeItems) from the
      * original items between iterators 'begin' and 'end' as child items of
@@ -33,6 +33,7 @@
 #include <QWidget>
 #include <QThread>
 #include <QSocketNotifier>
+#include <QEventLoop>
 #include <QDesktopWidget>
 #include <QEvent>
 #include <QCursor>
@@ -50,12 +51,14 @@
 #include <yui/YEvent.h>
 #include <yui/YCommandLine.h>
 #include <yui/YButtonBox.h>
+#include <yui/YLatencyHistogram.h>
 #include <yui/YUISymbols.h>
 
 #include "YQUI.h"
-#include "QY2Styler.h"
 #include "YQApplication.h"
 #include "YQDialog.h"
+#include "YQScreenShot.h"
+#include "YQStartupTrace.h"
 #include "YQWidgetFactory.h"
 #include "YQOptionalWidgetFactory.h"
 #include "YQWizardButton.h"
@@ -77,6 +80,15 @@
 using std::string;
 
 
+// The idle loop state and statistics of the UI thread, see YQUI::idleLoop().
+// There is only one YQUI instance; keeping them here instead of in the class
+// keeps its layout compatible for derived classes like YQHttpUI.
+static QSocketNotifier *	ycpNotifier   = 0;
+static QEventLoop *		idleEventLoop = 0;
+static YStopWatch		wakeupStopWatch;
+static YLatencyHistogram	idleTimeHistogram;
+static YLatencyHistogram	wakeupLatencyHistogram;
+
 
 static void qMessageHandler( QtMsgType type, const QMessageLogContext &, const QString & msg );
 YQUI * YQUI::_ui = 0;
@@ -100,6 +112,7 @@ YQUI::YQUI( bool withThreads,  bool topmostConstructor )
     : YUI( withThreads )
     , _do_exit_loop( false )
 {
+    YQStartupTrace::start();
     yuiDebug() << "YQUI constructor start" << endl;
 
     // VERSION is a command-line #define (-DVERSION="1.2.3") added
@@ -112,6 +125,7 @@ YQUI::YQUI( bool withThreads,  bool topmostConstructor )
     _fullscreen			= false;
     _noborder			= false;
     _blockedLevel		= 0;
+    _signalReceiver		= 0;
 
     qInstallMessageHandler( qMessageHandler );
     yuiDebug() << "YQUI constructor finished" << endl;
@@ -131,6 +145,7 @@ void YQUI::initUI()
 
     _uiInitialized = true;
     yuiDebug() << "Initializing Qt part" << endl;
+    YQStartupTrace::Phase initPhase( "initUI" );
 
     YCommandLine cmdLine; // Retrieve command line args from /proc/<pid>/cmdline
     string progName;
@@ -155,20 +170,29 @@ void YQUI::initUI()
     char ** argv = cmdLine.argv();
 
     yuiDebug() << "Creating QApplication" << endl;
-    QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
-    new QApplication( _ui_argc, argv );
-    Q_CHECK_PTR( qApp );
-    // Qt keeps track to a global QApplication in qApp.
+
+    {
+	YQStartupTrace::Phase phase( "QApplication" );
+	QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
+	new QApplication( _ui_argc, argv );
+	Q_CHECK_PTR( qApp );
+	// Qt keeps track to a global QApplication in qApp.
+    }
 
     _signalReceiver = new YQUISignalReceiver();
     _busyCursorTimer = new QTimer( _signalReceiver );
     _busyCursorTimer->setSingleShot( true );
 
-    (void) QY2Styler::styler(); // Make sure QY2Styler singleton is created
+    // The QY2Styler singleton and its style sheet are created along with the
+    // first dialog; nothing before that needs them.
 
     setButtonOrderFromEnvironment();
     processCommandLineArgs( _ui_argc, argv );
-    calcDefaultSize();
+
+    {
+	YQStartupTrace::Phase phase( "default size" );
+	calcDefaultSize();
+    }
 
     _do_exit_loop = false;
 
@@ -218,7 +242,11 @@ void YQUI::initUI()
 
     //	Init other stuff
 
-    qApp->setFont( yqApp()->currentFont() );
+    {
+	YQStartupTrace::Phase phase( "fonts" );
+	qApp->setFont( yqApp()->currentFont() );
+    }
+
     busyCursor();
 
 
@@ -233,6 +261,16 @@ void YQUI::initUI()
 }
 
 
+void YQUI::firstDialogPainted()
+{
+    YQStartupTrace::firstDialogPainted();
+
+    // Not before the event loop is idle again, i.e. after the dialog is
+    // on the screen
+    QTimer::singleShot( 0, qApp, [](){ yqApp()->loadDeferredQtTranslations(); } );
+}
+
+
 YQApplication *
 YQUI::yqApp()
 {
@@ -293,6 +331,9 @@ YQUI::~YQUI()
 {
     yuiMilestone() <<"Closing down Qt UI." << endl;
 
+    // Finish writing the screen shots
+    YQScreenShot::waitForPending();
+
     // Intentionally NOT calling dlclose() to libqt-mt
     // (see constructor for explanation)
 
@@ -311,6 +352,20 @@ YQUI::uiThreadDestructor()
 {
     yuiMilestone() <<"Destroying UI thread" << endl;
 
+    if ( ycpNotifier )
+    {
+	yuiMilestone() << uiThreadCommands() << " UI calls in "
+		       << uiThreadWakeups()  << " wakeups" << endl;
+	yuiMilestone() << "Idle time: "      << idleTimeHistogram      << endl;
+	yuiMilestone() << "Wakeup latency: " << wakeupLatencyHistogram << endl;
+
+	// The pipe will be closed after this returns
+	delete ycpNotifier;
+	delete idleEventLoop;
+	ycpNotifier   = 0;
+	idleEventLoop = 0;
+    }
+
     if ( qApp ) // might already be reset to 0 internally from Qt
     {
 	if ( YDialog::openDialogsCount() > 0 )
@@ -411,12 +466,21 @@ void YQUI::idleLoop( int fd_ycp )
 {
     initUI();
 
-    _received_ycp_command = false;
-    QSocketNotifier * notifier = new QSocketNotifier( fd_ycp, QSocketNotifier::Read );
-    QObject::connect( notifier,		&pclass(notifier)::activated,
-		      _signalReceiver,	&pclass(_signalReceiver)::slotReceivedYCPCommand );
+    if ( ! ycpNotifier )
+    {
+	// This is entered for every single call from the YCP thread, so create
+	// the notifier and the event loop only once and keep them.
 
-    notifier->setEnabled( true );
+	ycpNotifier = new QSocketNotifier( fd_ycp, QSocketNotifier::Read, _signalReceiver );
+	QObject::connect( ycpNotifier,		&pclass(ycpNotifier)::activated,
+			  _signalReceiver,	&pclass(_signalReceiver)::slotReceivedYCPCommand );
+
+	idleEventLoop = new QEventLoop( _signalReceiver );
+    }
+
+    YStopWatch idleStopWatch;
+    _received_ycp_command = false;
+    ycpNotifier->setEnabled( true );
 
 
     //
@@ -427,22 +491,41 @@ void YQUI::idleLoop( int fd_ycp )
     yuiDebug() << "Entering idle loop" << endl;
 #endif
 
-    QEventLoop eventLoop( qApp );
-
     while ( !_received_ycp_command )
-	eventLoop.processEvents( QEventLoop::ExcludeUserInputEvents | QEventLoop::WaitForMoreEvents );
+	idleEventLoop->exec( QEventLoop::ExcludeUserInputEvents );
 
 #if VERBOSE_EVENT_LOOP
     yuiDebug() << "Leaving idle loop" << endl;
 #endif
 
-    delete notifier;
+    // Disable the notifier while the command is handled: The byte is only
+    // read from fd_ycp after this returns, so it would keep firing.
+    ycpNotifier->setEnabled( false );
+
+    wakeupLatencyHistogram.add( wakeupStopWatch.elapsed() );
+    idleTimeHistogram.add( idleStopWatch.elapsed() );
 }
 
 
 void YQUI::receivedYCPCommand()
 {
     _received_ycp_command = true;
+    wakeupStopWatch.restart();
+
+    if ( idleEventLoop )
+	idleEventLoop->exit( 0 );
+}
+
+
+const YLatencyHistogram & YQUI::idleTime() const
+{
+    return idleTimeHistogram;
+}
+
+
+const YLatencyHistogram & YQUI::wakeupLatency() const
+{
+    return wakeupLatencyHistogram;
 }
 
 
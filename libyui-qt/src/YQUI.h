@@ -51,6 +51,7 @@ class QCursor;
 class QFrame;
 class QStackedWidget;
 class YEvent;
+class YLatencyHistogram;
 class YQOptionalWidgetFactory;
 class YQWidgetFactory;
 class YQApplication;
@@ -192,7 +193,14 @@ public:
     int defaultSize( YUIDimension dim ) const;
 
     /**
-     * Make a screen shot in .png format and save it to 'filename'.
+     * Make a screen shot of the current dialog and save it to 'filename'.
+     * The format is taken from the file name suffix: .png (default), .qoi
+     * or .ppm (see YQScreenShot). The file is complete when this returns.
+     *
+     * If the environment variable Y2SCREENSHOTS_BACKGROUND is set, a
+     * screen shot with a given 'filename' is encoded and written in a
+     * background thread instead, the file appears when it is complete.
+     *
      * Opens a file selection box if 'filename' is empty.
      **/
     void makeScreenShot( std::string filename );
@@ -246,6 +254,13 @@ public:
      **/
     void forceUnblockEvents();
 
+    /**
+     * Notification that the first dialog is being painted: Finish the
+     * startup trace and load what was deferred until the first dialog
+     * is on the screen.
+     **/
+    void firstDialogPainted();
+
     /**
      * Show mouse cursor indicating busy state.
      **/
@@ -308,6 +323,17 @@ public:
      **/
     QIcon loadIcon( const string & iconName ) const;
 
+    /**
+     * Event loop statistics for diagnostics (only collected when running
+     * with a separate UI thread):
+     *
+     * The time spent in idleLoop() per call and the latency between the
+     * event loop noticing a new command from the YCP thread and actually
+     * leaving idleLoop() to handle it.
+     **/
+    const YLatencyHistogram & idleTime() const;
+    const YLatencyHistogram & wakeupLatency() const;
+
 protected:
 
     /**
@@ -32,11 +32,9 @@
 
 #include <QCursor>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QMessageBox>
-#include <QPixmap>
 #include <QInputDialog>
-#include <QWindow>
-#include <QScreen>
 #include <qdir.h>
 
 #define YUILogComponent "qt-ui"
@@ -49,6 +47,7 @@
 #include "YQDialog.h"
 #include "YQSignalBlocker.h"
 #include "YQApplication.h"
+#include "YQScreenShot.h"
 
 #include "utf8.h"
 #include "YQi18n.h"
@@ -94,16 +93,14 @@ YEvent * YQUI::runPkgSelection( YWidget * packageSelector )
 void YQUI::makeScreenShot( string stl_filename )
 {
     //
-    // Grab the pixels off the screen
+    // Render the dialog window off-screen
     //
 
     QWidget * dialog = (QWidget *) YDialog::currentDialog()->widgetRep();
     YUI_CHECK_PTR( dialog );
     QWidget * topLevelWidget = dialog->window();
     YUI_CHECK_PTR( topLevelWidget );
-    QWindow * window = topLevelWidget->windowHandle();
-    YUI_CHECK_PTR( window );
-    QPixmap screenShot = window->screen()->grabWindow( window->winId() );
+    QImage screenShot = YQScreenShot::grab( topLevelWidget );
     QString fileName ( stl_filename.c_str() );
     bool interactive = false;
 
@@ -182,8 +179,25 @@ void YQUI::makeScreenShot( string stl_filename )
     // Actually save the screen shot
     //
 
+    // The format is taken from the file name suffix (.png, .qoi, .ppm),
+    // default is PNG
+    YQScreenShot::Format format = YQScreenShot::format( QFileInfo( fileName ).suffix() );
+
+    if ( format == YQScreenShot::UnknownFormat )
+	format = YQScreenShot::PNG;
+
     yuiDebug() << "Saving screen shot to " << fileName << endl;
-    bool success = screenShot.save( fileName, "PNG" );
+
+    if ( ! interactive && getenv( "Y2SCREENSHOTS_BACKGROUND" ) )
+    {
+	// Opt-in for callers that take many screen shots (e.g. an automated
+	// test after each step): Don't block the UI while encoding, the file
+	// appears when it is complete, errors are only logged
+	YQScreenShot::saveInBackground( screenShot, fileName, format );
+	return;
+    }
+
+    bool success = YQScreenShot::save( screenShot, fileName, format );
 
     if ( ! success )
     {
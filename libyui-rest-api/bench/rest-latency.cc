@@ -0,0 +1,360 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+   File:       rest-latency.cc
+
+/-*/
+
+
+// Request latency benchmark for the libyui REST API
+//
+// Sends the same GET request many times to an application with the REST
+// API enabled and prints one JSON line with the latency statistics, so the
+// TCP and the Unix domain socket transports (and keep-alive vs. a new
+// connection for each request) can be compared:
+//
+//     YUI_HTTP_PORT=9999 YUI_HTTP_SOCKET=/tmp/yui.sock ./SelectionBox1 &
+//
+//     rest-latency tcp:localhost:9999 /v1/dialog
+//     rest-latency unix:/tmp/yui.sock /v1/dialog
+//
+// Options:
+//
+//     -n count	    number of requests (default 1000)
+//     -p depth	    pipelining: send 'depth' requests before reading the
+//		    responses (default 1)
+//     -r	    open a new connection for each request (no keep-alive)
+//     -a user:pwd  HTTP basic authentication (only needed for TCP)
+
+
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+
+struct Options
+{
+    std::string target;
+    std::string path	= "/v1/dialog";
+    std::string auth;
+    int		count	= 1000;
+    int		depth	= 1;
+    bool	reconnect = false;
+};
+
+
+static void die( const std::string & msg )
+{
+    fprintf( stderr, "rest-latency: %s\n", msg.c_str() );
+    exit( 1 );
+}
+
+
+static std::string base64( const std::string & in )
+{
+    static const char * chars =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    size_t i = 0;
+
+    for ( ; i + 2 < in.size(); i += 3 )
+    {
+	unsigned n = ( (unsigned char) in[i] << 16 ) | ( (unsigned char) in[i+1] << 8 ) | (unsigned char) in[i+2];
+	out += chars[ ( n >> 18 ) & 63 ];
+	out += chars[ ( n >> 12 ) & 63 ];
+	out += chars[ ( n >> 6 ) & 63 ];
+	out += chars[ n & 63 ];
+    }
+
+    if ( i + 1 == in.size() )
+    {
+	unsigned n = (unsigned char) in[i] << 16;
+	out += chars[ ( n >> 18 ) & 63 ];
+	out += chars[ ( n >> 12 ) & 63 ];
+	out += "==";
+    }
+    else if ( i + 2 == in.size() )
+    {
+	unsigned n = ( (unsigned char) in[i] << 16 ) | ( (unsigned char) in[i+1] << 8 );
+	out += chars[ ( n >> 18 ) & 63 ];
+	out += chars[ ( n >> 12 ) & 63 ];
+	out += chars[ ( n >> 6 ) & 63 ];
+	out += '=';
+    }
+
+    return out;
+}
+
+
+/**
+ * Connect to "unix:/path" or "tcp:host:port".
+ **/
+static int connectTo( const std::string & target )
+{
+    if ( target.compare( 0, 5, "unix:" ) == 0 )
+    {
+	struct sockaddr_un addr;
+	memset( &addr, 0, sizeof( addr ) );
+	addr.sun_family = AF_UNIX;
+	strncpy( addr.sun_path, target.c_str() + 5, sizeof( addr.sun_path ) - 1 );
+
+	int fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+
+	if ( fd < 0 || connect( fd, (struct sockaddr *) &addr, sizeof( addr ) ) < 0 )
+	    die( "cannot connect to " + target + ": " + strerror( errno ) );
+
+	return fd;
+    }
+
+    if ( target.compare( 0, 4, "tcp:" ) == 0 )
+    {
+	std::string hostPort = target.substr( 4 );
+	size_t colon = hostPort.rfind( ':' );
+
+	if ( colon == std::string::npos )
+	    die( "missing port in " + target );
+
+	std::string host = hostPort.substr( 0, colon );
+	std::string port = hostPort.substr( colon + 1 );
+
+	struct addrinfo hints;
+	struct addrinfo * res = 0;
+	memset( &hints, 0, sizeof( hints ) );
+	hints.ai_socktype = SOCK_STREAM;
+
+	if ( getaddrinfo( host.c_str(), port.c_str(), &hints, &res ) != 0 || ! res )
+	    die( "cannot resolve " + host );
+
+	int fd = socket( res->ai_family, res->ai_socktype, res->ai_protocol );
+
+	if ( fd < 0 || connect( fd, res->ai_addr, res->ai_addrlen ) < 0 )
+	    die( "cannot connect to " + target + ": " + strerror( errno ) );
+
+	// don't let Nagle's algorithm delay the requests
+	int one = 1;
+	setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof( one ) );
+
+	freeaddrinfo( res );
+	return fd;
+    }
+
+    die( "unknown target " + target + ", use unix:/path or tcp:host:port" );
+    return -1;
+}
+
+
+static void sendAll( int fd, const std::string & data )
+{
+    size_t done = 0;
+
+    while ( done < data.size() )
+    {
+	ssize_t n = write( fd, data.data() + done, data.size() - done );
+
+	if ( n < 0 && errno == EINTR )
+	    continue;
+
+	if ( n <= 0 )
+	    die( std::string( "write failed: " ) + strerror( errno ) );
+
+	done += n;
+    }
+}
+
+
+/**
+ * Read one complete response (with Content-Length) from 'fd'. Data after the
+ * response (the next pipelined response) stays in 'buffer'. Return the
+ * response size.
+ **/
+static size_t readResponse( int fd, std::string & buffer )
+{
+    size_t headerEnd;
+    size_t length = std::string::npos;
+
+    while ( true )
+    {
+	headerEnd = buffer.find( "\r\n\r\n" );
+
+	if ( headerEnd != std::string::npos && length == std::string::npos )
+	{
+	    std::string header = buffer.substr( 0, headerEnd );
+
+	    if ( header.compare( 0, 9, "HTTP/1.1 " ) != 0 && header.compare( 0, 9, "HTTP/1.0 " ) != 0 )
+		die( "invalid response" );
+
+	    int status = atoi( header.c_str() + 9 );
+
+	    if ( status != 200 && status != 304 )
+		die( "response status " + std::to_string( status ) );
+
+	    size_t pos = 0;
+	    size_t contentLength = 0;
+
+	    while ( ( pos = header.find( "\r\n", pos ) ) != std::string::npos )
+	    {
+		pos += 2;
+
+		if ( strncasecmp( header.c_str() + pos, "Content-Length:", 15 ) == 0 )
+		    contentLength = strtoul( header.c_str() + pos + 15, 0, 10 );
+	    }
+
+	    length = headerEnd + 4 + contentLength;
+	}
+
+	if ( length != std::string::npos && buffer.size() >= length )
+	    break;
+
+	char chunk[ 64 * 1024 ];
+	ssize_t n = read( fd, chunk, sizeof( chunk ) );
+
+	if ( n < 0 && errno == EINTR )
+	    continue;
+
+	if ( n <= 0 )
+	    die( "connection closed" );
+
+	buffer.append( chunk, n );
+    }
+
+    buffer.erase( 0, length );
+    return length;
+}
+
+
+static void usage()
+{
+    fprintf( stderr,
+	     "Usage: rest-latency [-n count] [-p depth] [-r] [-a user:password]\n"
+	     "                    unix:/path|tcp:host:port [request-path]\n" );
+    exit( 2 );
+}
+
+
+int main( int argc, char ** argv )
+{
+    Options opt;
+    int c;
+
+    while ( ( c = getopt( argc, argv, "n:p:ra:" ) ) != -1 )
+    {
+	switch ( c )
+	{
+	    case 'n': opt.count	    = atoi( optarg );	break;
+	    case 'p': opt.depth	    = atoi( optarg );	break;
+	    case 'r': opt.reconnect = true;		break;
+	    case 'a': opt.auth	    = optarg;		break;
+	    default:  usage();
+	}
+    }
+
+    if ( optind >= argc || opt.count < 1 || opt.depth < 1 )
+	usage();
+
+    opt.target = argv[ optind++ ];
+
+    if ( optind < argc )
+	opt.path = argv[ optind++ ];
+
+    if ( opt.reconnect )
+	opt.depth = 1;
+
+    std::string request = "GET " + opt.path + " HTTP/1.1\r\nHost: localhost\r\n";
+
+    if ( ! opt.auth.empty() )
+	request += "Authorization: Basic " + base64( opt.auth ) + "\r\n";
+
+    if ( opt.reconnect )
+	request += "Connection: close\r\n";
+
+    request += "\r\n";
+
+    std::vector<long> latencies;
+    latencies.reserve( opt.count );
+    size_t bytes = 0;
+    std::string buffer;
+    int fd = -1;
+
+    Clock::time_point start = Clock::now();
+
+    for ( int done = 0; done < opt.count; )
+    {
+	int batch = std::min( opt.depth, opt.count - done );
+
+	if ( fd < 0 )
+	{
+	    fd = connectTo( opt.target );
+	    buffer.clear();
+	}
+
+	Clock::time_point sent = Clock::now();
+	std::string requests;
+
+	for ( int i = 0; i < batch; i++ )
+	    requests += request;
+
+	sendAll( fd, requests );
+
+	for ( int i = 0; i < batch; i++ )
+	{
+	    bytes += readResponse( fd, buffer );
+	    latencies.push_back( std::chrono::duration_cast<std::chrono::microseconds>( Clock::now() - sent ).count() );
+	}
+
+	done += batch;
+
+	if ( opt.reconnect )
+	{
+	    close( fd );
+	    fd = -1;
+	}
+    }
+
+    long totalMs = std::chrono::duration_cast<std::chrono::milliseconds>( Clock::now() - start ).count();
+
+    if ( fd >= 0 )
+	close( fd );
+
+    std::sort( latencies.begin(), latencies.end() );
+
+    printf( "{ \"target\": \"%s\", \"path\": \"%s\", \"requests\": %d, \"pipeline\": %d, \"keep_alive\": %s, "
+	    "\"min_us\": %ld, \"median_us\": %ld, \"p99_us\": %ld, \"max_us\": %ld, "
+	    "\"total_ms\": %ld, \"bytes\": %zu }\n",
+	    opt.target.c_str(), opt.path.c_str(), opt.count, opt.depth, opt.reconnect ? "false" : "true",
+	    latencies.front(), latencies[ latencies.size() / 2 ],
+	    latencies[ std::min( latencies.size() - 1, latencies.size() * 99 / 100 ) ], latencies.back(),
+	    totalMs, bytes );
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <json/json.h>
+#include <microhttpd.h>
+#include <sstream>
+
+#define YUILogComponent "rest-api"
+#include <yui/YUILog.h>
+
+#include "YJsonSerializer.h"
+#include "YHttpBatchHandler.h"
+
+
+void YHttpBatchHandler::process_request(struct MHD_Connection* connection,
+    const char* url, const char* method, const char* upload_data,
+    size_t* upload_data_size, std::ostream& body, int& error_code,
+    std::string& content_type, bool *redraw)
+{
+    content_type = "application/json";
+
+    Json::Value actions;
+    std::string errors;
+    std::istringstream upload( std::string( upload_data ? upload_data : "", *upload_data_size ) );
+
+    if ( !Json::parseFromStream( Json::CharReaderBuilder(), upload, &actions, &errors ) )
+    {
+        error_code = handle_error( body, "Cannot parse the actions: " + errors, MHD_HTTP_BAD_REQUEST );
+        return;
+    }
+
+    Json::Value results;
+    error_code = _widgets_action_handler->do_actions( actions, results );
+
+    yuiMilestone() << "Executed " << results.size() << " of " << actions.size() << " actions" << std::endl;
+
+    // the actions possibly changed something in the UI, redraw only once
+    // for all of them
+    if ( redraw && !results.empty() )
+        *redraw = true;
+
+    YJsonSerializer::save( results, body );
+}
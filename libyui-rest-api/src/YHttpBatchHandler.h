@@ -0,0 +1,55 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YHttpBatchHandler_h
+#define YHttpBatchHandler_h
+
+#include "YHttpHandler.h"
+#include "YHttpWidgetsActionHandler.h"
+
+/**
+ * Handler for POST /batch: Executes a JSON array of widget actions (sent
+ * as the request body) in one request, i.e. with one widget lookup per
+ * action but only one UI redraw at the end and no HTTP round trip between
+ * the actions.
+ **/
+class YHttpBatchHandler : public YHttpHandler
+{
+
+public:
+
+    /**
+     * Constructor. The actions are done by 'widgets_action_handler', so the
+     * UI specific actions are the same as for POST /widgets.
+     **/
+    YHttpBatchHandler( YHttpWidgetsActionHandler * widgets_action_handler )
+        : _widgets_action_handler( widgets_action_handler ) {}
+
+    virtual ~YHttpBatchHandler() {}
+
+protected:
+
+    virtual void process_request(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, std::ostream& body, int& error_code,
+        std::string& content_type, bool *redraw);
+
+private:
+
+    YHttpWidgetsActionHandler * _widgets_action_handler;
+};
+
+#endif // YHttpBatchHandler_h
@@ -16,7 +16,10 @@
 
 #include <yui/YDialog.h>
 #include <microhttpd.h>
+#include <json/json.h>
+#include <stdlib.h>
 #include "YJsonSerializer.h"
+#include "YWidgetFinder.h"
 
 #include "YHttpDialogHandler.h"
 
@@ -27,7 +30,15 @@ void YHttpDialogHandler::process_request(struct MHD_Connection* connection,
     std::string& content_type, bool *redraw)
 {
     if (auto dialog = YDialog::topmostDialog(false))  {
-        YJsonSerializer::serialize(dialog, body);
+        const char* since = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "since");
+
+        if (since) {
+            serialize_changes(dialog, strtoul(since, nullptr, 10), item_options(connection), body);
+        }
+        else {
+            YJsonSerializer::serialize(dialog, body, true, item_options(connection));
+        }
+
         error_code = MHD_HTTP_OK;
     }
     else {
@@ -37,3 +48,33 @@ void YHttpDialogHandler::process_request(struct MHD_Connection* connection,
 
     content_type = "application/json";
 }
+
+void YHttpDialogHandler::serialize_changes(YDialog *dialog, unsigned long since,
+    const YJsonItemOptions &options, std::ostream& body)
+{
+    Json::Value json;
+    json["version"] = Json::UInt64(dialog->changeVersion());
+
+    // the client's version is too old to tell which widgets changed,
+    // send the complete dialog
+    if (dialog->allChangedVersion() > since) {
+        json["dialog"] = YJsonSerializer::json(dialog, true, options);
+    }
+    else {
+        // non recursive dump, the changed children are listed separately
+        Json::Value widgets(Json::arrayValue);
+
+        for(YWidget *widget: YWidgetFinder::changed_since(since))
+            widgets.append(YJsonSerializer::json(widget, false, options));
+
+        json["widgets"] = widgets;
+    }
+
+    YJsonSerializer::save(json, body);
+}
+
+std::string YHttpDialogHandler::etag(struct MHD_Connection* connection)
+{
+    auto dialog = YDialog::topmostDialog(false);
+    return dialog ? "\"" + std::to_string(dialog->changeVersion()) + "\"" : "";
+}
@@ -19,6 +19,8 @@
 
 #include "YHttpHandler.h"
 
+class YDialog;
+
 class YHttpDialogHandler : public YHttpHandler
 {
 
@@ -34,6 +36,14 @@ protected:
         size_t* upload_data_size, std::ostream& body, int& error_code,
         std::string& content_type, bool *redraw);
 
+    virtual std::string etag(struct MHD_Connection* connection);
+
+private:
+
+    // serialize the widgets changed after the "since" change version
+    void serialize_changes(YDialog *dialog, unsigned long since,
+        const YJsonItemOptions &options, std::ostream& body);
+
 };
 
 #endif // YHttpDialogHandler_h
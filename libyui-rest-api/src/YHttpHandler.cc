@@ -14,9 +14,12 @@
   Floor, Boston, MA 02110-1301 USA
 */
 
+#include <algorithm>
 #include <json/json.h>
 #include <microhttpd.h>
 #include <sstream>
+#include <stdlib.h>
+#include <string.h>
 
 #define YUILogComponent "rest-api"
 #include <yui/YUILog.h>
@@ -32,6 +35,23 @@ MHD_RESULT YHttpHandler::handle(struct MHD_Connection* connection,
     std::ostringstream body_s;
     std::string content_type;
     int error_code;
+    std::string tag = etag(connection);
+    const char* if_none_match = MHD_lookup_connection_value(connection, MHD_HEADER_KIND,
+        MHD_HTTP_HEADER_IF_NONE_MATCH);
+
+    if (!tag.empty() && if_none_match && tag == if_none_match)
+    {
+        // the client already has the current content
+        struct MHD_Response *response = MHD_create_response_from_buffer(0, nullptr,
+            MHD_RESPMEM_PERSISTENT);
+        MHD_add_response_header(response, MHD_HTTP_HEADER_ETAG, tag.c_str());
+
+        yuiMilestone() << "Sending response: code: " << MHD_HTTP_NOT_MODIFIED << ", ETag: " << tag << std::endl;
+
+        MHD_RESULT ret = MHD_queue_response(connection, MHD_HTTP_NOT_MODIFIED, response);
+        MHD_destroy_response(response);
+        return ret;
+    }
 
     process_request(connection, url, method, upload_data, upload_data_size,
       body_s, error_code, content_type, redraw);
@@ -43,6 +63,9 @@ MHD_RESULT YHttpHandler::handle(struct MHD_Connection* connection,
     if (!content_type.empty())
         MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, content_type.c_str());
 
+    if (!tag.empty() && error_code == MHD_HTTP_OK)
+        MHD_add_response_header(response, MHD_HTTP_HEADER_ETAG, tag.c_str());
+
     yuiMilestone() << "Sending response: code: " << error_code << ", body size: " << body_str.length()
       << ", content type: " << content_type << std::endl;
 
@@ -58,3 +81,38 @@ int YHttpHandler::handle_error(std::ostream& body, std::string error, int error_
     YJsonSerializer::save(response, body);
     return error_code;
 }
+
+YJsonItemOptions YHttpHandler::item_options(struct MHD_Connection* connection)
+{
+    YJsonItemOptions options;
+
+    const char* offset = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "items_offset");
+    const char* limit = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "items_limit");
+    const char* columns = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "items_columns");
+    const char* label = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "items_label");
+    const char* selected = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "items_selected");
+
+    if (offset)
+        options.offset = std::max(0, atoi(offset));
+
+    if (limit)
+        options.limit = atoi(limit);
+
+    if (columns)
+    {
+        // comma separated list of column indexes
+        std::istringstream list(columns);
+        std::string column;
+
+        while (std::getline(list, column, ','))
+            options.columns.push_back(atoi(column.c_str()));
+    }
+
+    if (label)
+        options.label = label;
+
+    if (selected)
+        options.selected_only = strcmp(selected, "true") == 0 || strcmp(selected, "1") == 0;
+
+    return options;
+}
@@ -34,6 +34,8 @@
 #include <string>
 #include <iostream>
 
+#include "YJsonSerializer.h"
+
 struct MHD_Connection;
 
 class YHttpHandler
@@ -57,6 +59,14 @@ protected:
         std::string& content_type, bool *redraw) = 0;
 
     int handle_error(std::ostream& body, std::string error, int error_code);
+
+    // read the item options (items_offset, items_limit, items_columns,
+    // items_label, items_selected) from the request parameters
+    static YJsonItemOptions item_options(struct MHD_Connection* connection);
+
+    // the entity tag of the current response content (without processing
+    // the request), empty if the handler does not support conditional requests
+    virtual std::string etag(struct MHD_Connection* connection) { return ""; }
 };
 
 #endif // YHttpHandler_h
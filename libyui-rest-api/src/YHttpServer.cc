@@ -22,7 +22,11 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <arpa/inet.h>
+#include <errno.h>
+#include <unistd.h>
 
 #include <microhttpd.h>
 
@@ -32,6 +36,7 @@
 #include <yui/YDialog.h>
 
 #include "YHttpAppHandler.h"
+#include "YHttpBatchHandler.h"
 #include "YHttpDialogHandler.h"
 #include "YHttpRootHandler.h"
 #include "YHttpVersionHandler.h"
@@ -46,6 +51,20 @@ YHttpServer * YHttpServer::_yserver = 0;
 YHttpWidgetsActionHandler * YHttpServer::_widget_action_handler = 0;
 
 const char *auth_error_body = "{ \"error\" : \"Authentication error, wrong user name or password\" }\n";
+const char *too_large_error_body = "{ \"error\" : \"Request body too large\" }\n";
+
+// the maximum accepted size of a request body, the largest requests are
+// batches of widget actions which are much smaller
+const size_t max_body_size = 1024 * 1024;
+
+// the state of a request between the handleRequest() calls
+struct RequestBody
+{
+    // the request body collected so far
+    std::string data;
+    // the body exceeds max_body_size, the rest is discarded
+    bool too_large = false;
+};
 
 int YHttpServer::port_num()
 {
@@ -53,6 +72,12 @@ int YHttpServer::port_num()
     return env_port ? atoi(env_port) : 0;
 }
 
+std::string YHttpServer::socket_path()
+{
+    const char* env_socket = getenv( YUI_HTTP_SOCKET );
+    return env_socket ? env_socket : "";
+}
+
 // For security reasons accept the connections only from the localhost
 // by default, allow listening on all interfaces only when explicitly allowed.
 bool remote_access()
@@ -94,7 +119,7 @@ struct in6_addr listen_address_v6(bool remote)
 }
 
 YHttpServer::YHttpServer(YHttpWidgetsActionHandler * widgets_action_handler)
-    : server_v4(nullptr), server_v6(nullptr), redraw(false)
+    : server_v4(nullptr), server_v6(nullptr), server_unix(nullptr), redraw(false), wait_handler(nullptr)
 {
     _yserver = this;
     _widget_action_handler = widgets_action_handler;
@@ -133,6 +158,12 @@ YHttpServer::~YHttpServer()
         yuiMilestone() << "Stopping IPv6 HTTP server" << std::endl;
         MHD_stop_daemon(server_v6);
     }
+
+    if (server_unix) {
+        yuiMilestone() << "Stopping Unix socket HTTP server" << std::endl;
+        MHD_stop_daemon(server_unix);
+        unlink(socket_path().c_str());
+    }
 }
 
 // add the server file descriptors to the socket lists
@@ -164,6 +195,7 @@ YHttpServerSockets YHttpServer::sockets()
 
     if (server_v4) add_fds(server_v4, ret);
     if (server_v6) add_fds(server_v6, ret);
+    if (server_unix) add_fds(server_unix, ret);
 
     if (ret.empty())
         yuiWarning() << "Not watching any FD!" << std::endl;
@@ -205,40 +237,106 @@ bool authenticated(struct MHD_Connection *connection, const YHttpServer *server)
     return success;
 }
 
-// callback for handling the HTTP request
+// handle the HTTP request, check the user name and password if 'check_auth' is set
 static MHD_RESULT
-requestHandler(void *srv,
+handleRequest(void *srv,
           struct MHD_Connection *connection,
           const char *url,
           const char *method,
-          const char *version,
-          const char *upload_data, size_t *upload_data_size, void **ptr)
+          const char *upload_data, size_t *upload_data_size, void **ptr,
+          bool check_auth)
 {
-    // remember the callback status
-    static int aptr;
+    RequestBody *upload = (RequestBody *) *ptr;
+    YHttpServer *server = (YHttpServer *)srv;
 
-    if (&aptr != *ptr)
+    if (!upload)
     {
-        // do not respond on first call, it's used for the initial check to close invalid requests early
-        *ptr = &aptr;
+        // the first call is used for the initial check to close invalid requests early:
+        // reject failed basic auth (if configured) before any request body is buffered
+        if (check_auth && (!server->user().empty() || !server->passwd().empty()) && !authenticated(connection, server))
+        {
+            struct MHD_Response *response = MHD_create_response_from_buffer(strlen(auth_error_body),
+                (void *) auth_error_body, MHD_RESPMEM_PERSISTENT);
+            MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, "application/json");
+            MHD_RESULT ret = MHD_queue_basic_auth_fail_response(connection, "libyui realm", response);
+            MHD_destroy_response(response);
+            return ret;
+        }
+
+        *ptr = new RequestBody();
         // continue processing the request
         return MHD_YES;
     }
-    // reset
-    *ptr = NULL;
 
-    YHttpServer *server = (YHttpServer *)srv;
+    if (*upload_data_size > 0)
+    {
+        // the body may come in several chunks, respond only after the last one
+        if (!upload->too_large && upload->data.size() + *upload_data_size > max_body_size)
+        {
+            yuiWarning() << "Request body exceeds " << max_body_size << " bytes, discarding it" << std::endl;
+            upload->too_large = true;
+            std::string().swap(upload->data);
+        }
+
+        if (!upload->too_large)
+            upload->data.append(upload_data, *upload_data_size);
+
+        *upload_data_size = 0;
+        return MHD_YES;
+    }
 
-    // the basic auth is configured and failed
-    if ((!server->user().empty() || !server->passwd().empty()) && !authenticated(connection, server))
+    if (upload->too_large)
     {
-        struct MHD_Response *response = MHD_create_response_from_buffer(strlen(auth_error_body),
-            (void *) auth_error_body, MHD_RESPMEM_PERSISTENT);
+        struct MHD_Response *response = MHD_create_response_from_buffer(strlen(too_large_error_body),
+            (void *) too_large_error_body, MHD_RESPMEM_PERSISTENT);
         MHD_add_response_header(response, MHD_HTTP_HEADER_CONTENT_TYPE, "application/json");
-        return MHD_queue_basic_auth_fail_response(connection, "libyui realm", response);
+        MHD_RESULT ret = MHD_queue_response(connection, MHD_HTTP_PAYLOAD_TOO_LARGE, response);
+        MHD_destroy_response(response);
+        return ret;
     }
 
-    return server->handle(connection, url, method, upload_data, upload_data_size);
+    // the whole body is available now
+    std::string body;
+    body.swap(upload->data);
+    size_t body_size = body.size();
+
+    return server->handle(connection, url, method, body.c_str(), &body_size);
+}
+
+// callback for handling the HTTP request
+static MHD_RESULT
+requestHandler(void *srv,
+          struct MHD_Connection *connection,
+          const char *url,
+          const char *method,
+          const char *version,
+          const char *upload_data, size_t *upload_data_size, void **ptr)
+{
+    return handleRequest(srv, connection, url, method, upload_data, upload_data_size, ptr, true);
+}
+
+// callback for handling the HTTP request from the Unix socket, only the user
+// running the application can connect to it (see unix_socket()) so there is
+// no need to check the HTTP authentication
+static MHD_RESULT
+unixRequestHandler(void *srv,
+          struct MHD_Connection *connection,
+          const char *url,
+          const char *method,
+          const char *version,
+          const char *upload_data, size_t *upload_data_size, void **ptr)
+{
+    return handleRequest(srv, connection, url, method, upload_data, upload_data_size, ptr, false);
+}
+
+// callback called when the request is finished (or aborted),
+// release the collected request body
+static void requestCompleted(void *srv, struct MHD_Connection *connection,
+    void **ptr, enum MHD_RequestTerminationCode code)
+{
+    ((YHttpServer *)srv)->request_completed(connection);
+    delete (RequestBody *) *ptr;
+    *ptr = NULL;
 }
 
 // callback called when a new client connects to the HTTP server,
@@ -260,80 +358,204 @@ static MHD_RESULT onConnect(void *srv, const struct sockaddr *addr, socklen_t ad
         yuiMilestone() << "Received an IPv6 connection from " << buffer << std::endl;
     }
 
+    if (addr->sa_family == AF_UNIX) {
+        yuiMilestone() << "Received a Unix socket connection" << std::endl;
+    }
+
     // always continue processing the request
     return MHD_YES;
 }
 
+// check whether a Unix socket left on the disk is stale, i.e. nobody listens
+// on it anymore (the previous process crashed), a running server accepts
+// the connection and any other error is not safe to ignore either
+static bool stale_unix_socket(const struct sockaddr_un &addr)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return false;
+
+    bool stale = connect(fd, (const struct sockaddr *) &addr, sizeof(addr)) < 0
+        && errno == ECONNREFUSED;
+    close(fd);
+
+    return stale;
+}
+
+// create the listening Unix domain socket, returns -1 on error
+static int unix_socket(const std::string &path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(addr.sun_path)) {
+        yuiError() << "Unix socket path too long: " << path << std::endl;
+        return -1;
+    }
+
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    // remove a stale socket from a previous run, but nothing else
+    struct stat st;
+    if (lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            yuiError() << path << " exists and is not a socket" << std::endl;
+            return -1;
+        }
+
+        if (!stale_unix_socket(addr)) {
+            yuiError() << "Unix socket " << path << " is in use" << std::endl;
+            return -1;
+        }
+
+        unlink(path.c_str());
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        yuiError() << "Cannot create a Unix socket: " << strerror(errno) << std::endl;
+        return -1;
+    }
+
+    // allow only the current user to connect, the socket is not protected
+    // by the HTTP authentication; bind() creates the socket file with the
+    // mode of the socket (unlike umask() this does not affect other threads)
+    if (fchmod(fd, S_IRUSR | S_IWUSR) < 0
+        || bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0
+        || listen(fd, SOMAXCONN) < 0) {
+        yuiError() << "Cannot listen on Unix socket " << path << ": " << strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
 void YHttpServer::start()
 {
     mount("/", "GET", new YHttpRootHandler(), false);
     mount("/dialog", "GET", new YHttpDialogHandler());
     mount("/widgets", "GET", new YHttpWidgetsHandler());
     mount("/widgets", "POST", get_widget_action_handler());
+    mount("/batch", "POST", new YHttpBatchHandler(get_widget_action_handler()));
+    wait_handler = new YHttpWaitHandler();
+    mount("/wait", "GET", wait_handler);
     mount("/application", "GET", new YHttpAppHandler());
     mount("/version", "GET", new YHttpVersionHandler(), false);
 
-    bool remote = remote_access();
+    // the TCP servers, the Unix socket might be used alone
+    if (port_num() != 0)
+    {
+        bool remote = remote_access();
+
+        // setup the IPv4 server
+        sockaddr_in server_socket;
+        server_socket.sin_family = AF_INET;
+        server_socket.sin_port = htons(port_num());
+        server_socket.sin_addr.s_addr = listen_address_v4(remote);
+        server_v4 = MHD_start_daemon (
+                            // enable debugging output (on STDERR)
+                            MHD_USE_DEBUG |
+                            // allow delaying the GET /wait responses
+                            MHD_USE_SUSPEND_RESUME,
+                            // the port number to use
+                            port_num(),
+                            // handler for new connections
+                            &onConnect, this,
+                            // handler for processing requests
+                            &requestHandler, this,
+                            // allow or forbid reusing the socket for multiple processes
+                            MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
+                            // set the port and interface to listen to
+                            MHD_OPTION_SOCK_ADDR, &server_socket,
+                            // release the request data
+                            MHD_OPTION_NOTIFY_COMPLETED, &requestCompleted, this,
+                            // finish the argument list
+                            MHD_OPTION_END);
+
+        // setup the IPv6 server
+        sockaddr_in6 server_socket_v6;
+        server_socket_v6.sin6_family = AF_INET6;
+        server_socket_v6.sin6_port = htons(port_num());
+        server_socket_v6.sin6_addr = listen_address_v6(remote);
+        server_v6 = MHD_start_daemon (
+                            // enable debugging output (on STDERR)
+                            MHD_USE_DEBUG |
+                            // allow delaying the GET /wait responses
+                            MHD_USE_SUSPEND_RESUME |
+                            // use IPv6
+                            MHD_USE_IPv6,
+                            // the port number to use
+                            port_num(),
+                            // handler for new connections
+                            &onConnect, this,
+                            // handler for processing requests
+                            &requestHandler, this,
+                            // disable reusing the socket for multiple processes,
+                            // for security reasons allow only one process to use this port
+                            MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
+                            // set the port and interface to listen to
+                            MHD_OPTION_SOCK_ADDR, &server_socket_v6,
+                            // release the request data
+                            MHD_OPTION_NOTIFY_COMPLETED, &requestCompleted, this,
+                            // finish the argument list
+                            MHD_OPTION_END);
+
+        if (server_v4 == nullptr) {
+          std::cerr << "Cannot start the IPv4 HTTP server at port " << port_num() << std::endl;
+          yuiError() << "Cannot start the IPv4 HTTP server at port " << port_num() << std::endl;
+        }
+        else {
+            yuiWarning() << "Started REST API HTTP server (IPv4) at port " << port_num() << std::endl;
+        }
+
+        if (server_v6 == nullptr) {
+          std::cerr << "Cannot start the IPv6 HTTP server at port " << port_num() << std::endl;
+          yuiError() << "Cannot start the IPv6 HTTP server at port " << port_num() << std::endl;
+        }
+        else {
+            yuiWarning() << "Started REST API HTTP server (IPv6) at port " << port_num() << std::endl;
+        }
+    }
 
-    // setup the IPv4 server
-    sockaddr_in server_socket;
-    server_socket.sin_family = AF_INET;
-    server_socket.sin_port = htons(port_num());
-    server_socket.sin_addr.s_addr = listen_address_v4(remote);
-    server_v4 = MHD_start_daemon (
-                        // enable debugging output (on STDERR)
-                        MHD_USE_DEBUG,
-                        // the port number to use
-                        port_num(),
-                        // handler for new connections
-                        &onConnect, this,
-                        // handler for processing requests
-                        &requestHandler, this,
-                        // allow or forbid reusing the socket for multiple processes
-                        MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
-                        // set the port and interface to listen to
-                        MHD_OPTION_SOCK_ADDR, &server_socket,
-                        // finish the argument list
-                        MHD_OPTION_END);
+    // setup the Unix domain socket server for the local clients,
+    // it avoids the TCP overhead and the HTTP authentication
+    if (!socket_path().empty())
+    {
+        int fd = unix_socket(socket_path());
 
-    // setup the IPv6 server
-    sockaddr_in6 server_socket_v6;
-    server_socket_v6.sin6_family = AF_INET6;
-    server_socket_v6.sin6_port = htons(port_num());
-    server_socket_v6.sin6_addr = listen_address_v6(remote);
-    server_v6 = MHD_start_daemon (
+        if (fd >= 0)
+        {
+            server_unix = MHD_start_daemon (
                         // enable debugging output (on STDERR)
                         MHD_USE_DEBUG |
-                        // use IPv6
-                        MHD_USE_IPv6,
-                        // the port number to use
-                        port_num(),
+                        // allow delaying the GET /wait responses
+                        MHD_USE_SUSPEND_RESUME,
+                        // no port, the listening socket is passed below
+                        0,
                         // handler for new connections
                         &onConnect, this,
-                        // handler for processing requests
-                        &requestHandler, this,
-                        // disable reusing the socket for multiple processes,
-                        // for security reasons allow only one process to use this port
-                        MHD_OPTION_LISTENING_ADDRESS_REUSE, port_reuse(),
-                        // set the port and interface to listen to
-                        MHD_OPTION_SOCK_ADDR, &server_socket_v6,
+                        // handler for processing requests (without authentication)
+                        &unixRequestHandler, this,
+                        // use the Unix socket
+                        MHD_OPTION_LISTEN_SOCKET, fd,
+                        // release the request data
+                        MHD_OPTION_NOTIFY_COMPLETED, &requestCompleted, this,
                         // finish the argument list
                         MHD_OPTION_END);
 
-    if (server_v4 == nullptr) {
-      std::cerr << "Cannot start the IPv4 HTTP server at port " << port_num() << std::endl;
-      yuiError() << "Cannot start the IPv4 HTTP server at port " << port_num() << std::endl;
-    }
-    else {
-        yuiWarning() << "Started REST API HTTP server (IPv4) at port " << port_num() << std::endl;
-    }
-
-    if (server_v6 == nullptr) {
-      std::cerr << "Cannot start the IPv6 HTTP server at port " << port_num() << std::endl;
-      yuiError() << "Cannot start the IPv6 HTTP server at port " << port_num() << std::endl;
-    }
-    else {
-        yuiWarning() << "Started REST API HTTP server (IPv6) at port " << port_num() << std::endl;
+            if (server_unix == nullptr)
+                close(fd);
+        }
+
+        if (server_unix == nullptr) {
+          std::cerr << "Cannot start the HTTP server at Unix socket " << socket_path() << std::endl;
+          yuiError() << "Cannot start the HTTP server at Unix socket " << socket_path() << std::endl;
+        }
+        else {
+            yuiWarning() << "Started REST API HTTP server at Unix socket " << socket_path() << std::endl;
+        }
     }
     // FIXME: exit when no server available?
 }
@@ -344,9 +566,32 @@ bool YHttpServer::process_data()
     yuiMilestone() << "Processing HTTP server data..." << std::endl;
     if (server_v4) MHD_run(server_v4);
     if (server_v6) MHD_run(server_v6);
+    if (server_unix) MHD_run(server_unix);
     return redraw;
 }
 
+void YHttpServer::check_waits()
+{
+    // send the responses of the resumed requests
+    if (wait_handler && wait_handler->check())
+    {
+        if (server_v4) MHD_run(server_v4);
+        if (server_v6) MHD_run(server_v6);
+        if (server_unix) MHD_run(server_unix);
+    }
+}
+
+int YHttpServer::wait_timeout() const
+{
+    return wait_handler ? wait_handler->timeout() : -1;
+}
+
+void YHttpServer::request_completed(struct MHD_Connection* connection)
+{
+    if (wait_handler)
+        wait_handler->cancel(connection);
+}
+
 void YHttpServer::mount(std::string path, const std::string &method, YHttpHandler *handler, bool has_api_version)
 {
     if (has_api_version)
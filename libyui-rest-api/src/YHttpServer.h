@@ -23,6 +23,7 @@
 #include "YHttpMount.h"
 #include "YHttpHandler.h"
 #include "YHttpServerSockets.h"
+#include "YHttpWaitHandler.h"
 #include "YHttpWidgetsActionHandler.h"
 
 // environment variables
@@ -31,6 +32,7 @@
 #define YUI_AUTH_USER       "YUI_AUTH_USER"
 #define YUI_AUTH_PASSWD     "YUI_AUTH_PASSWD"
 #define YUI_REUSE_PORT      "YUI_REUSE_PORT"
+#define YUI_HTTP_SOCKET     "YUI_HTTP_SOCKET"
 
 #define YUI_API_VERSION     "v1"
 
@@ -43,7 +45,7 @@ public:
 
     static bool enabled()
     {
-        static bool enabled = port_num() != 0;
+        static bool enabled = port_num() != 0 || !socket_path().empty();
         return enabled;
     }
 
@@ -54,6 +56,12 @@ public:
 
     static int port_num();
 
+    /**
+     * The path of the Unix domain socket to listen on (in addition to the
+     * TCP port), empty if not configured
+     **/
+    static std::string socket_path();
+
     /**
      * Constructor to override widgets action handler. Is used in case there
      * are UI specific actions for the widget.
@@ -82,6 +90,25 @@ public:
      */
     YHttpServerSockets sockets();
 
+    /**
+     * Check the suspended GET /wait requests, the UI should call this
+     * whenever its event loop is idle (before waiting for input).
+     * This is cheap if nothing changed in the UI since the last call.
+     */
+    void check_waits();
+
+    /**
+     * Return the time (in milliseconds) until the next suspended GET /wait
+     * request expires or -1 if there is none. The UI event loop should call
+     * check_waits() again after that time even if there is no input.
+     */
+    int wait_timeout() const;
+
+    /**
+     * Release the request data of a finished or aborted request
+     */
+    void request_completed(struct MHD_Connection* connection);
+
     void mount(std::string path, const std::string &method, YHttpHandler *handler, bool has_api_version = true);
 
     MHD_RESULT handle(struct MHD_Connection* connection,
@@ -96,8 +123,11 @@ private:
 
     // dual stack support (for both IPv4 and IPv6)
     struct MHD_Daemon *server_v4, *server_v6;
+    // local clients
+    struct MHD_Daemon *server_unix;
     std::vector<YHttpMount> _mounts;
     bool redraw;
+    YHttpWaitHandler *wait_handler;
     static YHttpServer * _yserver;
     static YHttpWidgetsActionHandler * _widget_action_handler;
     // HTTP Basic Auth credentials
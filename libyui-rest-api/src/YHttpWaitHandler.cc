@@ -0,0 +1,227 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#include <microhttpd.h>
+#include <sstream>
+#include <stdlib.h>
+
+#define YUILogComponent "rest-api"
+#include <yui/YUILog.h>
+
+#include <yui/YDialog.h>
+#include <yui/YProperty.h>
+#include <yui/YWidget.h>
+
+#include "YJsonSerializer.h"
+#include "YWidgetFinder.h"
+#include "YHttpWaitHandler.h"
+
+// default time to wait for the condition (in milliseconds)
+#define DEFAULT_WAIT_TIMEOUT 10000
+
+
+// the property value as a string, empty if the widget does not have it
+static std::string property_value( YWidget * widget, const std::string & name )
+{
+    if ( !widget->propertySet().contains( name ) )
+        return "";
+
+    YPropertyValue value = widget->getProperty( name );
+
+    switch ( value.type() )
+    {
+        case YStringProperty:   return value.stringVal();
+        case YBoolProperty:     return value.boolVal() ? "true" : "false";
+        case YIntegerProperty:  return std::to_string( value.integerVal() );
+        default:                return "";
+    }
+}
+
+static const char * optional( const std::string & str )
+{
+    return str.empty() ? nullptr : str.c_str();
+}
+
+
+MHD_RESULT YHttpWaitHandler::handle(struct MHD_Connection* connection,
+    const char* url, const char* method, const char* upload_data,
+    size_t* upload_data_size, bool *redraw)
+{
+    // a resumed request has the response already prepared
+    if ( _waits.find( connection ) == _waits.end() )
+    {
+        Wait & wait = _waits[ connection ];
+        parse( connection, wait );
+
+        if ( !wait.finished )
+            evaluate( wait );
+
+        if ( !wait.finished )
+        {
+            yuiMilestone() << "Suspending the wait request" << std::endl;
+            MHD_suspend_connection( connection );
+            return MHD_YES;
+        }
+    }
+
+    return YHttpHandler::handle( connection, url, method, upload_data, upload_data_size, redraw );
+}
+
+void YHttpWaitHandler::process_request(struct MHD_Connection* connection,
+    const char* url, const char* method, const char* upload_data,
+    size_t* upload_data_size, std::ostream& body, int& error_code,
+    std::string& content_type, bool *redraw)
+{
+    auto it = _waits.find( connection );
+
+    if ( it == _waits.end() )
+    {
+        error_code = handle_error( body, "Unexpected wait request", MHD_HTTP_NOT_FOUND );
+    }
+    else
+    {
+        body << it->second.body;
+        error_code = it->second.error_code;
+        _waits.erase( it );
+    }
+
+    content_type = "application/json";
+}
+
+void YHttpWaitHandler::parse( struct MHD_Connection* connection, Wait & wait )
+{
+    const char* label    = MHD_lookup_connection_value( connection, MHD_GET_ARGUMENT_KIND, "label" );
+    const char* id       = MHD_lookup_connection_value( connection, MHD_GET_ARGUMENT_KIND, "id" );
+    const char* type     = MHD_lookup_connection_value( connection, MHD_GET_ARGUMENT_KIND, "type" );
+    const char* property = MHD_lookup_connection_value( connection, MHD_GET_ARGUMENT_KIND, "property" );
+    const char* value    = MHD_lookup_connection_value( connection, MHD_GET_ARGUMENT_KIND, "value" );
+    const char* timeout  = MHD_lookup_connection_value( connection, MHD_GET_ARGUMENT_KIND, "timeout" );
+
+    if ( label )    wait.label    = label;
+    if ( id )       wait.id       = id;
+    if ( type )     wait.type     = type;
+    if ( property ) wait.property = property;
+    if ( value )    wait.value    = value;
+
+    int timeout_ms = timeout ? atoi( timeout ) : DEFAULT_WAIT_TIMEOUT;
+    wait.deadline = Clock::now() + std::chrono::milliseconds( timeout_ms );
+
+    if ( wait.label.empty() && wait.id.empty() && wait.type.empty() )
+    {
+        std::ostringstream body;
+        wait.error_code = handle_error( body, "Missing widget filter (label, id or type)", MHD_HTTP_BAD_REQUEST );
+        wait.body = body.str();
+        wait.finished = true;
+    }
+}
+
+void YHttpWaitHandler::evaluate( Wait & wait )
+{
+    if ( !YDialog::topmostDialog( false ) )
+        return;
+
+    WidgetArray widgets = YWidgetFinder::find( optional( wait.label ), optional( wait.id ), optional( wait.type ) );
+    WidgetArray matching;
+
+    for ( YWidget *widget: widgets )
+    {
+        if ( wait.property.empty() || property_value( widget, wait.property ) == wait.value )
+            matching.push_back( widget );
+    }
+
+    if ( matching.empty() )
+        return;
+
+    // non recursive dump, like GET /widgets
+    std::ostringstream body;
+    YJsonSerializer::serialize( matching, body, false );
+
+    wait.body = body.str();
+    wait.error_code = MHD_HTTP_OK;
+    wait.finished = true;
+}
+
+void YHttpWaitHandler::expire( Wait & wait )
+{
+    std::ostringstream body;
+    wait.error_code = handle_error( body, "Timeout, the condition was not met", MHD_HTTP_REQUEST_TIMEOUT );
+    wait.body = body.str();
+    wait.finished = true;
+}
+
+bool YHttpWaitHandler::check()
+{
+    if ( _waits.empty() )
+        return false;
+
+    // the versions are unique over all dialogs, a different version
+    // also means a different topmost dialog
+    YDialog * dialog = YDialog::topmostDialog( false );
+    unsigned long version = dialog ? dialog->changeVersion() : 0;
+    bool changed = version != _last_version;
+    _last_version = version;
+
+    Clock::time_point now = Clock::now();
+    bool resumed = false;
+
+    for ( auto & it: _waits )
+    {
+        Wait & wait = it.second;
+
+        // already resumed, the server has not sent the response yet
+        if ( wait.finished )
+            continue;
+
+        if ( changed )
+            evaluate( wait );
+
+        if ( !wait.finished && now >= wait.deadline )
+            expire( wait );
+
+        if ( wait.finished )
+        {
+            yuiMilestone() << "Resuming the wait request, response code: " << wait.error_code << std::endl;
+            MHD_resume_connection( it.first );
+            resumed = true;
+        }
+    }
+
+    return resumed;
+}
+
+int YHttpWaitHandler::timeout() const
+{
+    int ret = -1;
+    Clock::time_point now = Clock::now();
+
+    for ( auto & it: _waits )
+    {
+        const Wait & wait = it.second;
+
+        if ( wait.finished )
+            continue;
+
+        int remaining = 0;
+
+        if ( wait.deadline > now )
+            remaining = std::chrono::duration_cast<std::chrono::milliseconds>( wait.deadline - now ).count() + 1;
+
+        if ( ret < 0 || remaining < ret )
+            ret = remaining;
+    }
+
+    return ret;
+}
@@ -0,0 +1,113 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+#ifndef YHttpWaitHandler_h
+#define YHttpWaitHandler_h
+
+#include <chrono>
+#include <map>
+#include <string>
+
+#include "YHttpHandler.h"
+
+/**
+ * Handler for GET /wait: Wait until a widget matching the request
+ * parameters exists (and optionally has a property with the requested
+ * value) or until a timeout expires.
+ *
+ * A request that cannot be answered immediately is suspended. The UI event
+ * loop calls check() whenever it is idle; the conditions are evaluated
+ * again only if the topmost dialog changed since the last check (see
+ * YDialog::changeVersion()), so waiting clients do not cost anything while
+ * the UI does not change.
+ **/
+class YHttpWaitHandler : public YHttpHandler
+{
+
+public:
+
+    YHttpWaitHandler() : _last_version( 0 ) {}
+
+    virtual ~YHttpWaitHandler() {}
+
+    virtual MHD_RESULT handle(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, bool *redraw = nullptr);
+
+    /**
+     * Evaluate the conditions of the suspended requests if the UI changed
+     * since the last call and finish the expired ones. Return 'true' if any
+     * request was resumed, the server needs to run to send the response.
+     **/
+    bool check();
+
+    /**
+     * Return the time in milliseconds until the next suspended request
+     * expires or -1 if there is none.
+     **/
+    int timeout() const;
+
+    /**
+     * Forget the suspended request of a closed connection.
+     **/
+    void cancel( struct MHD_Connection* connection ) { _waits.erase( connection ); }
+
+protected:
+
+    virtual void process_request(struct MHD_Connection* connection,
+        const char* url, const char* method, const char* upload_data,
+        size_t* upload_data_size, std::ostream& body, int& error_code,
+        std::string& content_type, bool *redraw);
+
+private:
+
+    typedef std::chrono::steady_clock Clock;
+
+    struct Wait
+    {
+        std::string label;
+        std::string id;
+        std::string type;
+        std::string property;
+        std::string value;
+        Clock::time_point deadline;
+
+        // the response, valid when 'finished' is set
+        bool finished = false;
+        int error_code = 0;
+        std::string body;
+    };
+
+    /**
+     * Read the condition from the request parameters.
+     **/
+    void parse( struct MHD_Connection* connection, Wait & wait );
+
+    /**
+     * Check the condition and store the response if it is met.
+     **/
+    void evaluate( Wait & wait );
+
+    /**
+     * Store the timeout error response.
+     **/
+    void expire( Wait & wait );
+
+    std::map<struct MHD_Connection*, Wait> _waits;
+    unsigned long _last_version;
+};
+
+#endif // YHttpWaitHandler_h
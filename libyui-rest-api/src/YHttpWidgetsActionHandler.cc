@@ -15,6 +15,7 @@
 */
 
 #include <codecvt>
+#include <json/json.h>
 #include <vector>
 #include <sstream>
 #include <cstdlib>
@@ -48,7 +49,7 @@ void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connectio
 {
     if ( YDialog::topmostDialog(false) )
     {
-        WidgetArray widgets;
+        YWidget *widget = nullptr;
 
         content_type = "application/json";
 
@@ -56,34 +57,14 @@ void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connectio
         const char* id = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "id");
         const char* type = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "type");
 
-        if ( label || id || type )
-        {
-            widgets = YWidgetFinder::find(label, id, type);
-        }
-        else
-        {
-            body << "{ \"error\" : \"No search criteria provided\" }" << std::endl;
-            error_code = MHD_HTTP_NOT_FOUND;
-            return;
-        }
+        error_code = find_widget(label, id, type, widget, body);
 
-        if ( widgets.empty() )
-        {
-            body << "{ \"error\" : \"Widget not found\" }" << std::endl;
-            error_code = MHD_HTTP_NOT_FOUND;
+        if ( error_code != MHD_HTTP_OK )
             return;
-        }
 
         if ( const char* action = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "action") )
         {
-            if( widgets.size() != 1 )
-            {
-                body << "{ \"error\" : \"Multiple widgets found to act on, try using multicriteria search (label+id+type)\" }" << std::endl;
-                error_code = MHD_HTTP_NOT_FOUND;
-                return;
-            }
-
-            error_code = do_action(widgets[0], action, connection, body);
+            error_code = do_action(widget, action, query_params(connection), body);
 
             // the action possibly changed something in the UI, signalize redraw needed
             if ( redraw && error_code == MHD_HTTP_OK )
@@ -101,7 +82,136 @@ void YHttpWidgetsActionHandler::process_request(struct MHD_Connection* connectio
     }
 }
 
-int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &action, struct MHD_Connection *connection, std::ostream& body)
+int YHttpWidgetsActionHandler::do_actions(const Json::Value &actions, Json::Value &results)
+{
+    results = Json::Value(Json::arrayValue);
+
+    if ( !actions.isArray() )
+    {
+        Json::Value result;
+        result["status"] = MHD_HTTP_BAD_REQUEST;
+        result["error"] = "Expected a JSON array of actions";
+        results.append(result);
+        return MHD_HTTP_BAD_REQUEST;
+    }
+
+    for ( const Json::Value &item: actions )
+    {
+        std::ostringstream body;
+        int error_code;
+
+        if ( !YDialog::topmostDialog(false) )
+        {
+            body << "{ \"error\" : \"No dialog is open\" }" << std::endl;
+            error_code = MHD_HTTP_NOT_FOUND;
+        }
+        else if ( !item.isObject() || !item.isMember("action") )
+        {
+            body << "{ \"error\" : \"Missing action parameter\" }" << std::endl;
+            error_code = MHD_HTTP_NOT_FOUND;
+        }
+        else
+        {
+            // all other members are the parameters of the action
+            Params params;
+            error_code = MHD_HTTP_OK;
+
+            for ( const std::string &name: item.getMemberNames() )
+            {
+                // asString() would throw for arrays and objects
+                if ( !item[name].isConvertibleTo(Json::stringValue) )
+                {
+                    body << "{ \"error\" : \"Parameter values must be strings or numbers\" }" << std::endl;
+                    error_code = MHD_HTTP_BAD_REQUEST;
+                    break;
+                }
+
+                params[name] = item[name].asString();
+            }
+
+            YWidget *widget = nullptr;
+
+            if ( error_code == MHD_HTTP_OK )
+                error_code = find_widget(param(params, "label"), param(params, "id"), param(params, "type"), widget, body);
+
+            if ( error_code == MHD_HTTP_OK )
+                error_code = do_action(widget, params["action"], params, body);
+        }
+
+        Json::Value result;
+        result["status"] = error_code;
+
+        // pass the error message of the action
+        Json::Value error;
+        std::istringstream error_stream(body.str());
+
+        if ( !body.str().empty() && Json::parseFromStream(Json::CharReaderBuilder(), error_stream, &error, nullptr)
+             && error.isObject() && error.isMember("error") )
+        {
+            result["error"] = error["error"];
+        }
+
+        results.append(result);
+
+        // the following actions most likely depend on this one
+        if ( error_code != MHD_HTTP_OK )
+            return error_code;
+    }
+
+    return MHD_HTTP_OK;
+}
+
+int YHttpWidgetsActionHandler::find_widget(const char* label, const char* id, const char* type, YWidget *&widget, std::ostream& body)
+{
+    if ( !label && !id && !type )
+    {
+        body << "{ \"error\" : \"No search criteria provided\" }" << std::endl;
+        return MHD_HTTP_NOT_FOUND;
+    }
+
+    WidgetArray widgets = YWidgetFinder::find(label, id, type);
+
+    if ( widgets.empty() )
+    {
+        body << "{ \"error\" : \"Widget not found\" }" << std::endl;
+        return MHD_HTTP_NOT_FOUND;
+    }
+
+    if( widgets.size() != 1 )
+    {
+        body << "{ \"error\" : \"Multiple widgets found to act on, try using multicriteria search (label+id+type)\" }" << std::endl;
+        return MHD_HTTP_NOT_FOUND;
+    }
+
+    widget = widgets[0];
+    return MHD_HTTP_OK;
+}
+
+const char* YHttpWidgetsActionHandler::param(const Params &params, const std::string &name)
+{
+    Params::const_iterator it = params.find(name);
+    return it == params.end() ? nullptr : it->second.c_str();
+}
+
+// callback for collecting the URL query parameters
+static MHD_RESULT add_param(void *cls, enum MHD_ValueKind kind, const char *key, const char *value)
+{
+    std::map<std::string, std::string> *params = (std::map<std::string, std::string> *) cls;
+
+    if ( key )
+        (*params)[key] = value ? value : "";
+
+    return MHD_YES;
+}
+
+YHttpWidgetsActionHandler::Params YHttpWidgetsActionHandler::query_params(struct MHD_Connection* connection)
+{
+    Params params;
+    MHD_get_connection_values(connection, MHD_GET_ARGUMENT_KIND, &add_param, &params);
+    return params;
+}
+
+int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &action, const Params &params, std::ostream& body)
 {
 
     // TODO improve this, maybe use better names for the actions...
@@ -149,7 +259,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = param(params, "value") )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -195,7 +305,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = param(params, "value") )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -243,7 +353,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else
         {
             std::string value;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+            if ( const char* val = param(params, "value") )
                 value = val;
 
             if( YItemSelector* selector = dynamic_cast<YItemSelector*>(widget) )
@@ -269,7 +379,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
     else if ( action == "enter_text" )
     {
         std::string value;
-        if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value") )
+        if ( const char* val = param(params, "value") )
             value = val;
 
         if ( dynamic_cast<YInputField*>(widget) )
@@ -339,7 +449,7 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
     else if ( action == "select" )
     {
         std::string value;
-        if (const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "value"))
+        if (const char* val = param(params, "value"))
             value = val;
         if ( dynamic_cast<YComboBox*>(widget) )
         {
@@ -362,11 +472,11 @@ int YHttpWidgetsActionHandler::do_action(YWidget *widget, const std::string &act
         else if( auto tbl = dynamic_cast<YTable*>(widget) )
         {
             int row_id = -1;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "row") )
+            if ( const char* val = param(params, "row") )
                 row_id = atoi(val);
 
             int column_id = 0;
-            if ( const char* val = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "column") )
+            if ( const char* val = param(params, "column") )
                 column_id = atoi(val);
 
             return action_handler<YTable>( widget, body, get_table_handler()->get_handler( tbl, value, column_id, row_id) );
@@ -19,6 +19,7 @@
 
 #include <iostream>
 #include <functional>
+#include <map>
 #include <microhttpd.h>
 #include <sstream>
 #include <boost/algorithm/string.hpp>
@@ -43,6 +44,10 @@
 
 #include "YHttpHandler.h"
 
+namespace Json {
+    class Value;
+}
+
 
 class YHttpWidgetsActionHandler : public YHttpHandler
 {
@@ -52,14 +57,52 @@ public:
     YHttpWidgetsActionHandler() {};
     virtual ~YHttpWidgetsActionHandler() {};
 
+    /**
+     * Execute several actions in the given order, like a sequence of
+     * POST /widgets requests, but all of them in the same call.
+     * Stops at the first action that fails.
+     * @param actions JSON array, each element is an object with the widget
+     *     filter ("id", "label", "type"), the "action" and its parameters
+     *     ("value", "row", "column")
+     * @param results JSON array, gets one object for each executed action
+     *     with the HTTP "status" of the action and possibly an "error"
+     * @return HTTP status code, MHD_HTTP_OK if all actions succeeded,
+     *     otherwise the status of the failed action
+     */
+    int do_actions( const Json::Value &actions, Json::Value &results );
+
 protected:
 
+    /**
+     * Action parameters ("value", "row", "column"), from the URL query of a
+     * single request or from an element of a batch request.
+     **/
+    typedef std::map<std::string, std::string> Params;
+
     virtual void process_request(struct MHD_Connection* connection,
         const char* url, const char* method, const char* upload_data,
         size_t* upload_data_size, std::ostream& body, int& error_code,
         std::string& content_type, bool *redraw);
 
-    int do_action( YWidget *widget, const std::string &action, struct MHD_Connection *connection, std::ostream& body );
+    int do_action( YWidget *widget, const std::string &action, const Params &params, std::ostream& body );
+
+    /**
+     * Find the widget to act on.
+     * @param widget set to the found widget
+     * @param body HTTP response body stream for the error message
+     * @return HTTP status code
+     */
+    int find_widget( const char* label, const char* id, const char* type, YWidget *&widget, std::ostream& body );
+
+    /**
+     * Return the value of parameter 'name' or nullptr if it is missing.
+     **/
+    static const char* param( const Params &params, const std::string &name );
+
+    /**
+     * Return all parameters of the URL query.
+     **/
+    static Params query_params( struct MHD_Connection* connection );
 
     /**
      * Define widgets handlers to override in case need to implement
@@ -93,6 +136,10 @@ protected:
                 }
                 if ( handler_func )
                     handler_func(w);
+
+                // not all UI specific code calls the libyui setters,
+                // make sure the change shows up in the dialog change version
+                widget->markChanged();
             }
             // some widgets may throw an exception when setting invalid values
             catch (const YUIException &e)
@@ -49,7 +49,7 @@ void YHttpWidgetsHandler::process_request(struct MHD_Connection* connection,
         }
         else {
             // non recursive dump
-            YJsonSerializer::serialize(widgets, body, false);
+            YJsonSerializer::serialize(widgets, body, false, item_options(connection));
             error_code = MHD_HTTP_OK;
         }
     }
@@ -60,3 +60,9 @@ void YHttpWidgetsHandler::process_request(struct MHD_Connection* connection,
 
     content_type = "application/json";
 }
+
+std::string YHttpWidgetsHandler::etag(struct MHD_Connection* connection)
+{
+    auto dialog = YDialog::topmostDialog(false);
+    return dialog ? "\"" + std::to_string(dialog->changeVersion()) + "\"" : "";
+}
@@ -33,6 +33,8 @@ protected:
         const char* url, const char* method, const char* upload_data,
         size_t* upload_data_size, std::ostream& body, int& error_code,
         std::string& content_type, bool *redraw);
+
+    virtual std::string etag(struct MHD_Connection* connection);
 };
 
 #endif // YHttpWidgetsHandler_h
@@ -14,6 +14,7 @@
   Floor, Boston, MA 02110-1301 USA
 */
 
+#include <algorithm>
 #include <json/json.h>
 
 #include <yui/YBarGraph.h>
@@ -45,14 +46,14 @@
 
 static void serialize_widget_properties(YWidget *widget, Json::Value &json);
 static void serialize_widget_data(YWidget *widget, Json::Value &json);
-static void serialize_widget_specific_data(YWidget *widget, Json::Value &json);
+static void serialize_widget_specific_data(YWidget *widget, Json::Value &json, const YJsonItemOptions &options);
 
-Json::Value serialize_rec(YWidget *w, bool recursive = true) {
+Json::Value serialize_rec(YWidget *w, bool recursive, const YJsonItemOptions &options) {
     Json::Value ret;
 
     serialize_widget_properties(w, ret);
     serialize_widget_data(w, ret);
-    serialize_widget_specific_data(w, ret);
+    serialize_widget_specific_data(w, ret, options);
 
     if (recursive && w->hasChildren()) {
         Json::Value widgets;
@@ -61,7 +62,7 @@ Json::Value serialize_rec(YWidget *w, bool recursive = true) {
         {
             if (*it)
             {
-                Json::Value widget = serialize_rec(*it);
+                Json::Value widget = serialize_rec(*it, true, options);
                 widgets.append(widget);
             }
         }
@@ -82,18 +83,23 @@ void YJsonSerializer::save(const Json::Value &json, std::ostream &output)
     writer->write(json, &output);
 }
 
-void YJsonSerializer::serialize(YWidget *w, std::ostream &output, bool recursive) {
+Json::Value YJsonSerializer::json(YWidget *w, bool recursive, const YJsonItemOptions &options) {
+    return serialize_rec(w, recursive, options);
+}
+
+void YJsonSerializer::serialize(YWidget *w, std::ostream &output, bool recursive, const YJsonItemOptions &options) {
     if (!w) return;
-    Json::Value json = serialize_rec(w, recursive);
+    Json::Value json = serialize_rec(w, recursive, options);
     save(json, output);
 }
 
-void YJsonSerializer::serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive) {
+void YJsonSerializer::serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive,
+    const YJsonItemOptions &options) {
     Json::Value array;
 
     for(YWidget *widget: widgets)
     {
-        Json::Value json = serialize_rec(widget, recursive);
+        Json::Value json = serialize_rec(widget, recursive, options);
         array.append(json);
     }
 
@@ -167,7 +173,61 @@ void serialize_widget_data(YWidget *widget, Json::Value &json) {
 
 namespace
 {
-    void add_items_rec(Json::Value &jitem, const YItem *yitem)
+    // compare labels ignoring the keyboard shortcut marker
+    bool label_equals(std::string label, const std::string &wanted)
+    {
+        label.erase(std::remove(label.begin(), label.end(), '&'), label.end());
+        return label == wanted;
+    }
+
+    // does the item itself match the filters?
+    bool item_matches_self(const YItem *yitem, const YJsonItemOptions &options)
+    {
+        if (options.selected_only && !yitem->selected())
+            return false;
+
+        if (options.label.empty())
+            return true;
+
+        if (auto tabitem = dynamic_cast<const YTableItem*>(yitem))
+        {
+            return std::any_of(tabitem->cellsBegin(), tabitem->cellsEnd(), [&](const YTableCell *ycell)
+            {
+                return label_equals(ycell->label(), options.label);
+            });
+        }
+
+        return label_equals(yitem->label(), options.label);
+    }
+
+    // does the item or any of its children match the filters?
+    bool item_matches(const YItem *yitem, const YJsonItemOptions &options)
+    {
+        if (!options.filtered() || item_matches_self(yitem, options))
+            return true;
+
+        return std::any_of(yitem->childrenBegin(), yitem->childrenEnd(), [&](const YItem *ychild)
+        {
+            return item_matches(ychild, options);
+        });
+    }
+
+    void add_cell(Json::Value &icons, Json::Value &labels, bool &no_icon, const YTableCell *ycell)
+    {
+        // a missing cell in a projected column
+        if (!ycell)
+        {
+            icons.append("");
+            labels.append("");
+            return;
+        }
+
+        no_icon &= ycell->iconName().empty();
+        icons.append(ycell->iconName());
+        labels.append(ycell->label());
+    }
+
+    void add_items_rec(Json::Value &jitem, const YItem *yitem, const YJsonItemOptions &options)
     {
         if (yitem->selected())
             jitem["selected"] = true;
@@ -178,12 +238,20 @@ namespace
             Json::Value icons, labels;
             // add icons only if not empty
             bool no_icon = true;
-            std::for_each(tabitem->cellsBegin(), tabitem->cellsEnd(), [&](const YTableCell *ycell)
+
+            if (options.columns.empty())
             {
-                no_icon &= ycell->iconName().empty();
-                icons.append(ycell->iconName());
-                labels.append(ycell->label());
-            });
+                std::for_each(tabitem->cellsBegin(), tabitem->cellsEnd(), [&](const YTableCell *ycell)
+                {
+                    add_cell(icons, labels, no_icon, ycell);
+                });
+            }
+            else
+            {
+                for (int column: options.columns)
+                    add_cell(icons, labels, no_icon, tabitem->cell(column));
+            }
+
             if (!no_icon)
                 jitem["icons"] = icons;
 
@@ -209,17 +277,80 @@ namespace
             // recursively add the children
             std::for_each(yitem->childrenBegin(), yitem->childrenEnd(), [&](const YItem *ychild)
             {
+                if (!item_matches(ychild, options))
+                    return;
+
                 Json::Value child;
-                add_items_rec(child, ychild);
+                add_items_rec(child, ychild, options);
                 children.append(child);
             });
 
-            jitem["children"] = children;
+            if (!children.empty())
+                jitem["children"] = children;
+        }
+    }
+
+    // add the toplevel items matching the options
+    void add_items(Json::Value &json, YSelectionWidget *selection, const YJsonItemOptions &options)
+    {
+        Json::Value items;
+        YItemConstIterator it = selection->itemsBegin();
+        int matched = 0;
+
+        // without filters the skipped items do not need to be checked at all
+        if (!options.filtered())
+        {
+            matched = std::min(options.offset, selection->itemsCount());
+            it += matched;
+        }
+
+        for (; it != selection->itemsEnd(); ++it)
+        {
+            if (!item_matches(*it, options))
+                continue;
+
+            if (matched++ < options.offset)
+                continue;
+
+            if (options.limit >= 0 && (int) items.size() >= options.limit)
+            {
+                // the number of matching items is not needed without filters
+                if (!options.filtered())
+                    break;
+
+                continue;
+            }
+
+            Json::Value item;
+            add_items_rec(item, *it, options);
+            items.append(item);
+        }
+
+        json["items"] = items;
+
+        if (!options.all())
+        {
+            json["items_offset"] = options.offset;
+            json["items_matched"] = options.filtered() ? matched : selection->itemsCount();
         }
     }
+
+    // the indexes of the serialized table columns
+    std::vector<int> table_columns(YTable *table, const YJsonItemOptions &options)
+    {
+        if (!options.columns.empty())
+            return options.columns;
+
+        std::vector<int> columns;
+
+        for (int idx = 0; idx < table->columns(); ++idx)
+            columns.push_back(idx);
+
+        return columns;
+    }
 }
 // widget specific data
-static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
+static void serialize_widget_specific_data(YWidget *widget, Json::Value &json, const YJsonItemOptions &options) {
 
     // check all classes, some widgets might be derived from others
     // TODO: group the base classes and the final classes
@@ -357,15 +488,7 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
         json["items_count"] = selection->itemsCount();
         json["icon_base_path"] = selection->iconBasePath();
 
-        Json::Value items;
-        std::for_each(selection->itemsBegin(), selection->itemsEnd(), [&](const YItem *yitem)
-        {
-            Json::Value item;
-            add_items_rec(item, yitem);
-            items.append(item);
-        });
-
-        json["items"] = items;
+        add_items(json, selection, options);
     }
 
     if (auto progress = dynamic_cast<YProgressBar*>(widget))
@@ -375,15 +498,17 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
 
     if (auto tb = dynamic_cast<YTable*>(widget))
     {
+        std::vector<int> columns = table_columns(tb, options);
+
         Json::Value header;
-        for ( auto idx = 0; idx < tb->columns(); ++idx )
+        for ( auto idx: columns )
         {
             header.append(tb->header(idx));
         }
         json["header"] = header;
 
         Json::Value alignment;
-        for ( auto idx = 0; idx < tb->columns(); ++idx )
+        for ( auto idx: columns )
         {
             std::string alignment_str;
             switch (tb->alignment(idx))
@@ -406,6 +531,14 @@ static void serialize_widget_specific_data(YWidget *widget, Json::Value &json) {
         json["alignment"] = alignment;
 
         json["columns"] = tb->columns();
+
+        if (!options.columns.empty())
+        {
+            Json::Value indexes;
+            for ( auto idx: columns )
+                indexes.append(idx);
+            json["column_indexes"] = indexes;
+        }
         json["immediate_mode"] = tb->immediateMode();
         json["keep_sorting"] = tb->keepSorting();
         json["hasMultiSelection"] = tb->hasMultiSelection();
@@ -18,6 +18,7 @@
 #define YJsonSerializer_h
 
 #include <iostream>
+#include <string>
 #include <vector>
 
 class YWidget;
@@ -26,16 +27,45 @@ namespace Json {
     class Value;
 }
 
+// which items of the selection widgets (tables, trees, lists...) to serialize,
+// the filters are evaluated while walking the items, the skipped items
+// are not serialized at all
+struct YJsonItemOptions
+{
+    // skip the first matching toplevel items
+    int offset = 0;
+    // the maximum number of toplevel items, -1 = all
+    int limit = -1;
+    // serialize only these table columns (in this order), empty = all
+    std::vector<int> columns;
+    // only the items with this label (in any table column)
+    std::string label;
+    // only the selected items
+    bool selected_only = false;
+
+    // is there any filter which needs to check the item contents?
+    bool filtered() const { return !label.empty() || selected_only; }
+
+    // are all items serialized?
+    bool all() const { return !filtered() && offset == 0 && limit < 0; }
+};
+
 class YJsonSerializer
 {
 
 public:
 
     // serialize one widget (by default recursively with all children)
-    static void serialize(YWidget *, std::ostream &output, bool recursive = true);
+    static void serialize(YWidget *, std::ostream &output, bool recursive = true,
+        const YJsonItemOptions &options = YJsonItemOptions());
 
     // serialize widget array (by default recursively with all children)
-    static void serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive = true);
+    static void serialize(const std::vector<YWidget*> &widgets, std::ostream &output, bool recursive = true,
+        const YJsonItemOptions &options = YJsonItemOptions());
+
+    // convert one widget to a JSON value (by default recursively with all children)
+    static Json::Value json(YWidget *, bool recursive = true,
+        const YJsonItemOptions &options = YJsonItemOptions());
 
     // save the JSON value as a text into the output stream
     static void save(const Json::Value &json, std::ostream &output);
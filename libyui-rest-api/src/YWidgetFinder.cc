@@ -79,6 +79,15 @@ WidgetArray YWidgetFinder::all()
     return ret;
 }
 
+WidgetArray YWidgetFinder::changed_since(unsigned long version)
+{
+    WidgetArray ret;
+    find_widgets(YDialog::topmostDialog(), ret, [version] (YWidget *w) {
+        return w->changeVersion() > version;
+    } );
+    return ret;
+}
+
 void find_widgets(YWidget *w, WidgetArray &array, std::function<bool (YWidget*)> filter_func) {
     if ( !w )
         return;
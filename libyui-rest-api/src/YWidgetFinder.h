@@ -40,6 +40,9 @@ public:
 
     static WidgetArray all();
 
+    // widgets of the topmost dialog changed after the dialog change version
+    static WidgetArray changed_since(unsigned long version);
+
 };
 
 #endif // YWidgetFinder_h
@@ -0,0 +1,154 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+  SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// Performance stress test for Graph: Render a synthetic graph with many nodes
+//
+// The graph is a random-ish DAG written to a temporary .dot file. Layouting
+// is done in a background thread; the UI should remain responsive meanwhile,
+// and zooming out should switch to the simplified level-of-detail rendering.
+// The layout and rendering times are written to the log.
+//
+// Compile with:
+//
+//     g++ -I/usr/include/yui -lyui Graph-many-nodes.cc -o Graph-many-nodes
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#define YUILogComponent "example"
+#include <yui/YUILog.h>
+
+#include <yui/YUI.h>
+#include <yui/YWidgetFactory.h>
+#include <yui/YOptionalWidgetFactory.h>
+#include <yui/YDialog.h>
+#include <yui/YLayoutBox.h>
+#include <yui/YGraph.h>
+#include <yui/YLabel.h>
+#include <yui/YPushButton.h>
+#include <yui/YAlignment.h>
+#include <yui/YEvent.h>
+
+#define NODE_COUNT	20000
+#define EDGES_PER_NODE	2
+#define DOT_FILE	"/tmp/libyui-graph-many-nodes.dot"
+
+
+bool writeDotFile( const char * filename, int nodeCount )
+{
+    FILE * file = fopen( filename, "w" );
+
+    if ( ! file )
+	return false;
+
+    srand( 42 ); // Make the graph the same each time
+
+    fprintf( file, "digraph many_nodes {\n" );
+    fprintf( file, "  node [shape=box, style=filled, fillcolor=lightgray];\n" );
+
+    for ( int i = 1; i < nodeCount; i++ )
+    {
+	for ( int j = 0; j < EDGES_PER_NODE; j++ )
+	    fprintf( file, "  \"pkg-%05d\" -> \"pkg-%05d\";\n", rand() % i, i );
+    }
+
+    fprintf( file, "}\n" );
+    fclose( file );
+
+    return true;
+}
+
+
+int main( int argc, char **argv )
+{
+    YUILog::setLogFileName( "/tmp/libyui-examples.log" );
+    YUILog::enableDebugLogging();
+
+    if ( ! YUI::optionalWidgetFactory()->hasGraph() )
+    {
+	yuiError() << "This UI does not support the Graph widget" << std::endl;
+	return 1;
+    }
+
+    yuiMilestone() << "Writing " << NODE_COUNT << " nodes to " << DOT_FILE << std::endl;
+
+    if ( ! writeDotFile( DOT_FILE, NODE_COUNT ) )
+    {
+	yuiError() << "Can't write " << DOT_FILE << std::endl;
+	return 1;
+    }
+
+
+    //
+    // Create and open dialog
+    //
+
+    YDialog    * dialog  = YUI::widgetFactory()->createMainDialog();
+    YLayoutBox * vbox    = YUI::widgetFactory()->createVBox( dialog );
+
+    YUI::widgetFactory()->createLabel( vbox, "Zoom with +/- or the mouse wheel" );
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    YGraph * graph = YUI::optionalWidgetFactory()->createGraph( vbox, DOT_FILE, "dot" );
+    graph->setStretchable( YD_HORIZ, true );
+    graph->setStretchable( YD_VERT,  true );
+
+    long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
+	( std::chrono::steady_clock::now() - startTime ).count();
+
+    yuiMilestone() << "Graph widget created after " << elapsed << " ms" << std::endl;
+
+    YAlignment  * rightAlignment = YUI::widgetFactory()->createRight( vbox );
+    YPushButton * closeButton    = YUI::widgetFactory()->createPushButton( rightAlignment, "&Close" );
+
+
+    //
+    // Event loop
+    //
+
+    while ( true )
+    {
+	YEvent * event = dialog->waitForEvent();
+
+	if ( event )
+	{
+	    if ( event->eventType() == YEvent::CancelEvent ) // window manager "close window" button
+		break; // leave event loop
+
+	    if ( event->widget() == closeButton )
+		break; // leave event loop
+	}
+    }
+
+
+    //
+    // Clean up
+    //
+
+    dialog->destroy();
+    remove( DOT_FILE );
+}
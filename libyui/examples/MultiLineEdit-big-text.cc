@@ -0,0 +1,159 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+  SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// Performance stress test for MultiLineEdit: Edit a 5 MB text
+//
+// "Load" sets a generated 5 MB config file as the value, "Value" reads the
+// value back twice (the second read should be free if nothing was edited in
+// between). Type into the text (or replay a recorded macro with
+// YUI_MACRO_PLAY) to measure editing. The times are shown in the dialog and
+// written to the log.
+//
+// Compile with:
+//
+//     g++ -I/usr/include/yui -lyui MultiLineEdit-big-text.cc -o MultiLineEdit-big-text
+
+
+#include <stdio.h>
+#include <chrono>
+#include <string>
+
+#define YUILogComponent "example"
+#include <yui/YUILog.h>
+
+#include <yui/YUI.h>
+#include <yui/YWidgetFactory.h>
+#include <yui/YDialog.h>
+#include <yui/YLayoutBox.h>
+#include <yui/YMultiLineEdit.h>
+#include <yui/YLabel.h>
+#include <yui/YPushButton.h>
+#include <yui/YAlignment.h>
+#include <yui/YEvent.h>
+
+#define TEXT_SIZE	( 5 * 1024 * 1024 )
+
+typedef std::chrono::steady_clock Clock;
+
+
+std::string bigText()
+{
+    std::string text;
+    text.reserve( TEXT_SIZE + 100 );
+
+    for ( int i = 1; text.size() < TEXT_SIZE; i++ )
+    {
+	char line[100];
+	sprintf( line, "# Section %06d\noption_%06d = \"some value with a few words\"\n\n", i, i );
+	text += line;
+    }
+
+    return text;
+}
+
+
+long millisecSince( Clock::time_point start )
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>( Clock::now() - start ).count();
+}
+
+
+int main( int argc, char **argv )
+{
+    YUILog::setLogFileName( "/tmp/libyui-examples.log" );
+    YUILog::enableDebugLogging();
+
+    //
+    // Create and open dialog
+    //
+
+    YDialog    * dialog  = YUI::widgetFactory()->createPopupDialog();
+    YAlignment * mbox    = YUI::widgetFactory()->createMarginBox( dialog, 1, 0.4 );
+    YLayoutBox * vbox    = YUI::widgetFactory()->createVBox( mbox );
+    YAlignment * minSize = YUI::widgetFactory()->createMinSize( vbox, 60, 15 ); // minWidth, minHeight
+
+    YMultiLineEdit * edit = YUI::widgetFactory()->createMultiLineEdit( minSize, "&Text" );
+
+    YLabel * timeField = YUI::widgetFactory()->createOutputField( vbox, "" );
+    timeField->setStretchable( YD_HORIZ, true );
+
+    YLayoutBox  * buttonBox   = YUI::widgetFactory()->createHBox( vbox );
+    YPushButton * loadButton  = YUI::widgetFactory()->createPushButton( buttonBox, "&Load" );
+    YPushButton * valueButton = YUI::widgetFactory()->createPushButton( buttonBox, "&Value" );
+    YPushButton * closeButton = YUI::widgetFactory()->createPushButton( buttonBox, "&Close" );
+
+    std::string text = bigText();
+
+
+    //
+    // Event loop
+    //
+
+    while ( true )
+    {
+	YEvent * event = dialog->waitForEvent();
+
+	if ( event )
+	{
+	    if ( event->eventType() == YEvent::CancelEvent ) // window manager "close window" button
+		break; // leave event loop
+
+	    if ( event->widget() == closeButton )
+		break; // leave event loop
+	    else if ( event->widget() == loadButton )
+	    {
+		Clock::time_point start = Clock::now();
+		edit->setValue( text );
+		long elapsed = millisecSince( start );
+
+		std::string msg = "setValue( " + std::to_string( text.size() ) + " bytes ): "
+		    + std::to_string( elapsed ) + " ms";
+		yuiMilestone() << msg << std::endl;
+		timeField->setValue( msg );
+	    }
+	    else if ( event->widget() == valueButton )
+	    {
+		Clock::time_point start = Clock::now();
+		std::string value = edit->value();
+		long first = millisecSince( start );
+
+		start = Clock::now();
+		value = edit->value();
+		long second = millisecSince( start );
+
+		std::string msg = "value(): " + std::to_string( value.size() ) + " bytes in "
+		    + std::to_string( first ) + " ms, again: " + std::to_string( second ) + " ms";
+		yuiMilestone() << msg << std::endl;
+		timeField->setValue( msg );
+	    }
+	}
+    }
+
+
+    //
+    // Clean up
+    //
+
+    dialog->destroy();
+}
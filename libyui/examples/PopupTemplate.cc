@@ -0,0 +1,187 @@
+/*
+  Copyright (c) 2000 - 2012 Novell, Inc.
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+  SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// Performance test for YDialogTemplate: Open the same popup many times
+//
+// The popup is created OPEN_COUNT times with the widget factory and then
+// OPEN_COUNT times from a template, opened and closed again right away. The
+// times are shown in the main dialog and written to the log. "Show Popup"
+// opens a popup from the template to check that it looks the same.
+//
+// Compile with:
+//
+//     g++ -I/usr/include/yui -lyui PopupTemplate.cc -o PopupTemplate
+
+
+#include <sstream>
+
+#define YUILogComponent "example"
+#include <yui/YUILog.h>
+
+#include <yui/YUI.h>
+#include <yui/YWidgetFactory.h>
+#include <yui/YDialog.h>
+#include <yui/YDialogTemplate.h>
+#include <yui/YLayoutBox.h>
+#include <yui/YButtonBox.h>
+#include <yui/YCheckBox.h>
+#include <yui/YLabel.h>
+#include <yui/YPushButton.h>
+#include <yui/YAlignment.h>
+#include <yui/YWidgetID.h>
+#include <yui/YEvent.h>
+#include <yui/YLatencyHistogram.h>	// YStopWatch
+
+#define OPEN_COUNT	100
+
+
+YDialog * createConfirmPopup()
+{
+    YWidgetFactory * fac = YUI::widgetFactory();
+
+    YDialog    * dialog = fac->createPopupDialog();
+    YLayoutBox * vbox   = fac->createVBox( dialog );
+    fac->createHeading( vbox, "Delete Repository" );
+    fac->createVSpacing( vbox, 0.5 );
+    fac->createLabel( vbox,
+		      "The repository \"Main Repository (OSS)\" will be deleted.\n"
+		      "Do you really want to continue?" );
+    fac->createVSpacing( vbox, 0.5 );
+
+    YCheckBox * checkBox = fac->createCheckBox( fac->createLeft( vbox ), "Do&n't ask again" );
+    checkBox->setId( new YStringWidgetID( "dont_ask" ) );
+
+    YButtonBox  * buttonBox = fac->createButtonBox( vbox );
+    YPushButton * yesButton = fac->createPushButton( buttonBox, "&Delete" );
+    yesButton->setId( new YStringWidgetID( "yes" ) );
+    yesButton->setRole( YOKButton );
+    yesButton->setDefaultButton();
+
+    YPushButton * noButton = fac->createPushButton( buttonBox, "&Cancel" );
+    noButton->setId( new YStringWidgetID( "no" ) );
+    noButton->setRole( YCancelButton );
+
+    return dialog;
+}
+
+
+long long openAndClose( YDialog * dialog )
+{
+    YStopWatch stopWatch;
+    dialog->open();
+    long long elapsed = stopWatch.elapsed();
+    dialog->destroy();
+
+    return elapsed;
+}
+
+
+int main( int argc, char **argv )
+{
+    YWidgetFactory * fac = YUI::widgetFactory();
+
+    YDialog    * dialog = fac->createMainDialog();
+    YLayoutBox * vbox   = fac->createVBox( dialog );
+    fac->createHeading( vbox, "Dialog Templates" );
+    YLabel * resultLabel = fac->createLabel( vbox, "Measuring..." );
+    resultLabel->setStretchable( YD_HORIZ, true );
+
+    YLayoutBox  * hbox        = fac->createHBox( vbox );
+    YPushButton * popupButton = fac->createPushButton( hbox, "&Show Popup" );
+    YPushButton * closeButton = fac->createPushButton( hbox, "&Close" );
+    dialog->open();
+
+    // The template is made from an open dialog to reuse its shortcuts and size
+
+    YDialog * popup = createConfirmPopup();
+    popup->open();
+    YDialogTemplate confirmTemplate( popup );
+    popup->destroy();
+
+    long long factoryCreate = 0;
+    long long factoryOpen   = 0;
+
+    for ( int i = 0; i < OPEN_COUNT; i++ )
+    {
+	YStopWatch stopWatch;
+	popup = createConfirmPopup();
+	factoryCreate += stopWatch.elapsed();
+	factoryOpen   += openAndClose( popup );
+    }
+
+    long long templateCreate = 0;
+    long long templateOpen   = 0;
+
+    for ( int i = 0; i < OPEN_COUNT; i++ )
+    {
+	YStopWatch stopWatch;
+	popup = confirmTemplate.instantiate();
+	templateCreate += stopWatch.elapsed();
+	templateOpen   += openAndClose( popup );
+    }
+
+    std::ostringstream result;
+    result.setf( std::ios::fixed );
+    result.precision( 3 );
+    result << OPEN_COUNT << " popups with " << confirmTemplate.widgetCount() << " widgets\n\n"
+	   << "Factory:  create " << factoryCreate  / 1000.0 / OPEN_COUNT << " ms"
+	   << ", open " << factoryOpen  / 1000.0 / OPEN_COUNT << " ms\n"
+	   << "Template: create " << templateCreate / 1000.0 / OPEN_COUNT << " ms"
+	   << ", open " << templateOpen / 1000.0 / OPEN_COUNT << " ms";
+
+    yuiMilestone() << result.str() << std::endl;
+    resultLabel->setText( result.str() );
+    dialog->recalcLayout();
+
+    while ( true )
+    {
+	YEvent * event = dialog->waitForEvent();
+
+	if ( event->eventType() == YEvent::CancelEvent ) // window manager "close window" button
+	    break;
+
+	if ( event->widget() == closeButton )
+	    break;
+
+	if ( event->widget() == popupButton )
+	{
+	    popup = confirmTemplate.instantiate();
+	    event = popup->waitForEvent();
+
+	    if ( event->widget() )
+	    {
+		YStringWidgetID dontAskId( "dont_ask" );
+		YCheckBox * dontAsk = dynamic_cast<YCheckBox *>( popup->findWidget( &dontAskId ) );
+
+		yuiMilestone() << "Popup closed with " << event->widget()->id()
+			       << ", \"Don't ask again\": " << dontAsk->isChecked()
+			       << std::endl;
+	    }
+
+	    popup->destroy();
+	}
+    }
+
+    dialog->destroy();
+}
@@ -0,0 +1,161 @@
+/*
+  Copyright (c) 2000 - 2012 Novell, Inc.
+
+  Permission is hereby granted, free of charge, to any person obtaining
+  a copy of this software and associated documentation files (the
+  "Software"), to deal in the Software without restriction, including
+  without limitation the rights to use, copy, modify, merge, publish,
+  distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be
+  included in all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT
+  SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+  OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR
+  THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+// Performance stress test for Tree: Browse a huge tree with lazy children
+//
+// The tree has LEVELS levels with BRANCH_COUNT children per item, i.e. far
+// too many items to create all of them up front. Only the toplevel items are
+// created at the start; all others are created when the user opens their
+// parent item (YEvent::ItemExpanded).
+//
+// Compile with:
+//
+//     g++ -I/usr/include/yui -lyui Tree-lazy-items.cc -o Tree-lazy-items
+
+
+#include <string>
+
+#define YUILogComponent "example"
+#include <yui/YUILog.h>
+
+#include <yui/YUI.h>
+#include <yui/YWidgetFactory.h>
+#include <yui/YDialog.h>
+#include <yui/YLayoutBox.h>
+#include <yui/YTree.h>
+#include <yui/YTreeItem.h>
+#include <yui/YLabel.h>
+#include <yui/YPushButton.h>
+#include <yui/YAlignment.h>
+#include <yui/YEvent.h>
+
+#define BRANCH_COUNT	100
+#define LEVELS		5
+
+
+int level( YTreeItem * item )
+{
+    int level = 0;
+
+    for ( YTreeItem * parent = item->parent(); parent; parent = parent->parent() )
+	++level;
+
+    return level;
+}
+
+
+/**
+ * Create the children of 'parent' (or the toplevel items if 'parent' is 0)
+ * and return them. Items that are not on the last level get lazy children.
+ **/
+YItemCollection createItems( YTreeItem * parent )
+{
+    YItemCollection items;
+    int childLevel = parent ? level( parent ) + 1 : 0;
+
+    for ( int i = 1; i <= BRANCH_COUNT; i++ )
+    {
+	std::string label = ( parent ? parent->label() + "." : std::string( "Item " ) ) + std::to_string( i );
+
+	YTreeItem * item = parent ?
+	    new YTreeItem( parent, label ) :
+	    new YTreeItem( label );
+
+	item->setLazyChildren( childLevel < LEVELS - 1 );
+	items.push_back( item );
+    }
+
+    return items;
+}
+
+
+
+int main( int argc, char **argv )
+{
+    YUILog::setLogFileName( "/tmp/libyui-examples.log" );
+    YUILog::enableDebugLogging();
+
+    //
+    // Create and open dialog
+    //
+
+    YDialog    * dialog  = YUI::widgetFactory()->createPopupDialog();
+    YAlignment * mbox    = YUI::widgetFactory()->createMarginBox( dialog, 1, 0.4 );
+    YLayoutBox * vbox    = YUI::widgetFactory()->createVBox( mbox );
+    YAlignment * minSize = YUI::widgetFactory()->createMinSize( vbox, 40, 15 ); // minWidth, minHeight
+
+    YTree * tree = YUI::widgetFactory()->createTree( minSize, "&Tree" );
+    tree->addItems( createItems( 0 ) );
+    long itemCount = BRANCH_COUNT;
+
+    YLabel * countField = YUI::widgetFactory()->createOutputField( vbox, "" );
+    countField->setStretchable( YD_HORIZ, true );
+    countField->setValue( std::to_string( itemCount ) + " items" );
+
+    YAlignment  * rightAlignment = YUI::widgetFactory()->createRight( vbox );
+    YPushButton * closeButton    = YUI::widgetFactory()->createPushButton( rightAlignment, "&Close" );
+
+
+    //
+    // Event loop
+    //
+
+    while ( true )
+    {
+	YEvent * event = dialog->waitForEvent();
+
+	if ( event )
+	{
+	    if ( event->eventType() == YEvent::CancelEvent ) // window manager "close window" button
+		break; // leave event loop
+
+	    if ( event->widget() == closeButton )
+		break; // leave event loop
+
+	    YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *>( event );
+
+	    if ( widgetEvent && widgetEvent->widget() == tree && widgetEvent->reason() == YEvent::ItemExpanded )
+	    {
+		YTreeItem * item = tree->expandedItem();
+
+		if ( item && item->hasLazyChildren() )
+		{
+		    // The constructor with a parent already adds the children
+		    itemCount += createItems( item ).size();
+		    tree->childrenLoaded( item );
+
+		    yuiMilestone() << "Loaded children of " << item->label() << std::endl;
+		    countField->setValue( std::to_string( itemCount ) + " items" );
+		}
+	    }
+	}
+    }
+
+
+    //
+    // Clean up
+    //
+
+    dialog->destroy();
+}
@@ -98,6 +98,8 @@ YBarGraph::addSegment( const YBarGraphSegment & segment )
 {
     priv->segments.push_back( segment );
     updateDisplay();
+
+    markChanged();
 }
 
 
@@ -106,6 +108,8 @@ YBarGraph::deleteAllSegments()
 {
     priv->segments.clear();
     updateDisplay();
+
+    markChanged();
 }
 
 
@@ -132,6 +136,8 @@ YBarGraph::setValue( int segmentIndex, int newValue )
 
     priv->segments[ segmentIndex ].setValue( newValue );
     updateDisplay();
+
+    markChanged();
 }
 
 
@@ -142,6 +148,8 @@ YBarGraph::setLabel( int segmentIndex, const string & newLabel )
 
     priv->segments[ segmentIndex ].setLabel( newLabel );
     updateDisplay();
+
+    markChanged();
 }
 
 
@@ -155,6 +163,8 @@ YBarGraph::setSegmentColor( int segmentIndex, const YColor & color )
 
     priv->segments[ segmentIndex ].setSegmentColor( color );
     updateDisplay();
+
+    markChanged();
 }
 
 
@@ -168,6 +178,8 @@ YBarGraph::setTextColor( int segmentIndex, const YColor & color )
 
     priv->segments[ segmentIndex ].setTextColor( color );
     updateDisplay();
+
+    markChanged();
 }
 
 
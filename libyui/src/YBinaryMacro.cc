@@ -0,0 +1,1010 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YBinaryMacro.cc
+
+/-*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YUIException.h"
+#include "YBinaryMacro.h"
+#include "YLatencyHistogram.h"
+#include "YDialog.h"
+#include "YEvent.h"
+#include "YWidgetID.h"
+#include "YProperty.h"
+#include "YSelectionWidget.h"
+#include "YMultiSelectionBox.h"
+#include "YMenuWidget.h"
+#include "YUISymbols.h"
+
+using std::string;
+using std::vector;
+using std::map;
+
+
+#define MACRO_MAGIC	"YUIMACRO"
+#define MACRO_VERSION	1
+
+#define ENV_MACRO_STATS	"YUI_MACRO_STATS"
+
+// Record tags
+#define TAG_PROPERTY	'P'
+#define TAG_EVENT	'E'
+
+// Widget reference kinds
+#define REF_NONE	0
+#define REF_ID		1
+#define REF_PATH	2
+
+// Value types
+#define VAL_STRING	's'
+#define VAL_INTEGER	'i'
+#define VAL_BOOL	'b'
+#define VAL_ITEMS	'I'
+
+
+typedef vector<int> YIndexPath;
+
+
+//
+// Helpers for writing
+//
+
+static void
+writeVarint( string & buf, unsigned long long val )
+{
+    do
+    {
+	unsigned char byte = val & 0x7f;
+	val >>= 7;
+
+	if ( val )
+	    byte |= 0x80;
+
+	buf += (char) byte;
+
+    } while ( val );
+}
+
+
+static void
+writeInteger( string & buf, long long val )
+{
+    // Zigzag encoding: small negative numbers stay small
+    writeVarint( buf, ( (unsigned long long) val << 1 ) ^ (unsigned long long) ( val >> 63 ) );
+}
+
+
+static void
+writeString( string & buf, const string & str )
+{
+    writeVarint( buf, str.size() );
+    buf += str;
+}
+
+
+static void
+writePath( string & buf, const YIndexPath & path )
+{
+    writeVarint( buf, path.size() );
+
+    for ( int index: path )
+	writeVarint( buf, index );
+}
+
+
+/**
+ * Return the path of child indices from the dialog to 'widget'.
+ **/
+static YIndexPath
+widgetPath( YWidget * widget )
+{
+    YIndexPath path;
+
+    while ( widget && widget->parent() )
+    {
+	YWidget * parent = widget->parent();
+	int index = 0;
+
+	for ( YWidgetListConstIterator it = parent->childrenBegin();
+	      it != parent->childrenEnd() && *it != widget;
+	      ++it )
+	{
+	    index++;
+	}
+
+	path.insert( path.begin(), index );
+	widget = parent;
+    }
+
+    return path;
+}
+
+
+static void
+writeWidgetRef( string & buf, YWidget * widget )
+{
+    if ( ! widget )
+    {
+	buf += (char) REF_NONE;
+    }
+    else if ( widget->hasId() )
+    {
+	buf += (char) REF_ID;
+	writeString( buf, widget->id()->toString() );
+    }
+    else
+    {
+	buf += (char) REF_PATH;
+	writePath( buf, widgetPath( widget ) );
+    }
+}
+
+
+/**
+ * Return the path of child indices from the selection widget to 'item'.
+ **/
+static YIndexPath
+itemPath( YItem * item )
+{
+    YIndexPath path;
+
+    while ( item && item->parent() )
+    {
+	YItem * parent = item->parent();
+	int index = 0;
+
+	for ( YItemConstIterator it = parent->childrenBegin();
+	      it != parent->childrenEnd() && *it != item;
+	      ++it )
+	{
+	    index++;
+	}
+
+	path.insert( path.begin(), index );
+	item = parent;
+    }
+
+    if ( item )
+	path.insert( path.begin(), item->index() );
+
+    return path;
+}
+
+
+/**
+ * Find the menu widget in the subtree of 'widget' that contains 'item'.
+ **/
+static YMenuWidget *
+findMenuWidget( YWidget * widget, YItem * item )
+{
+    YMenuWidget * menuWidget = dynamic_cast<YMenuWidget *>( widget );
+
+    if ( menuWidget && menuWidget->findMenuItem( item->index() ) == item )
+	return menuWidget;
+
+    for ( YWidgetListConstIterator it = widget->childrenBegin();
+	  it != widget->childrenEnd();
+	  ++it )
+    {
+	menuWidget = findMenuWidget( *it, item );
+
+	if ( menuWidget )
+	    return menuWidget;
+    }
+
+    return 0;
+}
+
+
+
+//
+// Helpers for reading
+//
+
+struct YMacroReader
+{
+    YMacroReader()
+	: pos( 0 )
+	, ok( true )
+	{}
+
+    bool atEnd() const { return pos >= data.size(); }
+
+    unsigned char readByte()
+    {
+	if ( pos >= data.size() )
+	{
+	    ok = false;
+	    return 0;
+	}
+
+	return (unsigned char) data[ pos++ ];
+    }
+
+    unsigned long long readVarint()
+    {
+	unsigned long long val = 0;
+	int shift = 0;
+	unsigned char byte;
+
+	do
+	{
+	    byte = readByte();
+	    val |= (unsigned long long) ( byte & 0x7f ) << shift;
+	    shift += 7;
+
+	} while ( ( byte & 0x80 ) && ok && shift < 64 );
+
+	return val;
+    }
+
+    long long readInteger()
+    {
+	unsigned long long val = readVarint();
+
+	return (long long) ( val >> 1 ) ^ -(long long) ( val & 1 );
+    }
+
+    string readString()
+    {
+	unsigned long long len = readVarint();
+
+	if ( ! ok || len > data.size() - pos )
+	{
+	    ok = false;
+	    return string();
+	}
+
+	string str = data.substr( pos, len );
+	pos += len;
+
+	return str;
+    }
+
+    YIndexPath readPath()
+    {
+	YIndexPath path;
+	unsigned long long count = readVarint();
+
+	for ( unsigned long long i = 0; i < count && ok; i++ )
+	    path.push_back( (int) readVarint() );
+
+	return path;
+    }
+
+    string		data;
+    string::size_type	pos;
+    bool		ok;
+};
+
+
+/**
+ * Resolve a widget reference in 'dialog'. Return 0 if there is no such
+ * widget. 'isNone' is set if the reference was explicitly empty.
+ **/
+static YWidget *
+readWidgetRef( YMacroReader & reader, YDialog * dialog, bool & isNone )
+{
+    isNone = false;
+
+    switch ( reader.readByte() )
+    {
+	case REF_NONE:
+	    isNone = true;
+	    return 0;
+
+	case REF_ID:
+	{
+	    YStringWidgetID id( reader.readString() );
+
+	    return dialog ? dialog->findWidget( &id, false ) : 0; // don't throw
+	}
+
+	case REF_PATH:
+	{
+	    YIndexPath path = reader.readPath();
+	    YWidget * widget = dialog;
+
+	    for ( int index: path )
+	    {
+		if ( ! widget || index >= widget->childrenCount() )
+		    return 0;
+
+		YWidgetListConstIterator it = widget->childrenBegin();
+		std::advance( it, index );
+		widget = *it;
+	    }
+
+	    return widget;
+	}
+
+	default:
+	    reader.ok = false;
+	    return 0;
+    }
+}
+
+
+static YItem *
+findItem( YSelectionWidget * widget, const YIndexPath & path )
+{
+    if ( path.empty() )
+	return 0;
+
+    YItem * item = widget->itemAt( path[0] );
+
+    for ( size_t i = 1; item && i < path.size(); i++ )
+    {
+	if ( path[i] >= (int) std::distance( item->childrenBegin(), item->childrenEnd() ) )
+	    return 0;
+
+	YItemIterator it = item->childrenBegin();
+	std::advance( it, path[i] );
+	item = *it;
+    }
+
+    return item;
+}
+
+
+
+
+struct YBinaryMacroRecorderPrivate
+{
+    std::ofstream	file;
+    string		filename;
+    string		block;
+};
+
+
+YBinaryMacroRecorder::YBinaryMacroRecorder()
+    : priv( new YBinaryMacroRecorderPrivate() )
+{
+    YUI_CHECK_NEW( priv );
+}
+
+
+YBinaryMacroRecorder::~YBinaryMacroRecorder()
+{
+    endRecording();
+}
+
+
+void
+YBinaryMacroRecorder::record( const string & macroFileName )
+{
+    endRecording();
+
+    priv->file.open( macroFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+    if ( ! priv->file.is_open() )
+    {
+	yuiError() << "Can't open macro file " << macroFileName << endl;
+	return;
+    }
+
+    priv->filename = macroFileName;
+    priv->block.clear();
+    priv->file << MACRO_MAGIC << (char) MACRO_VERSION;
+
+    yuiMilestone() << "Recording macro to " << macroFileName << endl;
+}
+
+
+void
+YBinaryMacroRecorder::endRecording()
+{
+    if ( priv->file.is_open() )
+    {
+	priv->file.close();
+	yuiMilestone() << "Macro " << priv->filename << " finished" << endl;
+    }
+
+    priv->block.clear();
+}
+
+
+bool
+YBinaryMacroRecorder::recording() const
+{
+    return priv->file.is_open();
+}
+
+
+void
+YBinaryMacroRecorder::recordWidgetProperty( YWidget *	 widget,
+					    const char * propertyName )
+{
+    if ( ! recording() || ! widget || ! propertyName )
+	return;
+
+    string value;
+
+    try
+    {
+	YPropertyValue val = widget->getProperty( propertyName );
+
+	switch ( val.type() )
+	{
+	    case YStringProperty:
+		value += (char) VAL_STRING;
+		writeString( value, val.stringVal() );
+		break;
+
+	    case YIntegerProperty:
+		value += (char) VAL_INTEGER;
+		writeInteger( value, val.integerVal() );
+		break;
+
+	    case YBoolProperty:
+		value += (char) VAL_BOOL;
+		value += (char) ( val.boolVal() ? 1 : 0 );
+		break;
+
+	    default:
+	    {
+		YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
+
+		if ( ! selWidget )
+		    break;
+
+		YItemCollection items;
+
+		if ( string( propertyName ) == YUIProperty_SelectedItems )
+		{
+		    items = selWidget->selectedItems();
+		}
+		else if ( string( propertyName ) == YUIProperty_CurrentItem )
+		{
+		    YMultiSelectionBox * multiSelBox = dynamic_cast<YMultiSelectionBox *>( widget );
+		    YItem * item = multiSelBox ? multiSelBox->currentItem() : selWidget->selectedItem();
+
+		    if ( item )
+			items.push_back( item );
+		}
+		else
+		{
+		    break;
+		}
+
+		value += (char) VAL_ITEMS;
+		writeVarint( value, items.size() );
+
+		for ( YItem * item: items )
+		    writePath( value, itemPath( item ) );
+	    }
+	    break;
+	}
+    }
+    catch ( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+    }
+
+    if ( value.empty() )
+    {
+	yuiDebug() << "Can't record property " << propertyName << " of " << widget << endl;
+	return;
+    }
+
+    priv->block += (char) TAG_PROPERTY;
+    writeWidgetRef( priv->block, widget );
+    writeString( priv->block, propertyName );
+    priv->block += value;
+}
+
+
+void
+YBinaryMacroRecorder::recordMakeScreenShot( bool enabled, const string & filename )
+{
+    // Not supported in binary macros
+}
+
+
+void
+YBinaryMacroRecorder::recordEvent( YDialog * dialog, YEvent * event )
+{
+    if ( ! recording() || ! dialog || ! event )
+	return;
+
+    dialog->saveUserInput( this );
+
+    YWidget *	widget	  = event->widget();
+    int		reason	  = 0;
+    string	str;
+    int		itemIndex = -1;
+
+    switch ( event->eventType() )
+    {
+	case YEvent::WidgetEvent:
+	{
+	    YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *>( event );
+
+	    if ( widgetEvent )
+		reason = widgetEvent->reason();
+	}
+	break;
+
+	case YEvent::MenuEvent:
+	{
+	    YMenuEvent * menuEvent = dynamic_cast<YMenuEvent *>( event );
+
+	    if ( menuEvent )
+	    {
+		str = menuEvent->id();
+
+		if ( menuEvent->item() )
+		{
+		    widget    = findMenuWidget( dialog, menuEvent->item() );
+		    itemIndex = menuEvent->item()->index();
+		}
+	    }
+	}
+	break;
+
+	case YEvent::KeyEvent:
+	{
+	    YKeyEvent * keyEvent = dynamic_cast<YKeyEvent *>( event );
+
+	    if ( keyEvent )
+	    {
+		str    = keyEvent->keySymbol();
+		widget = keyEvent->focusWidget();
+	    }
+	}
+	break;
+
+	case YEvent::SpecialKeyEvent:
+	{
+	    YSpecialKeyEvent * specialKeyEvent = dynamic_cast<YSpecialKeyEvent *>( event );
+
+	    if ( specialKeyEvent )
+		str = specialKeyEvent->id();
+	}
+	break;
+
+	default:
+	    break;
+    }
+
+    priv->block += (char) TAG_EVENT;
+    priv->block += (char) event->eventType();
+    writeWidgetRef( priv->block, widget );
+    priv->block += (char) reason;
+    writeString( priv->block, str );
+    writeInteger( priv->block, itemIndex );
+
+    priv->file.write( priv->block.data(), priv->block.size() );
+    priv->file.flush();
+    priv->block.clear();
+}
+
+
+
+
+struct YBinaryMacroPlayerPrivate
+{
+    YBinaryMacroPlayerPrivate()
+	: playing( false )
+	, failed( false )
+	, statsWritten( true )
+	, appRunning( false )
+	, steps( 0 )
+	{}
+
+    /**
+     * Play the next block for 'dialog'. If 'buildEvent' is true, return a
+     * newly created event for the block's event record. Stop playing at the
+     * end of the macro or upon errors.
+     **/
+    YEvent * playBlock( YDialog * dialog, bool buildEvent );
+
+    /**
+     * Apply one property record to 'dialog'. Return false on error.
+     **/
+    bool applyProperty( YDialog * dialog );
+
+    /**
+     * Read an event record and create the event if 'buildEvent' is true.
+     **/
+    YEvent * readEvent( YDialog * dialog, bool buildEvent );
+
+    /**
+     * Stop playing, log the statistics and write them to the stats file.
+     **/
+    void finish();
+
+    void fail( const string & message );
+
+    string				filename;
+    YMacroReader			reader;
+    bool				playing;
+    bool				failed;
+    bool				statsWritten;
+    string				error;
+    map<string, YLatencyHistogram>	stats;
+    YStopWatch				appWatch;
+    bool				appRunning;
+    int					steps;
+};
+
+
+void
+YBinaryMacroPlayerPrivate::fail( const string & message )
+{
+    yuiError() << "Macro " << filename << ", block " << steps << ": " << message << endl;
+
+    error  = message;
+    failed = true;
+}
+
+
+YEvent *
+YBinaryMacroPlayerPrivate::playBlock( YDialog * dialog, bool buildEvent )
+{
+    while ( playing && ! reader.atEnd() )
+    {
+	unsigned char tag = reader.readByte();
+
+	switch ( tag )
+	{
+	    case TAG_PROPERTY:
+
+		if ( ! applyProperty( dialog ) )
+		    finish();
+		break;
+
+	    case TAG_EVENT:
+	    {
+		YEvent * event = readEvent( dialog, buildEvent );
+		steps++;
+
+		if ( failed )
+		    finish();
+		else
+		    return event;
+	    }
+	    break;
+
+	    default:
+		fail( "Corrupt macro file" );
+		finish();
+		break;
+	}
+    }
+
+    if ( playing )
+	finish(); // End of macro
+
+    return 0;
+}
+
+
+bool
+YBinaryMacroPlayerPrivate::applyProperty( YDialog * dialog )
+{
+    bool isNone;
+    YWidget * widget = readWidgetRef( reader, dialog, isNone );
+    string propertyName = reader.readString();
+    unsigned char type = reader.readByte();
+
+    YPropertyValue value;
+    vector<YIndexPath> paths;
+
+    switch ( type )
+    {
+	case VAL_STRING:	value = YPropertyValue( reader.readString() );		break;
+	case VAL_INTEGER:	value = YPropertyValue( reader.readInteger() );		break;
+	case VAL_BOOL:		value = YPropertyValue( reader.readByte() != 0 );	break;
+
+	case VAL_ITEMS:
+	{
+	    unsigned long long count = reader.readVarint();
+
+	    for ( unsigned long long i = 0; i < count && reader.ok; i++ )
+		paths.push_back( reader.readPath() );
+	}
+	break;
+
+	default:
+	    reader.ok = false;
+	    break;
+    }
+
+    if ( ! reader.ok )
+    {
+	fail( "Corrupt macro file" );
+	return false;
+    }
+
+    if ( ! widget )
+    {
+	fail( "No widget for property " + propertyName );
+	return false;
+    }
+
+    try
+    {
+	if ( type == VAL_ITEMS )
+	{
+	    YSelectionWidget * selWidget = dynamic_cast<YSelectionWidget *>( widget );
+
+	    if ( ! selWidget )
+	    {
+		fail( string( "Not a selection widget: " ) + widget->widgetClass() );
+		return false;
+	    }
+
+	    YMultiSelectionBox * multiSelBox = dynamic_cast<YMultiSelectionBox *>( widget );
+
+	    if ( propertyName == YUIProperty_CurrentItem && multiSelBox )
+	    {
+		if ( ! paths.empty() )
+		    multiSelBox->setCurrentItem( findItem( selWidget, paths.front() ) );
+	    }
+	    else
+	    {
+		if ( propertyName == YUIProperty_SelectedItems )
+		    selWidget->deselectAllItems();
+
+		for ( const YIndexPath & path: paths )
+		{
+		    YItem * item = findItem( selWidget, path );
+
+		    if ( item )
+			selWidget->selectItem( item );
+		}
+	    }
+	}
+	else
+	{
+	    widget->setProperty( propertyName, value );
+	}
+    }
+    catch ( YUIException & exception )
+    {
+	YUI_CAUGHT( exception );
+	fail( "Can't set property " + propertyName + ": " + exception.msg() );
+	return false;
+    }
+
+    return true;
+}
+
+
+YEvent *
+YBinaryMacroPlayerPrivate::readEvent( YDialog * dialog, bool buildEvent )
+{
+    YEvent::EventType type = (YEvent::EventType) reader.readByte();
+    bool isNone;
+    YWidget * widget = readWidgetRef( reader, dialog, isNone );
+    YEvent::EventReason reason = (YEvent::EventReason) reader.readByte();
+    string str = reader.readString();
+    int itemIndex = (int) reader.readInteger();
+
+    if ( ! reader.ok )
+    {
+	fail( "Corrupt macro file" );
+	return 0;
+    }
+
+    if ( ! widget && ! isNone )
+    {
+	fail( "No widget for event" );
+	return 0;
+    }
+
+    if ( ! buildEvent )
+	return 0;
+
+    switch ( type )
+    {
+	case YEvent::WidgetEvent:
+	    return new YWidgetEvent( widget, reason );
+
+	case YEvent::MenuEvent:
+	{
+	    YMenuWidget * menuWidget = dynamic_cast<YMenuWidget *>( widget );
+
+	    if ( menuWidget && itemIndex >= 0 )
+	    {
+		YMenuItem * item = menuWidget->findMenuItem( itemIndex );
+
+		if ( ! item )
+		{
+		    fail( "No menu item for event" );
+		    return 0;
+		}
+
+		return new YMenuEvent( item );
+	    }
+
+	    return new YMenuEvent( str );
+	}
+
+	case YEvent::KeyEvent:		return new YKeyEvent( str, widget );
+	case YEvent::CancelEvent:	return new YCancelEvent();
+	case YEvent::TimeoutEvent:	return new YTimeoutEvent();
+	case YEvent::DebugEvent:	return new YDebugEvent();
+	case YEvent::SpecialKeyEvent:	return new YSpecialKeyEvent( str );
+
+	default:
+	    fail( "Unsupported event type" );
+	    return 0;
+    }
+}
+
+
+void
+YBinaryMacroPlayerPrivate::finish()
+{
+    playing = false;
+
+    if ( statsWritten )
+	return;
+
+    statsWritten = true;
+
+    yuiMilestone() << "Macro " << filename << ( failed ? " failed" : " finished" )
+		   << " after " << steps << " steps" << endl;
+
+    for ( const auto & pair: stats )
+	yuiMilestone() << "  " << pair.first << ": " << pair.second << endl;
+
+    const char * statsFile = getenv( ENV_MACRO_STATS );
+
+    if ( statsFile && *statsFile )
+    {
+	std::ofstream file( statsFile );
+
+	if ( ! file.is_open() )
+	{
+	    yuiError() << "Can't write macro statistics to " << statsFile << endl;
+	    return;
+	}
+
+	file << "macro " << filename << "\n"
+	     << "result " << ( failed ? "failed" : "ok" ) << "\n"
+	     << "steps " << steps << "\n";
+
+	if ( failed )
+	    file << "error " << error << "\n";
+
+	for ( const auto & pair: stats )
+	{
+	    file << "phase " << pair.first << " ";
+	    pair.second.write( file );
+	}
+    }
+}
+
+
+
+
+YBinaryMacroPlayer::YBinaryMacroPlayer()
+    : priv( new YBinaryMacroPlayerPrivate() )
+{
+    YUI_CHECK_NEW( priv );
+}
+
+
+YBinaryMacroPlayer::~YBinaryMacroPlayer()
+{
+    priv->finish();
+}
+
+
+void
+YBinaryMacroPlayer::play( const string & macroFile )
+{
+    priv->finish();
+
+    std::ifstream file( macroFile.c_str(), std::ios::in | std::ios::binary );
+
+    if ( ! file.is_open() )
+    {
+	yuiError() << "Can't open macro file " << macroFile << endl;
+	return;
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+
+    priv->reader	= YMacroReader();
+    priv->reader.data	= content.str();
+    priv->filename	= macroFile;
+    priv->failed	= false;
+    priv->error.clear();
+    priv->stats.clear();
+    priv->steps		= 0;
+    priv->appRunning	= false;
+
+    string magic = priv->reader.data.substr( 0, strlen( MACRO_MAGIC ) );
+    priv->reader.pos = magic.size();
+
+    if ( magic != MACRO_MAGIC || priv->reader.readByte() != MACRO_VERSION )
+    {
+	yuiError() << "Not a binary macro file (or wrong version): " << macroFile << endl;
+	return;
+    }
+
+    priv->playing	= true;
+    priv->statsWritten	= false;
+
+    yuiMilestone() << "Playing macro " << macroFile << endl;
+}
+
+
+void
+YBinaryMacroPlayer::playNextBlock()
+{
+    priv->playBlock( YDialog::currentDialog( false ), false ); // don't throw
+}
+
+
+bool
+YBinaryMacroPlayer::playing() const
+{
+    return priv->playing;
+}
+
+
+YEvent *
+YBinaryMacroPlayer::playNextEvent( YDialog * dialog )
+{
+    if ( priv->appRunning )
+	recordTiming( "app", priv->appWatch.elapsed() );
+
+    YStopWatch watch;
+    YEvent * event = priv->playBlock( dialog, true );
+
+    if ( event )
+    {
+	recordTiming( "apply", watch.elapsed() );
+	priv->appWatch.restart();
+	priv->appRunning = true;
+    }
+
+    return event;
+}
+
+
+void
+YBinaryMacroPlayer::recordTiming( const char * phase, long long microsec )
+{
+    priv->stats[ phase ].add( microsec );
+}
+
+
+bool
+YBinaryMacroPlayer::failed() const
+{
+    return priv->failed;
+}
@@ -0,0 +1,208 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YBinaryMacro.h
+
+/-*/
+
+#ifndef YBinaryMacro_h
+#define YBinaryMacro_h
+
+#include <string>
+
+#include "YMacroRecorder.h"
+#include "YMacroPlayer.h"
+#include "ImplPtr.h"
+
+
+class YDialog;
+class YEvent;
+class YBinaryMacroRecorderPrivate;
+class YBinaryMacroPlayerPrivate;
+
+
+/**
+ * Macro recorder that writes a compact binary macro file.
+ *
+ * Unlike the YCP / Ruby macro recorder, this one is driven by libyui itself
+ * (see YMacro::recordEvent()), so it works for any libyui application.
+ * Each time YDialog::waitForEvent() delivers an event to the application,
+ * the user input properties of all widgets of the dialog are recorded,
+ * followed by the event itself. That makes one block of the macro.
+ *
+ * File format (all integers are unsigned LEB128 varints unless noted):
+ *
+ *   header:	"YUIMACRO" version(byte)
+ *   'P':	widgetRef propertyName(str) value		property record
+ *   'E':	type(byte) widgetRef reason(byte) str itemIndex	event record
+ *
+ *   str:	length bytes
+ *   widgetRef:	0 (none) | 1 id(str) | 2 count index... (child path)
+ *   value:	's' str | 'i' zigzag-int | 'b' byte | 'I' count itemPath...
+ *   itemPath:	count index...
+ *
+ * An event record ends a block. Widgets without an ID are referenced by the
+ * path of child indices from the dialog, items by the path of child
+ * indices from the selection widget.
+ **/
+class YBinaryMacroRecorder: public YMacroRecorder
+{
+public:
+
+    /**
+     * Constructor.
+     **/
+    YBinaryMacroRecorder();
+
+    /**
+     * Destructor. This ends recording if there is a macro being recorded.
+     **/
+    virtual ~YBinaryMacroRecorder();
+
+    /**
+     * Start recording a macro to the specified file.
+     *
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void record( const std::string & macroFileName );
+
+    /**
+     * End recording and close the current macro file (if there is any).
+     *
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void endRecording();
+
+    /**
+     * Return 'true' if a macro is currently being recorded.
+     *
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual bool recording() const;
+
+    /**
+     * Record one widget property.
+     *
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void recordWidgetProperty( YWidget *	widget,
+				       const char *	propertyName );
+
+    /**
+     * Screen shots are not supported in binary macros; this does nothing.
+     *
+     * Reimplemented from YMacroRecorder.
+     **/
+    virtual void recordMakeScreenShot( bool enabled = false,
+				       const std::string & filename = std::string() );
+
+    /**
+     * Record the user input of 'dialog' and 'event'. This is called from
+     * YMacro::recordEvent().
+     **/
+    void recordEvent( YDialog * dialog, YEvent * event );
+
+private:
+
+    ImplPtr<YBinaryMacroRecorderPrivate> priv;
+};
+
+
+/**
+ * Macro player for macros recorded with YBinaryMacroRecorder.
+ *
+ * The macro is replayed as fast as possible, i.e. without any think time:
+ * Each time YDialog::waitForEvent() is called, the next block is applied
+ * to the dialog and its event is returned immediately.
+ *
+ * While playing, the time spent in each step of the UI is collected in a
+ * latency histogram per step:
+ *
+ *   "app"	between delivering an event and the next waitForEvent(),
+ *		i.e. the application handling the event and building or
+ *		changing dialogs
+ *   "layout"	initial layout of dialogs (YDialog::open())
+ *   "apply"	applying the recorded widget properties
+ *   "event"	delivering the event (event filters)
+ *   "render"	screen updates (reported by the UI, if supported)
+ *
+ * When the macro ends, the histograms are written to the log and, if the
+ * environment variable YUI_MACRO_STATS is set, to that file. If a recorded
+ * widget can't be found, playing stops with an error that is also written
+ * to that file.
+ **/
+class YBinaryMacroPlayer: public YMacroPlayer
+{
+public:
+
+    /**
+     * Constructor.
+     **/
+    YBinaryMacroPlayer();
+
+    /**
+     * Destructor. This writes the statistics if that was not done yet.
+     **/
+    virtual ~YBinaryMacroPlayer();
+
+    /**
+     * Play a macro from the specified macro file.
+     *
+     * Reimplemented from YMacroPlayer.
+     **/
+    virtual void play( const std::string & macroFile );
+
+    /**
+     * Play the next block for the current dialog; the event is discarded.
+     *
+     * Reimplemented from YMacroPlayer.
+     **/
+    virtual void playNextBlock();
+
+    /**
+     * Return 'true' if a macro is currently being played.
+     *
+     * Reimplemented from YMacroPlayer.
+     **/
+    virtual bool playing() const;
+
+    /**
+     * Play the next block for 'dialog' and return its event. This is
+     * called from YMacro::playNextEvent().
+     **/
+    YEvent * playNextEvent( YDialog * dialog );
+
+    /**
+     * Add a timing for 'phase' to the statistics. This is called from
+     * YMacro::recordTiming().
+     **/
+    void recordTiming( const char * phase, long long microsec );
+
+    /**
+     * Return 'true' if playing failed, e.g. because a widget could not be
+     * found.
+     **/
+    bool failed() const;
+
+private:
+
+    ImplPtr<YBinaryMacroPlayerPrivate> priv;
+};
+
+
+#endif // YBinaryMacro_h
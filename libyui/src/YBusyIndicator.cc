@@ -80,6 +80,7 @@ string YBusyIndicator::label()
 void YBusyIndicator::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -95,12 +96,15 @@ void YBusyIndicator::setTimeout( int newTimeout )
 	newTimeout = 1;
 
     priv->timeout = newTimeout;
+
+    markChanged();
 }
 
 
 void YBusyIndicator::setAlive( bool alive )
 {
     priv->alive = alive;
+    markChanged();
 }
 
 bool YBusyIndicator::alive() const
@@ -61,6 +61,7 @@ YCheckBox::~YCheckBox()
 void YCheckBox::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    markChanged();
 }
 
 
@@ -79,6 +80,7 @@ bool YCheckBox::useBoldFont() const
 void YCheckBox::setUseBoldFont( bool bold )
 {
     priv->useBoldFont = bold;
+    markChanged();
 }
 
 
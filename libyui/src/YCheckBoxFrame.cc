@@ -73,6 +73,7 @@ string YCheckBoxFrame::label() const
 void YCheckBoxFrame::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -86,6 +87,8 @@ void YCheckBoxFrame::setAutoEnable( bool autoEnable )
 {
     // yuiDebug() << "Auto enable: " << boolalpha << autoEnable << endl;
     priv->autoEnable = autoEnable;
+
+    markChanged();
 }
 
 
@@ -99,6 +102,8 @@ void YCheckBoxFrame::setInvertAutoEnable( bool invertAutoEnable )
 {
     // yuiDebug() << "Invert auto enable: ", boolalpha << invertAutoEnable << endl;
     priv->invertAutoEnable = invertAutoEnable;
+
+    markChanged();
 }
 
 
@@ -78,6 +78,7 @@ string YComboBox::validChars()
 void YComboBox::setValidChars( const string & newValidChars )
 {
     priv->validChars= newValidChars;
+    markChanged();
 }
 
 
@@ -90,6 +91,7 @@ int YComboBox::inputMaxLength() const
 void YComboBox::setInputMaxLength( int len )
 {
     priv->inputMaxLength = len;
+    markChanged();
 }
 
 
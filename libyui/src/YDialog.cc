@@ -32,6 +32,8 @@
 #include "YPushButton.h"
 #include "YUI.h"
 #include "YEventFilter.h"
+#include "YMacro.h"
+#include "YLatencyHistogram.h"
 
 #define VERBOSE_DIALOGS			0
 #define VERBOSE_DISCARDED_EVENTS	0
@@ -53,6 +55,13 @@ struct YDialogPrivate
         , multiPassLayout( false )
         , layoutPass( 0 )
 	, lastEvent( 0 )
+	, changeVersion( 0 )
+	, allChangedVersion( 0 )
+	, hasOpenHints( false )
+	, hintShortcutsResolved( false )
+	, hintWidth( -1 )
+	, hintHeight( -1 )
+	, hintChangeVersion( 0 )
 	{}
 
     YDialogType		dialogType;
@@ -64,9 +73,22 @@ struct YDialogPrivate
     int                 layoutPass;
     YEvent *		lastEvent;
     YEventFilterList	eventFilterList;
+    unsigned long	changeVersion;
+    unsigned long	allChangedVersion;
+
+    // see setOpenHints()
+    bool		hasOpenHints;
+    bool		hintShortcutsResolved;
+    int			hintWidth;
+    int			hintHeight;
+    unsigned long	hintChangeVersion;
 };
 
 
+// The last change version of all dialogs, so the versions are unique
+static unsigned long lastChangeVersion = 0;
+
+
 
 /**
  * Helper class: Event filter that handles "Help" buttons.
@@ -139,6 +161,7 @@ YDialog::YDialog( YDialogType dialogType, YDialogColorMode colorMode )
 {
     YUI_CHECK_NEW( priv );
 
+    markAllChanged();
     _dialogStack.push( this );
 
 #if VERBOSE_DIALOGS
@@ -178,7 +201,11 @@ YDialog::~YDialog()
 	_dialogStack.pop();
 
 	if ( ! _dialogStack.empty() )
+	{
+	    // A client that saw the closed dialog needs all of this one again
+	    _dialogStack.top()->markAllChanged();
 	    _dialogStack.top()->activate();
+	}
     }
     else
 	yuiError() << "Not top of dialog stack: " << this << endl;
@@ -191,8 +218,22 @@ YDialog::open()
     if ( priv->isOpen )
 	return;
 
-    checkShortcuts();
-    setInitialSize();
+    bool useHints = priv->hasOpenHints && priv->hintChangeVersion == changeVersion();
+    priv->hasOpenHints = false;
+
+    if ( ! useHints || ! priv->hintShortcutsResolved )
+	checkShortcuts();
+
+    YStopWatch stopWatch;
+
+    if ( useHints && priv->hintWidth > 0 && priv->hintHeight > 0 )
+	doLayout( priv->hintWidth, priv->hintHeight );
+    else
+	setInitialSize();
+
+    if ( YMacro::playing() )
+	YMacro::recordTiming( "layout", stopWatch.elapsed() );
+
     openInternal();	// Make sure this is only called once!
 
     priv->isOpen = true;
@@ -301,6 +342,17 @@ YDialog::shortcutCheckPostponed() const
 }
 
 
+void
+YDialog::setOpenHints( bool shortcutsResolved, int width, int height )
+{
+    priv->hasOpenHints		= true;
+    priv->hintShortcutsResolved = shortcutsResolved;
+    priv->hintWidth		= width;
+    priv->hintHeight		= height;
+    priv->hintChangeVersion	= changeVersion();
+}
+
+
 void
 YDialog::checkShortcuts( bool force )
 {
@@ -340,6 +392,36 @@ YDialog::setDefaultButton( YPushButton * newDefaultButton )
 }
 
 
+unsigned long
+YDialog::changeVersion() const
+{
+    return priv->changeVersion;
+}
+
+
+unsigned long
+YDialog::newChangeVersion()
+{
+    priv->changeVersion = ++lastChangeVersion;
+
+    return priv->changeVersion;
+}
+
+
+void
+YDialog::markAllChanged()
+{
+    priv->allChangedVersion = newChangeVersion();
+}
+
+
+unsigned long
+YDialog::allChangedVersion() const
+{
+    return priv->allChangedVersion;
+}
+
+
 void
 YDialog::setInitialSize()
 {
@@ -376,6 +458,22 @@ YDialog::doLayout()
 }
 
 
+void
+YDialog::doLayout( int width, int height )
+{
+    priv->layoutPass = 1;
+    setSize( width, height );
+
+    if ( priv->multiPassLayout )
+    {
+        priv->layoutPass = 2;
+        setSize( width, height );
+    }
+
+    priv->layoutPass = 0;
+}
+
+
 int
 YDialog::layoutPass() const
 {
@@ -408,9 +506,17 @@ YDialog::waitForEvent( int timeout_millisec )
 
     do
     {
-	event = filterInvalidEvents( waitForEventInternal( timeout_millisec ) );
+	// While a macro is being played, take the next event from there
+	// instead of waiting for the user.
+	YEvent * macroEvent = YMacro::playNextEvent( this );
+	YStopWatch stopWatch;
+
+	event = filterInvalidEvents( macroEvent ? macroEvent : waitForEventInternal( timeout_millisec ) );
 	event = callEventFilters( event );
 
+	if ( macroEvent )
+	    YMacro::recordTiming( "event", stopWatch.elapsed() );
+
 	// If there was no event, if filterInvalidEvents() discarded an invalid
 	// event, or if one of the event filters consumed an event, go back and
 	// get the next event.
@@ -418,6 +524,7 @@ YDialog::waitForEvent( int timeout_millisec )
     } while ( ! event );
 
     priv->lastEvent = event;
+    YMacro::recordEvent( this, event );
 
     return event;
 }
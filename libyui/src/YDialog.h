@@ -279,6 +279,20 @@ public:
      **/
     bool shortcutCheckPostponed() const;
 
+    /**
+     * Set precomputed results for open(), e.g. from a YDialogTemplate:
+     *
+     * If 'shortcutsResolved' is 'true', the keyboard shortcuts are known to
+     * be free of conflicts, so open() does not check them. If 'width' and
+     * 'height' are positive, open() uses them as the size of this dialog
+     * instead of asking all widgets for their preferred size.
+     *
+     * The hints are dropped if any widget of this dialog changes before
+     * open(). They are only used once, a later recalcLayout() does the full
+     * calculation again.
+     **/
+    void setOpenHints( bool shortcutsResolved, int width = -1, int height = -1 );
+
     /**
      * Return this dialog's default button: The button that is activated when
      * the user hits [Return] anywhere in this dialog. Note that this is not
@@ -353,6 +367,40 @@ public:
      **/
     virtual void activate() = 0;
 
+    /**
+     * Return the change version of this dialog: A number that increases with
+     * each change of a widget in this dialog (see YWidget::markChanged()).
+     * The numbers are unique over all dialogs, so a different version of the
+     * topmost dialog also means a change if another dialog became the
+     * topmost one.
+     *
+     * This is meant for clients that poll the dialog content (like the REST
+     * API): If the version didn't change, there is no need to look at the
+     * widgets again.
+     **/
+    unsigned long changeVersion() const;
+
+    /**
+     * Increase the change version of this dialog and return the new one.
+     * This is called by YWidget::markChanged().
+     **/
+    unsigned long newChangeVersion();
+
+    /**
+     * Record a change that can't be attributed to a specific widget, for
+     * example user input the UI doesn't report: Consider all widgets of
+     * this dialog changed.
+     **/
+    void markAllChanged();
+
+    /**
+     * Return the change version of the last markAllChanged() call or of the
+     * creation of this dialog. If this is newer than a version a client
+     * looked at, any widget might have changed since then, not only those
+     * with a newer YWidget::changeVersion().
+     **/
+    unsigned long allChangedVersion() const;
+
 
     //
     // Dialog helpers - see source file YDialogHelpers.cc
@@ -405,6 +453,12 @@ protected:
      **/
     void doLayout();
 
+    /**
+     * Set the size of the dialog and all widgets when the size of the dialog
+     * is already known.
+     **/
+    void doLayout( int width, int height );
+
     /**
      * Wait for a user event.
      *
@@ -0,0 +1,817 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YDialogTemplate.cc
+
+/-*/
+
+
+#include <string.h>	// strcmp()
+#include <vector>
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YDialogTemplate.h"
+#include "YUI.h"
+#include "YApplication.h"
+#include "YWidgetFactory.h"
+#include "YWidgetID.h"
+#include "YUIException.h"
+#include "YLatencyHistogram.h"	// YStopWatch
+
+#include "YDialog.h"
+#include "YAlignment.h"
+#include "YButtonBox.h"
+#include "YCheckBox.h"
+#include "YComboBox.h"
+#include "YEmpty.h"
+#include "YFrame.h"
+#include "YImage.h"
+#include "YInputField.h"
+#include "YIntField.h"
+#include "YLabel.h"
+#include "YLayoutBox.h"
+#include "YMultiLineEdit.h"
+#include "YProgressBar.h"
+#include "YPushButton.h"
+#include "YRadioButton.h"
+#include "YRadioButtonGroup.h"
+#include "YReplacePoint.h"
+#include "YRichText.h"
+#include "YSelectionBox.h"
+#include "YSpacing.h"
+#include "YSquash.h"
+
+using std::string;
+using std::vector;
+
+
+namespace
+{
+    enum NodeType
+    {
+	DialogNode,
+	AlignmentNode,
+	ButtonBoxNode,
+	CheckBoxNode,
+	ComboBoxNode,
+	EmptyNode,
+	FrameNode,
+	ImageNode,
+	InputFieldNode,
+	IntFieldNode,
+	LabelNode,
+	LayoutBoxNode,
+	MultiLineEditNode,
+	ProgressBarNode,
+	PushButtonNode,
+	RadioButtonGroupNode,
+	RadioButtonNode,
+	ReplacePointNode,
+	RichTextNode,
+	SelectionBoxNode,
+	SpacingNode,
+	SquashNode
+    };
+
+
+    struct TemplateItem
+    {
+	string label;
+	string iconName;
+	bool   selected;
+    };
+
+
+    /**
+     * One widget of the template. The widgets are stored in preorder, each
+     * one followed by the subtrees of its 'childCount' children.
+     *
+     * The meaning of the type specific fields depends on the widget type;
+     * they hold what the factory needs to create the widget plus the
+     * properties that differ from the defaults.
+     **/
+    struct TemplateNode
+    {
+	NodeType type;
+	int	 childCount;
+
+	// YWidget properties
+
+	string	 id;		// YStringWidgetID; empty: no ID
+	string	 helpText;
+	bool	 enabled;
+	bool	 notify;
+	bool	 notifyContextMenu;
+	bool	 sendKeyEvents;
+	bool	 autoShortcut;
+	int	 functionKey;
+	bool	 stretch[ YUIAllDimensions ];
+	int	 weight [ YUIAllDimensions ];
+
+	// type specific
+
+	string	 text;		// label, text or image file name
+	string	 value;		// current value of text input widgets
+	string	 validChars;
+	int	 num[ 6 ];	// dimension, alignment, margins, min/max/value
+	int	 size[ YUIAllDimensions ];	// min. width and height, spacing size
+	bool	 flag[ 4 ];	// e.g. heading, bold font, password mode
+	vector<TemplateItem> items;
+    };
+}
+
+
+struct YDialogTemplatePrivate
+{
+    YDialogTemplatePrivate()
+	: shortcutsResolved( false )
+	, width( -1 )
+	, height( -1 )
+	, displayWidth( -1 )
+	, displayHeight( -1 )
+	{}
+
+    vector<TemplateNode> nodes;
+    bool		 shortcutsResolved;
+
+    // dialog size and the display size it is valid for
+    int			 width;
+    int			 height;
+    int			 displayWidth;
+    int			 displayHeight;
+
+    void	freeze( YWidget * widget );
+    YWidget *	create( YWidget * parent, size_t & index ) const;
+};
+
+
+/**
+ * Throw an exception for a widget that can't be part of a template.
+ **/
+static void unsupported( YWidget * widget, const string & what )
+{
+    YUI_THROW( YUIException( string( "Can't make a dialog template from " ) +
+			     widget->widgetClass() + ": " + what ) );
+}
+
+
+void
+YDialogTemplatePrivate::freeze( YWidget * widget )
+{
+    TemplateNode node;
+
+    node.childCount = widget->childrenCount();
+
+    if ( widget->hasId() )
+    {
+	if ( ! dynamic_cast<YStringWidgetID *>( widget->id() ) )
+	    unsupported( widget, "only string IDs are supported" );
+
+	node.id = widget->id()->toString();
+    }
+
+    node.helpText	   = widget->helpText();
+    node.enabled	   = widget->isEnabled();
+    node.notify		   = widget->notify();
+    node.notifyContextMenu = widget->notifyContextMenu();
+    node.sendKeyEvents	   = widget->sendKeyEvents();
+    node.autoShortcut	   = widget->autoShortcut();
+    node.functionKey	   = widget->functionKey();
+
+    for ( int dim = YD_HORIZ; dim < YUIAllDimensions; dim++ )
+    {
+	// Not the virtual stretchable() and weight(): containers calculate
+	// them from their children
+	node.stretch[ dim ] = widget->YWidget::stretchable( (YUIDimension) dim );
+	node.weight [ dim ] = widget->YWidget::weight( (YUIDimension) dim );
+	node.size   [ dim ] = 0;
+    }
+
+    for ( int i = 0; i < 6; i++ )
+	node.num[ i ] = 0;
+
+    for ( int i = 0; i < 4; i++ )
+	node.flag[ i ] = false;
+
+    YSelectionWidget * selectionWidget = 0;
+
+    if ( YDialog * dialog = dynamic_cast<YDialog *>( widget ) )
+    {
+	node.type     = DialogNode;
+	node.num[ 0 ] = dialog->dialogType();
+	node.num[ 1 ] = dialog->colorMode();
+    }
+    else if ( YAlignment * alignment = dynamic_cast<YAlignment *>( widget ) )
+    {
+	node.type      = AlignmentNode;
+	node.text      = alignment->backgroundPixmap();
+	node.num [ 0 ] = alignment->alignment( YD_HORIZ );
+	node.num [ 1 ] = alignment->alignment( YD_VERT  );
+	node.size[ YD_HORIZ ] = alignment->minWidth();
+	node.size[ YD_VERT  ] = alignment->minHeight();
+	node.num [ 2 ] = alignment->leftMargin();
+	node.num [ 3 ] = alignment->rightMargin();
+	node.num [ 4 ] = alignment->topMargin();
+	node.num [ 5 ] = alignment->bottomMargin();
+    }
+    else if ( dynamic_cast<YButtonBox *>( widget ) )
+    {
+	node.type = ButtonBoxNode;
+    }
+    else if ( YCheckBox * checkBox = dynamic_cast<YCheckBox *>( widget ) )
+    {
+	node.type     = CheckBoxNode;
+	node.text     = checkBox->label();
+	node.num[ 0 ] = checkBox->value();
+	node.flag[ 0 ] = checkBox->useBoldFont();
+    }
+    else if ( YComboBox * comboBox = dynamic_cast<YComboBox *>( widget ) )
+    {
+	node.type	= ComboBoxNode;
+	node.text	= comboBox->label();
+	node.flag[ 0 ]	= comboBox->editable();
+	node.validChars = comboBox->validChars();
+	node.num[ 0 ]	= comboBox->inputMaxLength();
+
+	if ( comboBox->editable() )
+	    node.value = comboBox->value();
+
+	selectionWidget = comboBox;
+    }
+    else if ( dynamic_cast<YEmpty *>( widget ) )
+    {
+	node.type = EmptyNode;
+    }
+    else if ( YFrame * frame = dynamic_cast<YFrame *>( widget ) )
+    {
+	node.type = FrameNode;
+	node.text = frame->label();
+    }
+    else if ( YImage * image = dynamic_cast<YImage *>( widget ) )
+    {
+	node.type      = ImageNode;
+	node.text      = image->imageFileName();
+	node.flag[ 0 ] = image->animated();
+	node.flag[ 1 ] = image->autoScale();
+	node.flag[ 2 ] = image->hasZeroSize( YD_HORIZ );
+	node.flag[ 3 ] = image->hasZeroSize( YD_VERT  );
+    }
+    else if ( YInputField * inputField = dynamic_cast<YInputField *>( widget ) )
+    {
+	node.type	= InputFieldNode;
+	node.text	= inputField->label();
+	node.value	= inputField->value();
+	node.validChars = inputField->validChars();
+	node.num [ 0 ]	= inputField->inputMaxLength();
+	node.flag[ 0 ]	= inputField->passwordMode();
+	node.flag[ 1 ]	= inputField->shrinkable();
+    }
+    else if ( YIntField * intField = dynamic_cast<YIntField *>( widget ) )
+    {
+	node.type     = IntFieldNode;
+	node.text     = intField->label();
+	node.num[ 0 ] = intField->minValue();
+	node.num[ 1 ] = intField->maxValue();
+	node.num[ 2 ] = intField->value();
+    }
+    else if ( YLabel * label = dynamic_cast<YLabel *>( widget ) )
+    {
+	node.type      = LabelNode;
+	node.text      = label->text();
+	node.flag[ 0 ] = label->isHeading();
+	node.flag[ 1 ] = label->isOutputField();
+	node.flag[ 2 ] = label->useBoldFont();
+	node.flag[ 3 ] = label->autoWrap();
+    }
+    else if ( YLayoutBox * layoutBox = dynamic_cast<YLayoutBox *>( widget ) )
+    {
+	node.type     = LayoutBoxNode;
+	node.num[ 0 ] = layoutBox->primary();
+    }
+    else if ( YMultiLineEdit * multiLineEdit = dynamic_cast<YMultiLineEdit *>( widget ) )
+    {
+	node.type     = MultiLineEditNode;
+	node.text     = multiLineEdit->label();
+	node.value    = multiLineEdit->value();
+	node.num[ 0 ] = multiLineEdit->inputMaxLength();
+	node.num[ 1 ] = multiLineEdit->defaultVisibleLines();
+    }
+    else if ( YProgressBar * progressBar = dynamic_cast<YProgressBar *>( widget ) )
+    {
+	node.type     = ProgressBarNode;
+	node.text     = progressBar->label();
+	node.num[ 0 ] = progressBar->maxValue();
+	node.num[ 1 ] = progressBar->value();
+    }
+    else if ( YPushButton * button = dynamic_cast<YPushButton *>( widget ) )
+    {
+	// The label includes the shortcut as resolved by the shortcut check
+
+	node.type      = PushButtonNode;
+	node.text      = button->label();
+	node.num [ 0 ] = button->role();
+	node.flag[ 0 ] = button->isDefaultButton();
+	node.flag[ 1 ] = button->isHelpButton();
+	node.flag[ 2 ] = button->isRelNotesButton();
+    }
+    else if ( dynamic_cast<YRadioButtonGroup *>( widget ) )
+    {
+	node.type = RadioButtonGroupNode;
+    }
+    else if ( YRadioButton * radioButton = dynamic_cast<YRadioButton *>( widget ) )
+    {
+	node.type      = RadioButtonNode;
+	node.text      = radioButton->label();
+	node.flag[ 0 ] = radioButton->value();
+	node.flag[ 1 ] = radioButton->useBoldFont();
+    }
+    else if ( dynamic_cast<YReplacePoint *>( widget ) )
+    {
+	node.type = ReplacePointNode;
+    }
+    else if ( YRichText * richText = dynamic_cast<YRichText *>( widget ) )
+    {
+	node.type      = RichTextNode;
+	node.text      = richText->value();
+	node.flag[ 0 ] = richText->plainTextMode();
+	node.flag[ 1 ] = richText->autoScrollDown();
+	node.flag[ 2 ] = richText->shrinkable();
+    }
+    else if ( YSelectionBox * selectionBox = dynamic_cast<YSelectionBox *>( widget ) )
+    {
+	node.type      = SelectionBoxNode;
+	node.text      = selectionBox->label();
+	node.flag[ 0 ] = selectionBox->shrinkable();
+	node.flag[ 1 ] = selectionBox->immediateMode();
+
+	selectionWidget = selectionBox;
+    }
+    else if ( YSpacing * spacing = dynamic_cast<YSpacing *>( widget ) )
+    {
+	YUIDimension dim = spacing->dimension();
+
+	node.type	  = SpacingNode;
+	node.num [ 0 ]	  = dim;
+	node.size[ dim ]  = spacing->size( dim );
+    }
+    else if ( YSquash * squash = dynamic_cast<YSquash *>( widget ) )
+    {
+	node.type      = SquashNode;
+	node.flag[ 0 ] = squash->horSquash();
+	node.flag[ 1 ] = squash->vertSquash();
+    }
+    else
+    {
+	unsupported( widget, "unsupported widget type" );
+    }
+
+    if ( selectionWidget )
+    {
+	for ( YItemConstIterator it = selectionWidget->itemsBegin();
+	      it != selectionWidget->itemsEnd();
+	      ++it )
+	{
+	    const YItem * item = *it;
+
+	    if ( strcmp( item->itemClass(), "YItem" ) != 0 || item->data() )
+		unsupported( widget, "only simple items are supported" );
+
+	    node.items.push_back( { item->label(), item->iconName(), item->selected() } );
+	}
+    }
+
+    nodes.push_back( node );
+
+    for ( YWidgetListConstIterator it = widget->childrenConstBegin();
+	  it != widget->childrenConstEnd();
+	  ++it )
+    {
+	freeze( *it );
+    }
+}
+
+
+/**
+ * Set the YWidget properties of 'widget' from 'node'.
+ **/
+static void setWidgetProperties( YWidget * widget, const TemplateNode & node )
+{
+    if ( ! node.id.empty() )
+	widget->setId( new YStringWidgetID( node.id ) );
+
+    if ( ! node.helpText.empty() )
+	widget->setHelpText( node.helpText );
+
+    if ( ! node.enabled )
+	widget->setEnabled( false );
+
+    if ( node.notify )
+	widget->setNotify( true );
+
+    if ( node.notifyContextMenu )
+	widget->setNotifyContextMenu( true );
+
+    if ( node.sendKeyEvents )
+	widget->setSendKeyEvents( true );
+
+    if ( node.autoShortcut )
+	widget->setAutoShortcut( true );
+
+    if ( node.functionKey > 0 )
+	widget->setFunctionKey( node.functionKey );
+
+    for ( int dim = YD_HORIZ; dim < YUIAllDimensions; dim++ )
+    {
+	if ( widget->YWidget::stretchable( (YUIDimension) dim ) != node.stretch[ dim ] )
+	    widget->setStretchable( (YUIDimension) dim, node.stretch[ dim ] );
+
+	if ( node.weight[ dim ] )
+	    widget->setWeight( (YUIDimension) dim, node.weight[ dim ] );
+    }
+}
+
+
+static YItemCollection createItems( const TemplateNode & node )
+{
+    YItemCollection items;
+    items.reserve( node.items.size() );
+
+    for ( const TemplateItem & item: node.items )
+	items.push_back( new YItem( item.label, item.iconName, item.selected ) );
+
+    return items;
+}
+
+
+YWidget *
+YDialogTemplatePrivate::create( YWidget * parent, size_t & index ) const
+{
+    const TemplateNode & node = nodes[ index++ ];
+    YWidgetFactory * factory  = YUI::widgetFactory();
+    YWidget * widget = 0;
+
+    switch ( node.type )
+    {
+	case DialogNode:
+	    widget = factory->createDialog( (YDialogType) node.num[ 0 ], (YDialogColorMode) node.num[ 1 ] );
+	    break;
+
+	case AlignmentNode:
+	{
+	    YAlignment * alignment = factory->createAlignment( parent,
+							       (YAlignmentType) node.num[ 0 ],
+							       (YAlignmentType) node.num[ 1 ] );
+	    if ( node.num[ 2 ] ) alignment->setLeftMargin  ( node.num[ 2 ] );
+	    if ( node.num[ 3 ] ) alignment->setRightMargin ( node.num[ 3 ] );
+	    if ( node.num[ 4 ] ) alignment->setTopMargin   ( node.num[ 4 ] );
+	    if ( node.num[ 5 ] ) alignment->setBottomMargin( node.num[ 5 ] );
+
+	    if ( node.size[ YD_HORIZ ] )
+		alignment->setMinWidth( node.size[ YD_HORIZ ] );
+
+	    if ( node.size[ YD_VERT ] )
+		alignment->setMinHeight( node.size[ YD_VERT ] );
+
+	    if ( ! node.text.empty() )
+		alignment->setBackgroundPixmap( node.text );
+
+	    widget = alignment;
+	    break;
+	}
+
+	case ButtonBoxNode:
+	    widget = factory->createButtonBox( parent );
+	    break;
+
+	case CheckBoxNode:
+	{
+	    YCheckBox * checkBox = factory->createCheckBox( parent, node.text, node.num[ 0 ] == YCheckBox_on );
+
+	    if ( node.num[ 0 ] == YCheckBox_dont_care )
+		checkBox->setDontCare();
+
+	    if ( node.flag[ 0 ] )
+		checkBox->setUseBoldFont();
+
+	    widget = checkBox;
+	    break;
+	}
+
+	case ComboBoxNode:
+	{
+	    YComboBox * comboBox = factory->createComboBox( parent, node.text, node.flag[ 0 ] );
+
+	    if ( ! node.validChars.empty() )
+		comboBox->setValidChars( node.validChars );
+
+	    if ( node.num[ 0 ] >= 0 )
+		comboBox->setInputMaxLength( node.num[ 0 ] );
+
+	    if ( ! node.items.empty() )
+		comboBox->addItems( createItems( node ) );
+
+	    if ( node.flag[ 0 ] && ! node.value.empty() )
+		comboBox->setValue( node.value );
+
+	    widget = comboBox;
+	    break;
+	}
+
+	case EmptyNode:
+	    widget = factory->createEmpty( parent );
+	    break;
+
+	case FrameNode:
+	    widget = factory->createFrame( parent, node.text );
+	    break;
+
+	case ImageNode:
+	{
+	    YImage * image = factory->createImage( parent, node.text, node.flag[ 0 ] );
+
+	    if ( node.flag[ 1 ] )
+		image->setAutoScale();
+
+	    if ( node.flag[ 2 ] )
+		image->setZeroSize( YD_HORIZ );
+
+	    if ( node.flag[ 3 ] )
+		image->setZeroSize( YD_VERT );
+
+	    widget = image;
+	    break;
+	}
+
+	case InputFieldNode:
+	{
+	    YInputField * inputField = factory->createInputField( parent, node.text, node.flag[ 0 ] );
+
+	    if ( ! node.validChars.empty() )
+		inputField->setValidChars( node.validChars );
+
+	    if ( node.num[ 0 ] >= 0 )
+		inputField->setInputMaxLength( node.num[ 0 ] );
+
+	    if ( node.flag[ 1 ] )
+		inputField->setShrinkable();
+
+	    if ( ! node.value.empty() )
+		inputField->setValue( node.value );
+
+	    widget = inputField;
+	    break;
+	}
+
+	case IntFieldNode:
+	    widget = factory->createIntField( parent, node.text, node.num[ 0 ], node.num[ 1 ], node.num[ 2 ] );
+	    break;
+
+	case LabelNode:
+	{
+	    YLabel * label = factory->createLabel( parent, node.text, node.flag[ 0 ], node.flag[ 1 ] );
+
+	    if ( node.flag[ 2 ] )
+		label->setUseBoldFont();
+
+	    if ( node.flag[ 3 ] )
+		label->setAutoWrap();
+
+	    widget = label;
+	    break;
+	}
+
+	case LayoutBoxNode:
+	    widget = factory->createLayoutBox( parent, (YUIDimension) node.num[ 0 ] );
+	    break;
+
+	case MultiLineEditNode:
+	{
+	    YMultiLineEdit * multiLineEdit = factory->createMultiLineEdit( parent, node.text );
+
+	    if ( node.num[ 0 ] >= 0 )
+		multiLineEdit->setInputMaxLength( node.num[ 0 ] );
+
+	    multiLineEdit->setDefaultVisibleLines( node.num[ 1 ] );
+
+	    if ( ! node.value.empty() )
+		multiLineEdit->setValue( node.value );
+
+	    widget = multiLineEdit;
+	    break;
+	}
+
+	case ProgressBarNode:
+	{
+	    YProgressBar * progressBar = factory->createProgressBar( parent, node.text, node.num[ 0 ] );
+
+	    if ( node.num[ 1 ] )
+		progressBar->setValue( node.num[ 1 ] );
+
+	    widget = progressBar;
+	    break;
+	}
+
+	case PushButtonNode:
+	{
+	    YPushButton * button = factory->createPushButton( parent, node.text );
+
+	    if ( node.num[ 0 ] != YCustomButton )
+		button->setRole( (YButtonRole) node.num[ 0 ] );
+
+	    if ( node.flag[ 0 ] )
+		button->setDefaultButton();
+
+	    if ( node.flag[ 1 ] )
+		button->setHelpButton();
+
+	    if ( node.flag[ 2 ] )
+		button->setRelNotesButton();
+
+	    widget = button;
+	    break;
+	}
+
+	case RadioButtonGroupNode:
+	    widget = factory->createRadioButtonGroup( parent );
+	    break;
+
+	case RadioButtonNode:
+	{
+	    YRadioButton * radioButton = factory->createRadioButton( parent, node.text, node.flag[ 0 ] );
+
+	    if ( node.flag[ 1 ] )
+		radioButton->setUseBoldFont();
+
+	    widget = radioButton;
+	    break;
+	}
+
+	case ReplacePointNode:
+	    widget = factory->createReplacePoint( parent );
+	    break;
+
+	case RichTextNode:
+	{
+	    YRichText * richText = factory->createRichText( parent, node.text, node.flag[ 0 ] );
+
+	    if ( node.flag[ 1 ] )
+		richText->setAutoScrollDown();
+
+	    if ( node.flag[ 2 ] )
+		richText->setShrinkable();
+
+	    widget = richText;
+	    break;
+	}
+
+	case SelectionBoxNode:
+	{
+	    YSelectionBox * selectionBox = factory->createSelectionBox( parent, node.text );
+
+	    if ( node.flag[ 0 ] )
+		selectionBox->setShrinkable();
+
+	    if ( node.flag[ 1 ] )
+		selectionBox->setImmediateMode();
+
+	    if ( ! node.items.empty() )
+		selectionBox->addItems( createItems( node ) );
+
+	    widget = selectionBox;
+	    break;
+	}
+
+	case SpacingNode:
+	{
+	    // The factory takes the size in layout units, the template has
+	    // the device units of the original widget
+	    YUIDimension dim = (YUIDimension) node.num[ 0 ];
+	    YLayoutSize_t size = YUI::app()->layoutUnits( dim, node.size[ dim ] );
+
+	    widget = factory->createSpacing( parent, dim, node.stretch[ dim ], size );
+	    break;
+	}
+
+	case SquashNode:
+	    widget = factory->createSquash( parent, node.flag[ 0 ], node.flag[ 1 ] );
+	    break;
+
+	    // Intentionally omitting the 'default' case so the compiler can
+	    // catch unhandled enum values
+    }
+
+    YUI_CHECK_NEW( widget );
+    setWidgetProperties( widget, node );
+
+    for ( int i = 0; i < node.childCount; i++ )
+	create( widget, index );
+
+    return widget;
+}
+
+
+YDialogTemplate::YDialogTemplate( YWidget * root )
+    : priv( new YDialogTemplatePrivate() )
+{
+    YUI_CHECK_NEW( priv );
+    YUI_CHECK_WIDGET( root );
+
+    priv->freeze( root );
+
+    YDialog * dialog = dynamic_cast<YDialog *>( root );
+
+    // Only an open dialog had its shortcut check and its layout
+    if ( dialog && dialog->isOpen() )
+    {
+	priv->shortcutsResolved = ! dialog->shortcutCheckPostponed();
+
+	// Main dialogs get their size from the screen anyway
+	if ( dialog->dialogType() == YPopupDialog )
+	{
+	    priv->width		= dialog->preferredWidth();
+	    priv->height	= dialog->preferredHeight();
+	    priv->displayWidth	= YUI::app()->displayWidth();
+	    priv->displayHeight = YUI::app()->displayHeight();
+	}
+    }
+
+    yuiDebug() << "Template from " << root << ": " << priv->nodes.size() << " widgets" << endl;
+}
+
+
+YDialogTemplate::~YDialogTemplate()
+{
+    // NOP
+}
+
+
+YDialog *
+YDialogTemplate::instantiate() const
+{
+    if ( priv->nodes.front().type != DialogNode )
+	YUI_THROW( YUIException( "Not a dialog template" ) );
+
+    YStopWatch stopWatch;
+    size_t index = 0;
+    YDialog * dialog = static_cast<YDialog *>( priv->create( 0, index ) );
+
+    bool sizeValid = priv->width > 0 &&
+	priv->displayWidth  == YUI::app()->displayWidth() &&
+	priv->displayHeight == YUI::app()->displayHeight();
+
+    if ( priv->shortcutsResolved || sizeValid )
+    {
+	dialog->setOpenHints( priv->shortcutsResolved,
+			      sizeValid ? priv->width  : -1,
+			      sizeValid ? priv->height : -1 );
+    }
+
+    yuiDebug() << "Created " << dialog << " from a template in "
+		<< stopWatch.elapsed() << " usec" << endl;
+
+    return dialog;
+}
+
+
+YWidget *
+YDialogTemplate::instantiate( YWidget * parent ) const
+{
+    if ( priv->nodes.front().type == DialogNode )
+	YUI_THROW( YUIException( "Can't create a dialog template in a parent widget" ) );
+
+    YUI_CHECK_WIDGET( parent );
+    size_t index = 0;
+
+    return priv->create( parent, index );
+}
+
+
+int
+YDialogTemplate::widgetCount() const
+{
+    return priv->nodes.size();
+}
+
+
+bool
+YDialogTemplate::shortcutsResolved() const
+{
+    return priv->shortcutsResolved;
+}
@@ -0,0 +1,110 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YDialogTemplate.h
+
+/-*/
+
+#ifndef YDialogTemplate_h
+#define YDialogTemplate_h
+
+#include "ImplPtr.h"
+
+class YDialog;
+class YWidget;
+class YDialogTemplatePrivate;
+
+
+/**
+ * Frozen description of a dialog to create the same dialog again and again,
+ * e.g. a confirmation popup: Build the dialog once with the widget factory,
+ * make a template from it and create the next instances from the template.
+ *
+ *     YDialogTemplate confirmTemplate( dialog );
+ *     ...
+ *     YDialog * dialog = confirmTemplate.instantiate();
+ *     YEvent * event   = dialog->waitForEvent();
+ *
+ * The template stores the widget tree with the widget IDs, the labels and
+ * values and the layout options (stretch, weight, alignment, margins etc.)
+ * in a compact form. If the dialog was already open when the template was
+ * made, the template also stores the keyboard shortcuts as resolved then and,
+ * for popup dialogs, the size of the dialog; a dialog created from the
+ * template skips the shortcut check and the preferred size calculation when
+ * it is opened (see YDialog::setOpenHints()).
+ *
+ * The template can be used as long as the same UI is loaded. The dialog
+ * size is only reused while the display size stays the same.
+ *
+ * Only widget IDs of type YStringWidgetID and the common widgets (layout
+ * boxes, alignments, labels, buttons, input fields, check boxes, radio
+ * buttons, combo boxes and selection boxes with simple items etc.) are
+ * supported; the constructor throws a YUIException for anything else.
+ *
+ * A template can also be made from a widget subtree that is not a dialog,
+ * e.g. the contents of a wizard step, and created again in a parent widget
+ * with instantiate( parent ).
+ **/
+class YDialogTemplate
+{
+public:
+
+    /**
+     * Constructor: Make a template from 'root' and its children. 'root' is
+     * usually a dialog. It is not changed.
+     **/
+    YDialogTemplate( YWidget * root );
+
+    /**
+     * Destructor.
+     **/
+    virtual ~YDialogTemplate();
+
+    /**
+     * Create a new dialog from this template. The dialog is not open yet,
+     * so it can still be changed; use YWidget::findWidget() to find its
+     * widgets. Changing it drops the precomputed shortcuts and size.
+     **/
+    YDialog * instantiate() const;
+
+    /**
+     * Create the widgets of a template that was not made from a dialog as
+     * children of 'parent' and return the new top widget. As usual, call
+     * recalcLayout() on the dialog if it is already open.
+     **/
+    YWidget * instantiate( YWidget * parent ) const;
+
+    /**
+     * Return the number of widgets in this template, including the root
+     * widget.
+     **/
+    int widgetCount() const;
+
+    /**
+     * Return 'true' if the keyboard shortcuts were resolved when the
+     * template was made.
+     **/
+    bool shortcutsResolved() const;
+
+private:
+
+    ImplPtr<YDialogTemplatePrivate> priv;
+};
+
+
+#endif // YDialogTemplate_h
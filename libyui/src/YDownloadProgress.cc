@@ -23,30 +23,37 @@
 /-*/
 
 
-#include <sys/stat.h>
-
 #define YUILogComponent "ui"
 #include "YUILog.h"
 
 #include "YUISymbols.h"
 #include "YDownloadProgress.h"
+#include "YFileSizeTracker.h"
 
 using std::string;
 	
 
-struct YDownloadProgressPrivate
+struct YDownloadProgressPrivate: public YFileSizeListener
 {
-    YDownloadProgressPrivate( const string &	label,
-			      const string &	filename,
-			      YFileSize_t	expectedSize )
-	: label( label )
+    YDownloadProgressPrivate( YDownloadProgress *	parent,
+			      const string &		label,
+			      const string &		filename,
+			      YFileSize_t		expectedSize )
+	: parent( parent )
+	, label( label )
 	, filename( filename )
 	, expectedSize( expectedSize )
 	{}
 
-    string	label;
-    string	filename;
-    YFileSize_t	expectedSize;
+    virtual void fileSizeChanged( const string & filename, YFileSize_t newSize )
+	{
+	    parent->markChanged();
+	}
+
+    YDownloadProgress *	parent;
+    string		label;
+    string		filename;
+    YFileSize_t		expectedSize;
 };
 
 
@@ -55,10 +62,12 @@ YDownloadProgress::YDownloadProgress( YWidget *		parent,
 				      const string &	filename,
 				      YFileSize_t	expectedSize )
     : YWidget( parent )
-    , priv( new YDownloadProgressPrivate( label, filename, expectedSize ) )
+    , priv( new YDownloadProgressPrivate( this, label, filename, expectedSize ) )
 {
     YUI_CHECK_NEW( priv );
 
+    YFileSizeTracker::instance()->addFile( filename, priv.get() );
+
     setDefaultStretchable( YD_HORIZ, true );
     setStretchable( YD_VERT, false );
 }
@@ -66,7 +75,7 @@ YDownloadProgress::YDownloadProgress( YWidget *		parent,
 
 YDownloadProgress::~YDownloadProgress()
 {
-    // NOP
+    YFileSizeTracker::instance()->removeFile( priv->filename, priv.get() );
 }
 
 
@@ -81,6 +90,7 @@ void
 YDownloadProgress::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -94,7 +104,14 @@ YDownloadProgress::filename() const
 void
 YDownloadProgress::setFilename( const string & filename )
 {
+    if ( filename == priv->filename )
+	return;
+
+    YFileSizeTracker::instance()->removeFile( priv->filename, priv.get() );
     priv->filename = filename;
+    YFileSizeTracker::instance()->addFile( priv->filename, priv.get() );
+
+    markChanged();
 }
 
 
@@ -109,6 +126,7 @@ void
 YDownloadProgress::setExpectedSize( YFileSize_t newSize )
 {
     priv->expectedSize = newSize;
+    markChanged();
 }
 
 
@@ -130,12 +148,21 @@ YDownloadProgress::currentPercent() const
 YFileSize_t
 YDownloadProgress::currentFileSize() const
 {
-    struct stat stat_info;
+    return YFileSizeTracker::instance()->fileSize( priv->filename );
+}
 
-    if ( stat( priv->filename.c_str(), & stat_info ) == 0 )
-	return (YFileSize_t) stat_info.st_size;
-    else
-	return 0;
+
+double
+YDownloadProgress::transferRate() const
+{
+    return YFileSizeTracker::instance()->transferRate( priv->filename );
+}
+
+
+int
+YDownloadProgress::secondsLeft() const
+{
+    return YFileSizeTracker::instance()->secondsLeft( priv->filename, priv->expectedSize );
 }
 
 
@@ -31,8 +31,13 @@
 class YDownloadProgressPrivate;
 
 /**
- * DownloadProgress: A progress bar that monitors downloading a file by
- * repeatedly polling its size up to its expected size.
+ * DownloadProgress: A progress bar that monitors downloading a file up to
+ * its expected size.
+ *
+ * The file size is obtained from the YFileSizeTracker singleton which
+ * watches the files of all download progress widgets together. UIs that
+ * want to update their progress bar only when the file size actually
+ * changed can add their own YFileSizeListener for filename() to it.
  **/
 class YDownloadProgress : public YWidget
 {
@@ -105,11 +110,24 @@ public:
      * Return the current size of the file that is being downloaded
      * or 0 if this file doesn't exist (yet).
      *
-     * This default implementation returns the 'st_size' field of a stat()
-     * system call on the file. This should be useful for most implementations.
+     * This default implementation returns the size that the
+     * YFileSizeTracker last saw for the file. This should be useful for most
+     * implementations.
      **/
     virtual YFileSize_t currentFileSize() const;
 
+    /**
+     * Return the smoothed transfer rate in bytes per second or 0 if that is
+     * not known (yet).
+     **/
+    double transferRate() const;
+
+    /**
+     * Return the estimated number of seconds until the file reaches its
+     * expected size or -1 if that is not known (yet).
+     **/
+    int secondsLeft() const;
+
     /**
      * Return the percentage (0..100) of the file being downloaded so far.
      **/
@@ -99,6 +99,7 @@ YEvent::toString( EventReason reason )
 	case SelectionChanged:		return "SelectionChanged";
 	case ValueChanged:		return "ValueChanged";
 	case ContextMenuActivated:	return "ContextMenuActivated";
+	case ItemExpanded:		return "ItemExpanded";
 
 	// Intentionally omitting "default" branch so the compiler can
 	// detect unhandled enums
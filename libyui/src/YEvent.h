@@ -65,7 +65,8 @@ public:
 	Activated,
 	SelectionChanged,
 	ValueChanged,
-	ContextMenuActivated
+	ContextMenuActivated,
+	ItemExpanded
     };
 
 
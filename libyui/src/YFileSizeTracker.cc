@@ -0,0 +1,573 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YFileSizeTracker.cc
+
+/-*/
+
+
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <set>
+#include <vector>
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
+#include "YUIException.h"
+#include "YFileSizeTracker.h"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::set;
+
+typedef std::chrono::steady_clock Clock;
+
+#define POLL_INTERVAL_MILLISEC	250
+
+// Minimum time span for one transfer rate sample. Shorter spans make the
+// rate jump around wildly since inotify reports every single write().
+#define RATE_SAMPLE_MILLISEC	500
+
+// Weight of the newest sample in the exponential moving average.
+#define RATE_SMOOTHING		0.3
+
+// A file that did not grow for this long is stalled: Its transfer rate is
+// 0 and its remaining time unknown.
+#define STALL_MILLISEC		5000
+
+#define WATCH_MASK	( IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | \
+			  IN_MOVED_FROM | IN_DELETE | IN_ATTRIB |	 \
+			  IN_DELETE_SELF | IN_MOVE_SELF )
+
+
+struct YTrackedFile
+{
+    YTrackedFile()
+	: size( 0 )
+	, wd( -1 )
+	, rate( 0.0 )
+	, sampleSize( 0 )
+	, changeTime( Clock::now() )
+	{}
+
+    string				dir;
+    string				basename;
+    YFileSize_t				size;
+    int					wd;	// -1: polled
+    vector<YFileSizeListener *>		listeners;
+    double				rate;	// bytes per second
+    YFileSize_t				sampleSize;
+    Clock::time_point			sampleTime;
+    Clock::time_point			changeTime;	// last size change
+};
+
+
+struct YFileSizeTrackerPrivate
+{
+    YFileSizeTrackerPrivate()
+	: inotifyFd( -1 )
+	, processing( false )
+	{}
+
+    int					inotifyFd;
+    bool				processing;
+    map<string, YTrackedFile>		files;
+    map<string, int>			dirWatches;	// dir -> wd
+    map<int, int>			watchRefCount;	// wd  -> number of files
+    Clock::time_point			lastPoll;
+
+    /**
+     * Watch the parent directory of 'file'. Leave its wd at -1 if that is
+     * not possible so it will be polled.
+     **/
+    void watch( YTrackedFile & file );
+
+    /**
+     * Release the directory watch of 'file' if this was the last file in
+     * that directory.
+     **/
+    void unwatch( YTrackedFile & file );
+
+    /**
+     * Forget the directory watch 'wd' that the kernel removed (or will
+     * remove) because the directory was deleted, moved or unmounted, and
+     * poll its files again. Return the names of the affected files.
+     **/
+    vector<string> dropWatch( int wd );
+
+    /**
+     * stat() 'filename' and update the cached size and transfer rate.
+     * Return 'true' if the size changed.
+     **/
+    bool update( const string & filename, YTrackedFile & file );
+
+    /**
+     * Notify all listeners of 'filename'.
+     **/
+    void notify( const string & filename );
+};
+
+
+static double
+millisecSince( Clock::time_point start, Clock::time_point now )
+{
+    return std::chrono::duration<double, std::milli>( now - start ).count();
+}
+
+
+/**
+ * Return the transfer rate of 'file' at 'now': The smoothed rate of the
+ * last sample, but without a new sample for more than one sample span it
+ * is averaged with the (lower) rate since that sample, and for a stalled
+ * file it is 0. Without inotify events for a file there are no new samples,
+ * so the rate of the last sample would otherwise remain forever.
+ **/
+static double
+currentRate( const YTrackedFile & file, Clock::time_point now )
+{
+    if ( file.rate <= 0.0 || millisecSince( file.changeTime, now ) >= STALL_MILLISEC )
+	return 0.0;
+
+    double millisec = millisecSince( file.sampleTime, now );
+
+    if ( millisec <= RATE_SAMPLE_MILLISEC )
+	return file.rate;
+
+    return ( file.rate * RATE_SAMPLE_MILLISEC + ( file.size - file.sampleSize ) * 1000.0 )
+	/ ( RATE_SAMPLE_MILLISEC + millisec );
+}
+
+
+static YFileSize_t
+statFileSize( const string & filename )
+{
+    struct stat stat_info;
+
+    if ( stat( filename.c_str(), & stat_info ) == 0 )
+	return (YFileSize_t) stat_info.st_size;
+    else
+	return 0;
+}
+
+
+void
+YFileSizeTrackerPrivate::watch( YTrackedFile & file )
+{
+    file.wd = -1;
+
+    if ( inotifyFd < 0 )
+	return;
+
+    map<string, int>::iterator it = dirWatches.find( file.dir );
+
+    if ( it != dirWatches.end() )
+    {
+	file.wd = it->second;
+    }
+    else
+    {
+	int wd = inotify_add_watch( inotifyFd, file.dir.c_str(), WATCH_MASK );
+
+	if ( wd < 0 )
+	{
+	    yuiDebug() << "Can't watch " << file.dir << ": " << strerror( errno )
+		       << " - polling" << endl;
+	    return;
+	}
+
+	file.wd = wd;
+	dirWatches[ file.dir ] = wd;
+    }
+
+    watchRefCount[ file.wd ]++;
+}
+
+
+void
+YFileSizeTrackerPrivate::unwatch( YTrackedFile & file )
+{
+    if ( file.wd < 0 )
+	return;
+
+    if ( --watchRefCount[ file.wd ] <= 0 )
+    {
+	inotify_rm_watch( inotifyFd, file.wd );
+	dirWatches.erase( file.dir );
+	watchRefCount.erase( file.wd );
+    }
+
+    file.wd = -1;
+}
+
+
+vector<string>
+YFileSizeTrackerPrivate::dropWatch( int wd )
+{
+    vector<string> filenames;
+
+    if ( watchRefCount.erase( wd ) == 0 )
+	return filenames; // Already dropped, e.g. IN_IGNORED after IN_DELETE_SELF
+
+    for ( auto & pair: files )
+    {
+	if ( pair.second.wd == wd )
+	{
+	    pair.second.wd = -1;
+	    dirWatches.erase( pair.second.dir );
+	    filenames.push_back( pair.first );
+	}
+    }
+
+    // The watch still follows a moved directory; it is gone in all other cases
+    inotify_rm_watch( inotifyFd, wd );
+
+    yuiDebug() << "Watch " << wd << " is gone - polling " << filenames.size() << " files" << endl;
+
+    return filenames;
+}
+
+
+bool
+YFileSizeTrackerPrivate::update( const string & filename, YTrackedFile & file )
+{
+    YFileSize_t newSize = statFileSize( filename );
+    Clock::time_point now = Clock::now();
+
+    if ( newSize < file.sampleSize ) // File was truncated or recreated
+    {
+	file.rate	= 0.0;
+	file.sampleSize = newSize;
+	file.sampleTime = now;
+    }
+    else
+    {
+	double millisec = millisecSince( file.sampleTime, now );
+
+	if ( millisec >= RATE_SAMPLE_MILLISEC )
+	{
+	    double sampleRate = ( newSize - file.sampleSize ) * 1000.0 / millisec;
+
+	    if ( file.rate > 0.0 )
+		file.rate = RATE_SMOOTHING * sampleRate + ( 1.0 - RATE_SMOOTHING ) * file.rate;
+	    else
+		file.rate = sampleRate;
+
+	    file.sampleSize = newSize;
+	    file.sampleTime = now;
+	}
+    }
+
+    if ( newSize == file.size )
+	return false;
+
+    file.size	    = newSize;
+    file.changeTime = now;
+
+    return true;
+}
+
+
+void
+YFileSizeTrackerPrivate::notify( const string & filename )
+{
+    map<string, YTrackedFile>::iterator it = files.find( filename );
+
+    if ( it == files.end() )
+	return;
+
+    // Copy: Listeners might remove themselves while being notified
+    vector<YFileSizeListener *> listeners = it->second.listeners;
+    YFileSize_t size = it->second.size;
+
+    for ( YFileSizeListener * listener: listeners )
+	listener->fileSizeChanged( filename, size );
+}
+
+
+
+
+YFileSizeTracker::YFileSizeTracker()
+    : priv( new YFileSizeTrackerPrivate() )
+{
+    YUI_CHECK_NEW( priv );
+
+    priv->inotifyFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+    if ( priv->inotifyFd < 0 )
+	yuiWarning() << "inotify not available: " << strerror( errno )
+		     << " - falling back to polling file sizes" << endl;
+}
+
+
+YFileSizeTracker::~YFileSizeTracker()
+{
+    if ( priv->inotifyFd >= 0 )
+	close( priv->inotifyFd );
+}
+
+
+YFileSizeTracker *
+YFileSizeTracker::instance()
+{
+    static YFileSizeTracker tracker;
+
+    return &tracker;
+}
+
+
+void
+YFileSizeTracker::addFile( const string & filename, YFileSizeListener * listener )
+{
+    if ( filename.empty() || ! listener )
+	return;
+
+    map<string, YTrackedFile>::iterator it = priv->files.find( filename );
+
+    if ( it == priv->files.end() )
+    {
+	YTrackedFile & file = priv->files[ filename ];
+	string::size_type pos = filename.rfind( '/' );
+
+	if ( pos == string::npos )
+	{
+	    file.dir	  = ".";
+	    file.basename = filename;
+	}
+	else
+	{
+	    file.dir	  = pos == 0 ? string( "/" ) : filename.substr( 0, pos );
+	    file.basename = filename.substr( pos + 1 );
+	}
+
+	priv->watch( file );
+	file.size	= statFileSize( filename );
+	file.sampleSize = file.size;
+	file.sampleTime = Clock::now();
+
+	it = priv->files.find( filename );
+    }
+
+    vector<YFileSizeListener *> & listeners = it->second.listeners;
+
+    if ( std::find( listeners.begin(), listeners.end(), listener ) == listeners.end() )
+	listeners.push_back( listener );
+}
+
+
+void
+YFileSizeTracker::removeFile( const string & filename, YFileSizeListener * listener )
+{
+    map<string, YTrackedFile>::iterator it = priv->files.find( filename );
+
+    if ( it == priv->files.end() )
+	return;
+
+    vector<YFileSizeListener *> & listeners = it->second.listeners;
+    listeners.erase( std::remove( listeners.begin(), listeners.end(), listener ),
+		     listeners.end() );
+
+    if ( listeners.empty() )
+    {
+	priv->unwatch( it->second );
+	priv->files.erase( it );
+    }
+}
+
+
+int
+YFileSizeTracker::fd() const
+{
+    return priv->inotifyFd;
+}
+
+
+bool
+YFileSizeTracker::needsPolling() const
+{
+    for ( const auto & pair: priv->files )
+    {
+	if ( pair.second.wd < 0 )
+	    return true;
+    }
+
+    return false;
+}
+
+
+int
+YFileSizeTracker::pollInterval() const
+{
+    return POLL_INTERVAL_MILLISEC;
+}
+
+
+void
+YFileSizeTracker::processEvents()
+{
+    if ( priv->processing ) // Called again from a listener
+	return;
+
+    priv->processing = true;
+
+    set<string> changed;
+    bool rescanAll = false;
+
+    if ( priv->inotifyFd >= 0 )
+    {
+	char buf[ 4096 ] __attribute__ (( aligned( __alignof__( struct inotify_event ) ) ));
+	set<std::pair<int, string> > touched; // wd, name
+	set<int> deadWatches;
+	ssize_t len;
+
+	while ( ( len = read( priv->inotifyFd, buf, sizeof( buf ) ) ) > 0 )
+	{
+	    for ( char * ptr = buf; ptr < buf + len; )
+	    {
+		const struct inotify_event * event = (const struct inotify_event *) ptr;
+		ptr += sizeof( struct inotify_event ) + event->len;
+
+		if ( event->mask & IN_Q_OVERFLOW )
+		{
+		    rescanAll = true;
+		}
+		else if ( event->mask & ( IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT ) )
+		{
+		    deadWatches.insert( event->wd );
+		}
+		else if ( event->len > 0 )
+		{
+		    touched.insert( std::make_pair( event->wd, string( event->name ) ) );
+		}
+	    }
+	}
+
+	if ( ! touched.empty() )
+	{
+	    for ( auto & pair: priv->files )
+	    {
+		YTrackedFile & file = pair.second;
+
+		if ( file.wd >= 0 &&
+		     touched.find( std::make_pair( file.wd, file.basename ) ) != touched.end() &&
+		     priv->update( pair.first, file ) )
+		{
+		    changed.insert( pair.first );
+		}
+	    }
+	}
+
+	// Fall back to polling for the files in directories that are gone;
+	// the regular poll below will try to watch them again
+
+	for ( int wd: deadWatches )
+	{
+	    for ( const string & filename: priv->dropWatch( wd ) )
+	    {
+		if ( priv->update( filename, priv->files[ filename ] ) )
+		    changed.insert( filename );
+	    }
+	}
+    }
+
+    Clock::time_point now = Clock::now();
+    bool pollDue = std::chrono::duration_cast<std::chrono::milliseconds>( now - priv->lastPoll ).count()
+	>= POLL_INTERVAL_MILLISEC;
+
+    if ( pollDue || rescanAll )
+    {
+	priv->lastPoll = now;
+
+	for ( auto & pair: priv->files )
+	{
+	    YTrackedFile & file = pair.second;
+	    bool polled = file.wd < 0;
+
+	    if ( polled )
+		priv->watch( file ); // Maybe the directory exists by now
+
+	    if ( ( polled || rescanAll ) && priv->update( pair.first, file ) )
+		changed.insert( pair.first );
+	}
+    }
+
+    for ( const string & filename: changed )
+	priv->notify( filename );
+
+    priv->processing = false;
+}
+
+
+YFileSize_t
+YFileSizeTracker::fileSize( const string & filename )
+{
+    if ( ! isTracked( filename ) )
+	return statFileSize( filename );
+
+    processEvents();
+
+    map<string, YTrackedFile>::const_iterator it = priv->files.find( filename );
+
+    return it == priv->files.end() ? 0 : it->second.size;
+}
+
+
+double
+YFileSizeTracker::transferRate( const string & filename ) const
+{
+    map<string, YTrackedFile>::const_iterator it = priv->files.find( filename );
+
+    return it == priv->files.end() ? 0.0 : currentRate( it->second, Clock::now() );
+}
+
+
+int
+YFileSizeTracker::secondsLeft( const string & filename, YFileSize_t expectedSize ) const
+{
+    map<string, YTrackedFile>::const_iterator it = priv->files.find( filename );
+
+    if ( it == priv->files.end() )
+	return -1;
+
+    const YTrackedFile & file = it->second;
+
+    if ( file.size >= expectedSize )
+	return 0;
+
+    double rate = currentRate( file, Clock::now() );
+
+    if ( rate <= 0.0 )
+	return -1;
+
+    return (int) ( ( expectedSize - file.size ) / rate + 0.5 );
+}
+
+
+bool
+YFileSizeTracker::isTracked( const string & filename ) const
+{
+    return priv->files.find( filename ) != priv->files.end();
+}
@@ -0,0 +1,163 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YFileSizeTracker.h
+
+/-*/
+
+#ifndef YFileSizeTracker_h
+#define YFileSizeTracker_h
+
+#include <string>
+
+#include "YTypes.h"
+#include "ImplPtr.h"
+
+
+class YFileSizeTrackerPrivate;
+
+
+/**
+ * Abstract base class for anything that wants to be notified by the
+ * YFileSizeTracker when the size of a file changes.
+ **/
+class YFileSizeListener
+{
+public:
+
+    virtual ~YFileSizeListener() {}
+
+    /**
+     * Notification that the size of 'filename' has changed to 'newSize'.
+     * 'newSize' is 0 if the file does not exist (any more).
+     *
+     * Derived classes are required to implement this.
+     **/
+    virtual void fileSizeChanged( const std::string & filename,
+				  YFileSize_t	      newSize ) = 0;
+};
+
+
+/**
+ * Singleton that tracks the size of any number of files, typically files
+ * that are being downloaded, on behalf of YDownloadProgress widgets.
+ *
+ * Rather than having each widget stat() its file every time its value is
+ * queried, all files are watched through one single inotify instance: The
+ * parent directory of each file is watched (so files that don't exist yet
+ * can be tracked, too), and a file is only stat()ed when inotify reports
+ * that something happened to it. If inotify is not available (or a
+ * directory cannot be watched), this falls back to polling, but with one
+ * stat() per file per poll interval for all listeners together.
+ *
+ * Listeners are only notified when the size of a file actually changes.
+ *
+ * For each file, a smoothed transfer rate and the estimated remaining
+ * time are calculated as a side effect.
+ *
+ * The tracker does not have its own thread; something needs to call
+ * processEvents() from time to time. UIs should do that when fd() becomes
+ * readable (if fd() is not -1) and from a timer with pollInterval() (if
+ * needsPolling() returns 'true').
+ **/
+class YFileSizeTracker
+{
+public:
+
+    /**
+     * Return the singleton instance. This creates it upon the first call.
+     **/
+    static YFileSizeTracker * instance();
+
+    /**
+     * Start tracking 'filename' on behalf of 'listener'.
+     * A file can have any number of listeners.
+     **/
+    void addFile( const std::string & filename, YFileSizeListener * listener );
+
+    /**
+     * Stop tracking 'filename' on behalf of 'listener'.
+     * When the last listener of a file is removed, the file is no longer
+     * tracked at all.
+     **/
+    void removeFile( const std::string & filename, YFileSizeListener * listener );
+
+    /**
+     * Return the file descriptor of the inotify instance that a UI can add
+     * to its event loop, or -1 if inotify is not available.
+     **/
+    int fd() const;
+
+    /**
+     * Return 'true' if any tracked file needs to be polled, i.e. if
+     * processEvents() should be called from a timer.
+     **/
+    bool needsPolling() const;
+
+    /**
+     * Return the poll interval in milliseconds.
+     **/
+    int pollInterval() const;
+
+    /**
+     * Read all pending inotify events, stat() the files they refer to,
+     * poll the files that can't be watched (if the poll interval has
+     * expired) and notify the listeners of all files whose size changed.
+     *
+     * This never blocks. It is safe to call this very often: Without any
+     * pending change it only costs one read() on a nonblocking file
+     * descriptor.
+     **/
+    void processEvents();
+
+    /**
+     * Return the current size of 'filename' or 0 if it doesn't exist.
+     *
+     * For tracked files this processes pending events first and then
+     * returns the cached size. For other files this simply calls stat().
+     **/
+    YFileSize_t fileSize( const std::string & filename );
+
+    /**
+     * Return the smoothed transfer rate of 'filename' in bytes per second
+     * or 0 if unknown. The rate goes down while the file does not grow, and
+     * it is 0 when the file did not grow for a few seconds.
+     **/
+    double transferRate( const std::string & filename ) const;
+
+    /**
+     * Return the estimated number of seconds until 'filename' reaches
+     * 'expectedSize' or -1 if unknown, e.g. when the download stalled.
+     **/
+    int secondsLeft( const std::string & filename, YFileSize_t expectedSize ) const;
+
+    /**
+     * Return 'true' if 'filename' is currently tracked.
+     **/
+    bool isTracked( const std::string & filename ) const;
+
+private:
+
+    YFileSizeTracker();
+    ~YFileSizeTracker();
+
+    ImplPtr<YFileSizeTrackerPrivate> priv;
+};
+
+
+#endif // YFileSizeTracker_h
@@ -62,6 +62,7 @@ YFrame::~YFrame()
 void YFrame::setLabel( const string & newLabel )
 {
     priv->label = YShortcut::cleanShortcutString( newLabel );
+    markChanged();
 }
 
 
@@ -79,6 +79,8 @@ YGraph::setFilename( const string & filename )
 {
     priv->filename = filename;
     renderGraph( filename, layoutAlgorithm() );
+
+    markChanged();
 }
 
 
@@ -94,6 +96,8 @@ YGraph::setGraph( /* graph_t */ void * graph )
 {
     priv->filename.clear();
     renderGraph( graph );
+
+    markChanged();
 }
 
 
@@ -101,6 +105,7 @@ void
 YGraph::setLayoutAlgorithm( const string & layoutAlgorithm )
 {
     priv->layoutAlgorithm = layoutAlgorithm;
+    markChanged();
 }
 
 
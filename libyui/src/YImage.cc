@@ -85,6 +85,8 @@ void YImage::setImage( const string & imageFileName, bool animated )
 {
     priv->imageFileName = imageFileName;
     priv->animated	= animated;
+
+    markChanged();
 }
 
 
@@ -98,6 +100,8 @@ void YImage::setZeroSize( YUIDimension dim, bool zeroSize )
 {
     priv->zeroSize[ dim ] = zeroSize;
     setStretchable( dim, zeroSize );
+
+    markChanged();
 }
 
 
@@ -110,4 +114,5 @@ bool YImage::autoScale() const
 void YImage::setAutoScale( bool autoScale )
 {
     priv->autoScale = autoScale;
+    markChanged();
 }
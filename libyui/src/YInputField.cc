@@ -77,6 +77,7 @@ string YInputField::label() const
 void YInputField::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -108,6 +109,7 @@ string YInputField::validChars()
 void YInputField::setValidChars( const string & newValidChars )
 {
     priv->validChars= newValidChars;
+    markChanged();
 }
 
 
@@ -120,6 +122,7 @@ int YInputField::inputMaxLength() const
 void YInputField::setInputMaxLength( int len )
 {
     priv->inputMaxLength = len;
+    markChanged();
 }
 
 
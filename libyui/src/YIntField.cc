@@ -99,6 +99,8 @@ YIntField::setMinValue( int val )
 
     if ( oldValue != newValue )
 	setValue( newValue );	// This might be expensive
+
+    markChanged();
 }
 
 
@@ -119,6 +121,8 @@ YIntField::setMaxValue( int val )
 
     if ( oldValue != newValue )
 	setValue( newValue );	// This might be expensive
+
+    markChanged();
 }
 
 
@@ -133,6 +137,7 @@ void
 YIntField::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
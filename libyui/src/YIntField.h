@@ -78,7 +78,7 @@ public:
      * outside) of this IntField. This method enforces 'val to be between
      * minValue and maxValue.
      **/
-    void setValue( int val ) { setValueInternal( enforceRange( val ) ); }
+    void setValue( int val ) { setValueInternal( enforceRange( val ) ); markChanged(); }
 
 protected:
 
@@ -109,6 +109,8 @@ void YItemSelector::setVisibleItems( int newVal )
 	newVal = 1;
 
     priv->visibleItems = newVal;
+
+    markChanged();
 }
 
 
@@ -119,6 +121,7 @@ void YItemSelector::setItemStatus( YItem * item, int status )
         YUI_CHECK_INDEX( status, -1, customStatusCount() - 1 );
         item->setStatus( status );
         updateCustomStatusIndicator( item );
+        markChanged();
 
         // Intentionally NOT calling the parent class implementation since that
         // would only store 0 or 1 as the item's status.
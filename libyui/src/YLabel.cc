@@ -84,6 +84,7 @@ string YLabel::text() const
 void YLabel::setText( const string & newText )
 {
     priv->text = newText;
+    markChanged();
 }
 
 
@@ -108,6 +109,7 @@ bool YLabel::useBoldFont() const
 void YLabel::setUseBoldFont( bool bold )
 {
     priv->useBoldFont = bold;
+    markChanged();
 }
 
 
@@ -131,6 +133,8 @@ void YLabel::setAutoWrap( bool autoWrap )
 
     setStretchable( YD_HORIZ, autoWrap );
     setStretchable( YD_VERT,  autoWrap );
+
+    markChanged();
 }
 
 
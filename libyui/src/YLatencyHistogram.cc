@@ -0,0 +1,142 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YLatencyHistogram.cc
+
+/-*/
+
+
+#include <ostream>
+
+#include "YLatencyHistogram.h"
+
+
+YLatencyHistogram::YLatencyHistogram()
+{
+    clear();
+}
+
+
+void
+YLatencyHistogram::clear()
+{
+    _count = 0;
+    _sum   = 0;
+    _min   = 0;
+    _max   = 0;
+
+    for ( int i = 0; i < BucketCount; i++ )
+	_buckets[i] = 0;
+}
+
+
+void
+YLatencyHistogram::add( long long microsec )
+{
+    if ( microsec < 0 )
+	microsec = 0;
+
+    int bucket = 0;
+
+    for ( long long val = microsec; val > 0 && bucket < BucketCount - 1; val >>= 1 )
+	bucket++;
+
+    _buckets[ bucket ]++;
+
+    if ( _count == 0 || microsec < _min )
+	_min = microsec;
+
+    if ( microsec > _max )
+	_max = microsec;
+
+    _sum += microsec;
+    _count++;
+}
+
+
+long long
+YLatencyHistogram::bucket( int bucket ) const
+{
+    if ( bucket < 0 || bucket >= BucketCount )
+	return 0;
+
+    return _buckets[ bucket ];
+}
+
+
+long long
+YLatencyHistogram::percentile( int percent ) const
+{
+    if ( _count == 0 )
+	return 0;
+
+    long long wanted = ( _count * percent + 99 ) / 100;
+    long long seen   = 0;
+
+    for ( int i = 0; i < BucketCount; i++ )
+    {
+	seen += _buckets[i];
+
+	if ( seen >= wanted && seen > 0 )
+	{
+	    long long upperLimit = ( 1LL << i ) - 1;
+
+	    return upperLimit < _max ? upperLimit : _max;
+	}
+    }
+
+    return _max;
+}
+
+
+void
+YLatencyHistogram::writeSummary( std::ostream & str ) const
+{
+    str << "count=" << _count
+	<< " min="  << min()
+	<< " avg="  << average()
+	<< " p50="  << percentile( 50 )
+	<< " p90="  << percentile( 90 )
+	<< " p99="  << percentile( 99 )
+	<< " max="  << _max;
+}
+
+
+void
+YLatencyHistogram::write( std::ostream & str ) const
+{
+    writeSummary( str );
+    str << "\n";
+
+    for ( int i = 0; i < BucketCount; i++ )
+    {
+	if ( _buckets[i] > 0 )
+	{
+	    str << "  < " << ( 1LL << i ) << " us: " << _buckets[i] << "\n";
+	}
+    }
+}
+
+
+std::ostream &
+operator<<( std::ostream & str, const YLatencyHistogram & histogram )
+{
+    histogram.writeSummary( str );
+
+    return str;
+}
@@ -0,0 +1,142 @@
+/*
+  Copyright (c) [2020] SUSE LLC
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+
+/*-/
+
+  File:		YLatencyHistogram.h
+
+/-*/
+
+#ifndef YLatencyHistogram_h
+#define YLatencyHistogram_h
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+
+/**
+ * Histogram of latencies in microseconds with logarithmic buckets:
+ * Bucket 'n' counts the samples from 2^(n-1) up to (excluding) 2^n
+ * microseconds; bucket 0 counts the samples below 1 microsecond.
+ *
+ * This is intentionally simple and cheap so it can be used to collect
+ * timings for every single UI step.
+ **/
+class YLatencyHistogram
+{
+public:
+
+    enum { BucketCount = 40 };
+
+    /**
+     * Constructor.
+     **/
+    YLatencyHistogram();
+
+    /**
+     * Add one sample.
+     **/
+    void add( long long microsec );
+
+    /**
+     * Remove all samples.
+     **/
+    void clear();
+
+    /**
+     * Number of samples.
+     **/
+    long long count() const { return _count; }
+
+    long long min() const { return _count > 0 ? _min : 0; }
+    long long max() const { return _max; }
+    long long sum() const { return _sum; }
+
+    /**
+     * Average in microseconds.
+     **/
+    long long average() const { return _count > 0 ? _sum / _count : 0; }
+
+    /**
+     * Return an approximation of the percentile 'percent' (0..100) in
+     * microseconds: The upper limit of the bucket that contains it, but
+     * never more than the maximum.
+     **/
+    long long percentile( int percent ) const;
+
+    /**
+     * Return the number of samples in bucket 'bucket'.
+     **/
+    long long bucket( int bucket ) const;
+
+    /**
+     * Write a one-line summary ("count=... min=... p50=... ...") to 'str'.
+     **/
+    void writeSummary( std::ostream & str ) const;
+
+    /**
+     * Write the summary plus all non-empty buckets, one per line, to 'str'.
+     **/
+    void write( std::ostream & str ) const;
+
+private:
+
+    long long	_count;
+    long long	_sum;
+    long long	_min;
+    long long	_max;
+    long long	_buckets[ BucketCount ];
+};
+
+
+/**
+ * Helper class to measure the time between its construction and
+ * elapsed() in microseconds.
+ **/
+class YStopWatch
+{
+public:
+
+    YStopWatch()
+	: _start( std::chrono::steady_clock::now() )
+	{}
+
+    /**
+     * Restart the stop watch.
+     **/
+    void restart() { _start = std::chrono::steady_clock::now(); }
+
+    /**
+     * Return the elapsed time since construction or the last restart()
+     * in microseconds.
+     **/
+    long long elapsed() const
+    {
+	return std::chrono::duration_cast<std::chrono::microseconds>
+	    ( std::chrono::steady_clock::now() - _start ).count();
+    }
+
+private:
+
+    std::chrono::steady_clock::time_point _start;
+};
+
+
+std::ostream & operator<<( std::ostream & str, const YLatencyHistogram & histogram );
+
+
+#endif // YLatencyHistogram_h
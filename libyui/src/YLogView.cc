@@ -84,6 +84,7 @@ void
 YLogView::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -98,6 +99,7 @@ void
 YLogView::setVisibleLines( int newVisibleLines )
 {
     priv->visibleLines = newVisibleLines;
+    markChanged();
 }
 
 
@@ -119,6 +121,8 @@ YLogView::setMaxLines( int newMaxLines )
 
     if ( linesToDelete > 0 )
 	updateDisplay();
+
+    markChanged();
 }
 
 
@@ -188,6 +192,8 @@ YLogView::appendLines( const string & newText )
     }
 
     updateDisplay();
+
+    markChanged();
 }
 
 
@@ -220,6 +226,8 @@ YLogView::clearText()
 {
     priv->logText.clear();
     updateDisplay();
+
+    markChanged();
 }
 
 
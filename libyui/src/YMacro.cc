@@ -23,9 +23,18 @@
 /-*/
 
 
+#include <stdlib.h>
+
+#define YUILogComponent "ui"
+#include "YUILog.h"
+
 #include "YMacro.h"
 #include "YMacroRecorder.h"
 #include "YMacroPlayer.h"
+#include "YBinaryMacro.h"
+
+#define ENV_MACRO_RECORD	"YUI_MACRO_RECORD"
+#define ENV_MACRO_PLAY		"YUI_MACRO_PLAY"
 
 using std::string;
 
@@ -98,10 +107,67 @@ bool YMacro::playing()
 }
 
 
+// Only the binary recorder and player are driven by libyui itself; the
+// others (like the YCP / Ruby UI interpreter) are driven from the outside.
+// Dispatching here instead of with new virtual functions in YMacroRecorder
+// and YMacroPlayer keeps their vtables unchanged.
+
+void YMacro::recordEvent( YDialog * dialog, YEvent * event )
+{
+    YBinaryMacroRecorder * recorder = dynamic_cast<YBinaryMacroRecorder *>( _recorder );
+
+    if ( recorder && recorder->recording() )
+	recorder->recordEvent( dialog, event );
+}
+
+
+YEvent * YMacro::playNextEvent( YDialog * dialog )
+{
+    YBinaryMacroPlayer * player = dynamic_cast<YBinaryMacroPlayer *>( _player );
+
+    if ( player && player->playing() )
+	return player->playNextEvent( dialog );
+    else
+	return 0;
+}
+
+
+void YMacro::recordTiming( const char * phase, long long microsec )
+{
+    YBinaryMacroPlayer * player = dynamic_cast<YBinaryMacroPlayer *>( _player );
+
+    if ( player && player->playing() )
+	player->recordTiming( phase, microsec );
+}
+
+
+void YMacro::setupFromEnvironment()
+{
+    const char * recordFile = getenv( ENV_MACRO_RECORD );
+    const char * playFile   = getenv( ENV_MACRO_PLAY   );
+
+    if ( recordFile && *recordFile && ! _recorder )
+    {
+	yuiMilestone() << "Recording macro to " << recordFile << endl;
+	setRecorder( new YBinaryMacroRecorder() );
+	record( recordFile );
+    }
+
+    if ( playFile && *playFile && ! _player )
+    {
+	yuiMilestone() << "Playing macro " << playFile << endl;
+	setPlayer( new YBinaryMacroPlayer() );
+	play( playFile );
+    }
+}
+
+
 void YMacro::deleteRecorder()
 {
     if ( _recorder )
 	delete _recorder;
+
+    _recorder = 0;
 }
 
 
@@ -109,4 +175,6 @@ void YMacro::deletePlayer()
 {
     if ( _player )
 	delete _player;
+
+    _player = 0;
 }
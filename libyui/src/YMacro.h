@@ -29,6 +29,8 @@
 
 class YMacroRecorder;
 class YMacroPlayer;
+class YDialog;
+class YEvent;
 
 
 /**
@@ -95,6 +97,34 @@ public:
      **/
     static bool playing();
 
+    /**
+     * Record the user input of 'dialog' and 'event' if a macro is currently
+     * being recorded. This is called from YDialog::waitForEvent().
+     **/
+    static void recordEvent( YDialog * dialog, YEvent * event );
+
+    /**
+     * Play the next block of the current macro for 'dialog' and return the
+     * event from that block, or 0 if no macro is being played or the
+     * player doesn't provide events. This is called from
+     * YDialog::waitForEvent().
+     **/
+    static YEvent * playNextEvent( YDialog * dialog );
+
+    /**
+     * Record the time spent in UI step 'phase' if a macro is currently being
+     * played. Callers should check playing() before measuring anything.
+     **/
+    static void recordTiming( const char * phase, long long microsec );
+
+    /**
+     * Set up the built-in binary macro recorder or player if one of the
+     * environment variables YUI_MACRO_RECORD or YUI_MACRO_PLAY contains a
+     * macro file name, and start recording or playing it. This does nothing
+     * if a recorder or player is already set.
+     **/
+    static void setupFromEnvironment();
+
     /**
      * Return the current macro recorder or 0 if there is none.
      **/
@@ -112,6 +112,8 @@ YMenuWidget::setItemEnabled( YMenuItem * item, bool enabled )
 {
     if ( item )
         item->setEnabled( enabled );
+
+    markChanged();
 }
 
 
@@ -120,6 +122,8 @@ YMenuWidget::setItemVisible( YMenuItem * item, bool visible )
 {
     if ( item )
         item->setVisible( visible );
+
+    markChanged();
 }
 
 
@@ -77,6 +77,7 @@ string YMultiLineEdit::label() const
 void YMultiLineEdit::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -89,6 +90,7 @@ int YMultiLineEdit::inputMaxLength() const
 void YMultiLineEdit::setInputMaxLength( int len )
 {
     priv->inputMaxLength = len;
+    markChanged();
 }
 
 
@@ -101,6 +103,7 @@ int YMultiLineEdit::defaultVisibleLines() const
 void YMultiLineEdit::setDefaultVisibleLines( int newVisibleLines )
 {
     priv->defaultVisibleLines = newVisibleLines;
+    markChanged();
 }
 
 
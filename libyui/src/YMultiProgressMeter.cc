@@ -125,6 +125,8 @@ void YMultiProgressMeter::setCurrentValue( int segment, float value )
 	value = maxValue( segment );
 
     priv->currentValues[ segment ] = value;
+
+    markChanged();
 }
 
 
@@ -80,6 +80,7 @@ string YProgressBar::label()
 void YProgressBar::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -104,6 +105,8 @@ void YProgressBar::setValue( int newValue )
 	newValue = priv->maxValue;
 
     priv->value = newValue;
+
+    markChanged();
 }
 
 
@@ -80,6 +80,7 @@ YPushButton::~YPushButton()
 void YPushButton::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
@@ -121,6 +122,8 @@ void YPushButton::setDefaultButton( bool isDefaultButton )
 
 	priv->setDefaultButtonRecursive = false;
     }
+
+    markChanged();
 }
 
 
@@ -134,6 +137,8 @@ void YPushButton::setHelpButton( bool helpButton )
 {
     priv->isHelpButton = helpButton;
     priv->role = YHelpButton;
+
+    markChanged();
 }
 
 bool YPushButton::isRelNotesButton() const
@@ -146,6 +151,8 @@ void YPushButton::setRelNotesButton( bool relNotesButton )
 {
     priv->isRelNotesButton = relNotesButton;
     priv->role = YRelNotesButton;
+
+    markChanged();
 }
 
 /* setRole can try to guess function key, but only if there isn't a selected
@@ -88,6 +88,7 @@ YRadioButton::~YRadioButton()
 void YRadioButton::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    markChanged();
 }
 
 
@@ -106,6 +107,7 @@ bool YRadioButton::useBoldFont() const
 void YRadioButton::setUseBoldFont( bool bold )
 {
     priv->useBoldFont = bold;
+    markChanged();
 }
 
 
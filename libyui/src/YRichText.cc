@@ -74,6 +74,7 @@ YRichText::~YRichText()
 void YRichText::setValue( const string & newValue )
 {
     priv->text = newValue;
+    markChanged();
 }
 
 
@@ -92,6 +93,7 @@ bool YRichText::plainTextMode() const
 void YRichText::setPlainTextMode( bool plainTextMode )
 {
     priv->plainTextMode = plainTextMode;
+    markChanged();
 }
 
 
@@ -104,6 +106,7 @@ bool YRichText::autoScrollDown() const
 void YRichText::setAutoScrollDown( bool autoScrollDown )
 {
     priv->autoScrollDown = autoScrollDown;
+    markChanged();
 }
 
 
@@ -89,6 +89,8 @@ void YSelectionBox::setImmediateMode( bool immediateMode )
 
     if ( immediateMode )
 	setNotify( true );
+
+    markChanged();
 }
 
 
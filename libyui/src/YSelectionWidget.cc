@@ -93,6 +93,7 @@ void YSelectionWidget::deleteAllItems()
     }
 
     priv->itemCollection.clear();
+    markChanged();
 }
 
 
@@ -105,6 +106,7 @@ string YSelectionWidget::label() const
 void YSelectionWidget::setLabel( const string & newLabel )
 {
     priv->label = newLabel;
+    markChanged();
 }
 
 
@@ -150,6 +152,7 @@ void YSelectionWidget::setShortcutString( const std::string & str )
 void YSelectionWidget::setIconBasePath( const string & basePath )
 {
     priv->iconBasePath = basePath;
+    markChanged();
 }
 
 
@@ -249,6 +252,8 @@ void YSelectionWidget::addItem( YItem * item )
                 item->setSelected( true );
         }
     }
+
+    markChanged();
 }
 
 
@@ -445,6 +450,8 @@ void YSelectionWidget::selectItem( YItem * item, bool selected )
     }
 
     item->setSelected( selected );
+
+    markChanged();
 }
 
 
@@ -491,6 +498,7 @@ YSelectionWidget::itemsContain( YItem *			wantedItem,
 void YSelectionWidget::deselectAllItems()
 {
     deselectAllItems( itemsBegin(), itemsEnd() );
+    markChanged();
 }
 
 
@@ -70,6 +70,7 @@ string YSimpleInputField::label() const
 void YSimpleInputField::setLabel( const string & label )
 {
     priv->label = label;
+    markChanged();
 }
 
 
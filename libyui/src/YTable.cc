@@ -80,6 +80,8 @@ YTable::setTableHeader( YTableHeader * newHeader )
 
     delete priv->header;
     priv->header = newHeader;
+
+    markChanged();
 }
 
 
@@ -125,6 +127,8 @@ YTable::setImmediateMode( bool immediateMode )
 
     if ( immediateMode )
 	setNotify( true );
+
+    markChanged();
 }
 
 
@@ -139,6 +143,7 @@ void
 YTable::setKeepSorting( bool keepSorting )
 {
     priv->keepSorting = keepSorting;
+    markChanged();
 }
 
 
@@ -39,9 +39,13 @@ struct YTreePrivate
 {
     YTreePrivate()
 	: immediateMode( false )
+	, expandedItem( 0 )
+	, loadedItem( 0 )
 	{}
 
-    bool immediateMode;
+    bool	immediateMode;
+    YTreeItem * expandedItem;
+    YTreeItem * loadedItem;
 };
 
 
@@ -81,6 +85,8 @@ YTree::setImmediateMode( bool immediateMode )
 
     if ( immediateMode )
 	setNotify( true );
+
+    markChanged();
 }
 
 
@@ -92,6 +98,44 @@ YTree::addItems( const YItemCollection & itemCollection )
 }
 
 
+void
+YTree::deleteAllItems()
+{
+    priv->expandedItem = 0;
+    YSelectionWidget::deleteAllItems();
+}
+
+
+YTreeItem *
+YTree::expandedItem() const
+{
+    return priv->expandedItem;
+}
+
+
+void
+YTree::setExpandedItem( YTreeItem * item )
+{
+    priv->expandedItem = item;
+}
+
+
+void
+YTree::childrenLoaded( YTreeItem * item )
+{
+    priv->loadedItem = item;
+    rebuildTree();
+    priv->loadedItem = 0;
+}
+
+
+YTreeItem *
+YTree::loadedItem() const
+{
+    return priv->loadedItem;
+}
+
+
 const YPropertySet &
 YTree::propertySet()
 {
@@ -101,6 +101,35 @@ public:
      **/
     virtual void addItems( const YItemCollection & itemCollection );
 
+    /**
+     * Delete all items.
+     *
+     * Derived classes can overwrite this function, but they should call this
+     * base class function in the new implementation.
+     *
+     * Reimplemented from YSelectionWidget.
+     **/
+    virtual void deleteAllItems();
+
+    /**
+     * Return the item with lazy children (see YTreeItem::hasLazyChildren())
+     * that the user opened last, i.e. the item that the last
+     * YEvent::ItemExpanded event of this tree is about, or 0 if there is
+     * none.
+     **/
+    YTreeItem * expandedItem() const;
+
+    /**
+     * Notify the tree that the application added the children of 'item'
+     * after a YEvent::ItemExpanded event. If the application found that there
+     * are no children, it should call item->setLazyChildren( false ) and
+     * then this function so the UI no longer shows the item as a branch.
+     *
+     * This calls rebuildTree(). During that call, loadedItem() returns
+     * 'item', so derived classes can only add the new children.
+     **/
+    void childrenLoaded( YTreeItem * item );
+
     /**
      * Deliver even more events than with notify() set.
      *
@@ -197,6 +226,18 @@ public:
 
 protected:
 
+    /**
+     * Set the item for expandedItem(). Derived classes call this before they
+     * send a YEvent::ItemExpanded event.
+     **/
+    void setExpandedItem( YTreeItem * item );
+
+    /**
+     * Return the item whose children the application just added while
+     * rebuildTree() is called from childrenLoaded(), and 0 otherwise.
+     **/
+    YTreeItem * loadedItem() const;
+
     /**
      * Recursively search the items between item iterators 'begin' and 'end'
      * for a path specified in a string vector between 'path_begin' and
@@ -32,6 +32,7 @@ YTreeItem::YTreeItem( const string &	label,
     : YItem( label )
     , _parent( 0 )
     , _isOpen( isOpen )
+    , _lazyChildren( false )
 {
 }
 
@@ -42,6 +43,7 @@ YTreeItem::YTreeItem( const string &	label,
     : YItem( label, iconName )
     , _parent( 0 )
     , _isOpen( isOpen )
+    , _lazyChildren( false )
 {
 }
 
@@ -52,6 +54,7 @@ YTreeItem::YTreeItem( YTreeItem *	parent,
     : YItem( label )
     , _parent( parent )
     , _isOpen( isOpen )
+    , _lazyChildren( false )
 {
     if ( parent )
 	parent->addChild( this );
@@ -65,6 +68,7 @@ YTreeItem::YTreeItem( YTreeItem *	parent,
     : YItem( label, iconName )
     , _parent( parent )
     , _isOpen( isOpen )
+    , _lazyChildren( false )
 {
     if ( parent )
 	parent->addChild( this );
@@ -80,6 +84,7 @@ YTreeItem::~YTreeItem()
 void YTreeItem::addChild( YItem * child )
 {
     _children.push_back( child );
+    _lazyChildren = false;
 }
 
 
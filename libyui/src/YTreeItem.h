@@ -126,6 +126,25 @@ public:
     void setOpen( bool open = true );
     void setClosed() { setOpen( false ); }
 
+    /**
+     * Return 'true' if this item has child items that the application did
+     * not create yet.
+     *
+     * The UI shows such an item as a closed branch even though it has no
+     * children. When the user opens it, the tree sends a YWidgetEvent with
+     * reason YEvent::ItemExpanded; the application then adds the children
+     * and calls YTree::childrenLoaded(). This way, huge trees only need the
+     * items the user actually looks at.
+     *
+     * Adding a child item resets this flag.
+     **/
+    bool hasLazyChildren() const { return _lazyChildren; }
+
+    /**
+     * Change the 'hasLazyChildren' flag. See hasLazyChildren().
+     **/
+    void setLazyChildren( bool lazy = true ) { _lazyChildren = lazy; }
+
     /**
      * Returns this item's parent item or 0 if it is a toplevel item.
      *
@@ -138,6 +157,7 @@ private:
     YTreeItem *		_parent;
     YItemCollection	_children;
     bool 		_isOpen;
+    bool		_lazyChildren;
 };
 
 
@@ -61,6 +61,16 @@ using std::stack;
 // (set to "KDE" or "GNOME" - case insensitive)
 #define ENV_BUTTON_ORDER "Y2_BUTTON_ORDER"
 
+// Max. number of consecutive commands from the YCP thread that are handled
+// without going back to idleLoop()
+#define MAX_BATCHED_COMMANDS	32
+
+// Statistics of the UI thread, see YUI::uiThreadWakeups() and
+// YUI::uiThreadCommands(). There is only one YUI instance; keeping them here
+// instead of in the class keeps its layout compatible for the UI plug-ins.
+static int uiThreadWakeupCount	= 0;
+static int uiThreadCommandCount = 0;
+
 // Keep dialog stack before the YUITerminator
 // so that it is destroyed afterwards.
 // YUITerminator deletes _yui which calls YUI::~YUI
@@ -184,6 +194,7 @@ void YUI::ensureUICreated()
 	YUI_THROW( YUIException( "UI already deleted" ) );
 
     YUILoader::loadUI();
+    YMacro::setupFromEnvironment();
 }
 
 
@@ -358,26 +369,58 @@ bool YUI::waitForYCPThread()
 }
 
 
+bool YUI::pollYCPThread()
+{
+    char arbitrary;
+
+    // pipe_to_ui[0] is non-blocking, so this returns immediately with
+    // EAGAIN if the YCP thread has not sent the next command yet.
+
+    return read( pipe_to_ui[0], & arbitrary, 1 ) == 1;
+}
+
+
+int YUI::uiThreadWakeups() const
+{
+    return uiThreadWakeupCount;
+}
+
+
+int YUI::uiThreadCommands() const
+{
+    return uiThreadCommandCount;
+}
+
+
 void YUI::uiThreadMainLoop()
 {
+    int batched = 0;
+
     while ( true )
     {
-	idleLoop( pipe_to_ui[0] );
+	if ( batched == 0 )
+	{
+	    idleLoop( pipe_to_ui[0] );
 
-	// The pipe is non-blocking, so we have to check if we really read a
-	// signal byte. Although idleLoop already does a select(), this seems to
-	// be necessary.  Anyway: Why do we set the pipe to non-blocking if we
-	// wait in idleLoop for it to become readable? It is needed in
-	// YUIQt::idleLoop for QSocketNotifier.
+	    // The pipe is non-blocking, so we have to check if we really read a
+	    // signal byte. Although idleLoop already does a select(), this seems to
+	    // be necessary.  Anyway: Why do we set the pipe to non-blocking if we
+	    // wait in idleLoop for it to become readable? It is needed in
+	    // YUIQt::idleLoop for QSocketNotifier.
 
-	if ( ! waitForYCPThread () )
-	    continue;
+	    if ( ! waitForYCPThread () )
+		continue;
+
+	    uiThreadWakeupCount++;
+	}
 
 	if ( _terminate_ui_thread )
 	{
 	    uiThreadDestructor();
 	    signalYCPThread();
 	    yuiDebug() << "Shutting down UI main loop" << endl;
+	    yuiDebug() << uiThreadCommandCount << " commands in "
+		       << uiThreadWakeupCount << " wakeups" << endl;
 	    return;
 	}
 
@@ -386,7 +429,18 @@ void YUI::uiThreadMainLoop()
 	else
 	    yuiError() << "No builtinCaller set" << endl;
 
+	uiThreadCommandCount++;
 	signalYCPThread();
+
+	// If the YCP thread already sent the next command, handle it right
+	// away without going through idleLoop() again. Limit that so the UI
+	// still gets to process its own events (repaints etc.) under heavy
+	// traffic.
+
+	if ( ++batched < MAX_BATCHED_COMMANDS && pollYCPThread() )
+	    continue;
+
+	batched = 0;
     }
 }
 
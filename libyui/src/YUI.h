@@ -206,6 +206,19 @@ public:
      **/
     void uiThreadMainLoop();
 
+    /**
+     * Return the number of times the UI thread was woken up from idleLoop()
+     * to handle commands from the YCP thread.
+     **/
+    int uiThreadWakeups() const;
+
+    /**
+     * Return the number of commands from the YCP thread the UI thread
+     * handled. If this is higher than uiThreadWakeups(), several commands
+     * were handled per wakeup.
+     **/
+    int uiThreadCommands() const;
+
     /**
      * Return the transparent inter-thread communication.
      * This will return 0 until set from the outside.
@@ -304,6 +317,13 @@ protected:
      **/
     bool waitForYCPThread();
 
+    /**
+     * Read one byte from the ycp thread if it is already available.
+     * Unlike waitForYCPThread(), this never waits.
+     * Returns 'true' if a byte was read.
+     **/
+    bool pollYCPThread();
+
     /**
      * Set the button order (in YButtonBox widgets) from environment
      * variables:
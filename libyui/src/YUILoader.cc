@@ -24,8 +24,11 @@
 
 #include <stdlib.h>		// getenv()
 #include <unistd.h>		// isatty()a
-#include <sys/stat.h>
 #include <string.h>
+#include <dlfcn.h>
+
+#include <thread>
+#include <vector>
 
 #define YUILogComponent "ui"
 #include "YUILog.h"
@@ -33,23 +36,160 @@
 #include "YUILoader.h"
 #include "YUIPlugin.h"
 #include "YUIException.h"
-#include "YPath.h"
 #include "YSettings.h"
+#include "YLatencyHistogram.h"	// YStopWatch
 
 #include "Libyui_config.h"
 
 using std::string;
+using std::vector;
 
 
 bool rest_enabled()
 {
     const char *env = getenv("YUI_HTTP_PORT");
-    return env && atoi(env) > 0;
+    const char *socket = getenv("YUI_HTTP_SOCKET");
+    return ( env && atoi(env) > 0 ) || ( socket && *socket );
 }
 
 
-void YUILoader::loadUI( bool withThreads )
+namespace
 {
+    /**
+     * A plugin library that preloadUI() loaded in the background.
+     **/
+    struct PreloadedPlugin
+    {
+	string	    name;
+	string	    path;
+	void *	    handle;
+	long long   usec;
+	string	    errorMsg;
+    };
+
+    bool		    preloadStarted = false;
+    std::thread		    preloadThread;
+    vector<PreloadedPlugin> preloadedPlugins;
+
+
+    /**
+     * Wait for the preloading thread, if there is one, and log its results.
+     **/
+    void finishPreloading()
+    {
+	if ( ! preloadThread.joinable() )
+	    return;
+
+	YStopWatch stopWatch;
+	preloadThread.join();
+
+	yuiMilestone() << "Waited " << stopWatch.elapsed() / 1000.0
+		       << " ms for preloading the UI plugins" << endl;
+
+	for ( const PreloadedPlugin & plugin: preloadedPlugins )
+	{
+	    if ( plugin.handle )
+		yuiMilestone() << "Preloaded UI plugin \"" << plugin.name << "\" in "
+			       << plugin.usec / 1000.0 << " ms" << endl;
+	    else
+		yuiWarning() << "Preloading UI plugin \"" << plugin.name << "\" failed: "
+			     << plugin.errorMsg << endl;
+	}
+    }
+
+
+    /**
+     * Drop the references to the preloaded plugins once the UI plugins are
+     * loaded for real: The plugins that are in use stay loaded, the others
+     * (if loading the wanted UI failed) are unloaded.
+     **/
+    struct PreloadedPluginsReleaser
+    {
+	~PreloadedPluginsReleaser()
+	{
+	    finishPreloading();
+
+	    for ( PreloadedPlugin & plugin: preloadedPlugins )
+	    {
+		if ( plugin.handle )
+		    dlclose( plugin.handle );
+	    }
+
+	    preloadedPlugins.clear();
+	}
+    };
+}
+
+
+void YUILoader::preloadUI()
+{
+    if ( preloadStarted || YUI::_ui )
+	return;
+
+    preloadStarted = true;
+
+    string wantedGUI = pickUIPlugin();
+
+    if ( wantedGUI.empty() )
+	return;
+
+    vector<string> names;
+
+    if ( rest_enabled() && wantedGUI != YUIPlugin_Gtk )
+    {
+	names.push_back( YUIPlugin_RestAPI );
+	names.push_back( wantedGUI );
+	names.push_back( wantedGUI == YUIPlugin_Qt ? YUIPlugin_Qt_RestAPI : YUIPlugin_Ncurses_RestAPI );
+    }
+    else
+    {
+	names.push_back( wantedGUI );
+    }
+
+    // Look up the plugins here: The logging is not safe to use for the first
+    // time in another thread, so the thread doesn't log anything.
+
+    for ( const string & name: names )
+    {
+	if ( pluginExists( name ) )
+	    preloadedPlugins.push_back( { name, YUIPlugin::pluginLibFullPath( name ), 0, 0, "" } );
+    }
+
+    yuiMilestone() << "Preloading " << preloadedPlugins.size() << " UI plugins" << endl;
+
+    // In case the application exits without ever using the UI
+    atexit( finishPreloading );
+
+    // Loading the plugins with lazy binding maps them and their dependencies
+    // and runs their static initializers while the application is still
+    // busy with its own initialization; loadPlugin() then only has to
+    // resolve the remaining symbols.
+
+    preloadThread = std::thread( []()
+	{
+	    for ( PreloadedPlugin & plugin: preloadedPlugins )
+	    {
+		YStopWatch stopWatch;
+		plugin.handle = dlopen( plugin.path.c_str(), RTLD_LAZY | RTLD_GLOBAL );
+		plugin.usec   = stopWatch.elapsed();
+
+		if ( ! plugin.handle )
+		    plugin.errorMsg = dlerror();
+	    }
+	} );
+}
+
+
+string YUILoader::pickUIPlugin()
+{
+    static bool	  picked = false;
+    static string pickedGUI;
+
+    if ( picked )
+	return pickedGUI;
+
+    picked = true;
+
     bool isGtk = false;
     const char * envDesktop    = getenv( "XDG_CURRENT_DESKTOP" )  ?: "";
     const char * envDisplay    = getenv( "DISPLAY" )              ?: "";
@@ -96,7 +236,6 @@ void YUILoader::loadUI( bool withThreads )
     yuiMilestone() << "User-selected UI-plugin: \"" << wantedGUI << "\"" << endl;
 
     bool haveGtk     = pluginExists( YUIPlugin_Gtk );
-    bool haveNcurses = pluginExists( YUIPlugin_NCurses );
     bool haveQt      = pluginExists( YUIPlugin_Qt );
 
     // This reset is intentional, so the loader can work it's magic
@@ -116,12 +255,28 @@ void YUILoader::loadUI( bool withThreads )
 	    wantedGUI = YUIPlugin_Gtk;
     }
 
-    else if ( haveNcurses && isatty( STDOUT_FILENO ) )
+    else if ( pluginExists( YUIPlugin_NCurses ) && isatty( STDOUT_FILENO ) )
     {
 	// We use NCurses.
 	wantedGUI = YUIPlugin_NCurses;
     }
 
+    pickedGUI = wantedGUI;
+
+    return pickedGUI;
+}
+
+
+void YUILoader::loadUI( bool withThreads )
+{
+    YStopWatch stopWatch;
+    string wantedGUI = pickUIPlugin();
+
+    yuiMilestone() << "Selected the UI plugin in " << stopWatch.elapsed() / 1000.0 << " ms" << endl;
+
+    PreloadedPluginsReleaser releaser;
+    finishPreloading();
+
     // Load the wanted UI-plugin.
     if ( wantedGUI != "" )
     {
@@ -150,7 +305,7 @@ void YUILoader::loadUI( bool withThreads )
 	    YUI_CAUGHT( ex );
 
 	    // Default to NCurses, if possible.
-	    if ( wantedGUI != YUIPlugin_NCurses && haveNcurses && isatty( STDOUT_FILENO ) )
+	    if ( wantedGUI != YUIPlugin_NCurses && pluginExists( YUIPlugin_NCurses ) && isatty( STDOUT_FILENO ) )
 	    {
 		yuiWarning () << "Defaulting to: \"" << YUIPlugin_NCurses << "\""<< endl;
 		YSettings::loadedUI( YUIPlugin_NCurses, true );
@@ -217,7 +372,11 @@ void YUILoader::loadRestAPIPlugin( const string & wantedGUI, bool withThreads )
 
         if ( createUI )
         {
+            YStopWatch stopWatch;
             YUI * ui = createUI( withThreads );
+
+            yuiMilestone() << "Created the UI in " << stopWatch.elapsed() / 1000.0 << " ms" << endl;
+
             // Same as in loadPlugin
             atexit(deleteUI);
 
@@ -257,8 +416,11 @@ void YUILoader::loadPlugin( const string & name, bool withThreads )
 
 	if ( createUI )
 	{
+	    YStopWatch stopWatch;
 	    YUI * ui = createUI( withThreads ); // no threads
 
+	    yuiMilestone() << "Created the UI in " << stopWatch.elapsed() / 1000.0 << " ms" << endl;
+
             // At this point the concrete UI will have loaded its own
             // internal plugins and registered their destructors.
             // Our destructor must get called before those get dlclose'd.
@@ -328,17 +490,5 @@ void YUILoader::loadExternalWidgets ( const string& name, const string& symbol )
 
 bool YUILoader::pluginExists( const string & pluginBaseName )
 {
-    struct stat fileinfo;
-    string pluginName = PLUGIN_PREFIX;
-
-    pluginName.append( pluginBaseName );
-    pluginName.append( PLUGIN_SUFFIX );
-
-    YPath plugin( PLUGINDIR, pluginName );
-    bool success = stat( plugin.path().c_str(), &fileinfo) == 0;
-
-    yuiDebug() << "UI plugin " << PLUGINDIR << "/" << pluginName
-               << ( success ? " exists" : " does not exist" ) << endl;
-
-    return success;
+    return YUIPlugin::pluginExists( pluginBaseName );
 }
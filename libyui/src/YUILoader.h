@@ -91,6 +91,16 @@ public:
      **/
     static void loadUI( bool withThreads = false );
 
+    /**
+     * Start loading the UI plugins that loadUI() will pick in a background
+     * thread, so that happens while the application does its own
+     * initialization. loadUI() waits for that thread.
+     *
+     * This is optional; call it as early as possible, and only once. The
+     * time each phase of loading the UI takes is logged.
+     **/
+    static void preloadUI();
+
     /**
      * This will make sure the UI singleton is deleted.
      * If the UI is already destroyed, it will do nothing. If
@@ -141,6 +151,12 @@ private:
     YUILoader()  {}
     ~YUILoader() {}
 
+    /**
+     * Pick the UI plugin to use as described in loadUI(). Returns an empty
+     * string if there is none. The result is cached.
+     **/
+    static std::string pickUIPlugin();
+
     /**
      * Used by loadExternalWidgets to load the graphical plugin specialization.
      *
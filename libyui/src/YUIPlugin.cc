@@ -24,24 +24,67 @@
 
 
 #include <dlfcn.h>
+#include <sys/stat.h>
+
+#include <map>
 
 #define YUILogComponent "ui"
 #include "YUILog.h"
 
 #include "YUIPlugin.h"
 #include "YPath.h"
+#include "YLatencyHistogram.h"	// YStopWatch
 
 #include "Libyui_config.h"
 
 using std::string;
 
 
+namespace
+{
+    struct PluginLocation
+    {
+	string path;
+	bool   exists;
+    };
+
+    // plugin base name -> location
+    std::map<string, PluginLocation> pluginLocations;
+
+
+    const PluginLocation & locatePlugin( const string & pluginLibBaseName )
+    {
+	auto it = pluginLocations.find( pluginLibBaseName );
+
+	if ( it != pluginLocations.end() )
+	    return it->second;
+
+	string pluginName = PLUGIN_PREFIX;
+	pluginName.append( pluginLibBaseName );
+	pluginName.append( PLUGIN_SUFFIX );
+
+	YPath plugin( PLUGINDIR, pluginName );
+	struct stat fileinfo;
+
+	PluginLocation location;
+	location.path	= plugin.path();
+	location.exists = stat( location.path.c_str(), &fileinfo ) == 0;
+
+	yuiDebug() << "UI plugin " << PLUGINDIR << "/" << pluginName
+		   << ( location.exists ? " exists" : " does not exist" ) << endl;
+
+	return pluginLocations[ pluginLibBaseName ] = location;
+    }
+}
+
+
 
 YUIPlugin::YUIPlugin( const char * pluginLibBaseName )
 {
     _pluginLibBaseName = string( pluginLibBaseName );
 
     string pluginFilename = pluginLibFullPath();
+    YStopWatch stopWatch;
 
     _pluginLibHandle = dlopen( pluginFilename.c_str(),
 			       RTLD_NOW | RTLD_GLOBAL);
@@ -54,6 +97,11 @@ YUIPlugin::YUIPlugin( const char * pluginLibBaseName )
 		   << "\": " << _errorMsg
 		   << endl;
     }
+    else
+    {
+	yuiMilestone() << "Loaded UI plugin \"" << pluginLibBaseName << "\" in "
+		       << stopWatch.elapsed() / 1000.0 << " ms" << endl;
+    }
 }
 
 
@@ -75,14 +123,21 @@ YUIPlugin::unload()
 string
 YUIPlugin::pluginLibFullPath() const
 {
+    return pluginLibFullPath( _pluginLibBaseName );
+}
+
 
-    string pluginName = PLUGIN_PREFIX;
-    pluginName.append( _pluginLibBaseName );
-    pluginName.append( PLUGIN_SUFFIX );
+string
+YUIPlugin::pluginLibFullPath( const string & pluginLibBaseName )
+{
+    return locatePlugin( pluginLibBaseName ).path;
+}
 
-    YPath plugin( PLUGINDIR, pluginName );
 
-    return plugin.path();
+bool
+YUIPlugin::pluginExists( const string & pluginLibBaseName )
+{
+    return locatePlugin( pluginLibBaseName ).exists;
 }
 
 
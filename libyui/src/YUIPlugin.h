@@ -83,6 +83,21 @@ public:
      **/
     std::string errorMsg() const;
 
+    /**
+     * Returns the full path of the plugin library with base name
+     * 'pluginLibBaseName' (e.g. "qt") in the standard UI plugin directory.
+     *
+     * Looking up a plugin means reading the plugin directory, so the result
+     * is cached for the lifetime of the process.
+     **/
+    static std::string pluginLibFullPath( const std::string & pluginLibBaseName );
+
+    /**
+     * Returns 'true' if the plugin library with base name 'pluginLibBaseName'
+     * exists. This is cached like pluginLibFullPath().
+     **/
+    static bool pluginExists( const std::string & pluginLibBaseName );
+
 protected:
 
     /**
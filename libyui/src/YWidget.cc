@@ -70,6 +70,8 @@ struct YWidgetPrivate
 	, toolkitWidgetRep( 0 )
 	, id( 0 )
 	, functionKey( 0 )
+	, changeVersion( 0 )
+	, dialog( 0 )
     {
 	stretch.hor	= false;
 	stretch.vert	= false;
@@ -95,6 +97,8 @@ struct YWidgetPrivate
     YBothDim<int>		weight;
     int				functionKey;
     string			helpText;
+    unsigned long		changeVersion;
+    YDialog *			dialog;		// cached findDialog() result
 };
 
 
@@ -184,6 +188,11 @@ YWidget::addChild( YWidget * child )
 #endif
 
     childrenManager()->add( child );
+
+    markChanged();
+
+    if ( child )
+	child->markChanged();
 }
 
 
@@ -194,6 +203,13 @@ YWidget::removeChild( YWidget * child )
     {
 	// yuiDebug() << "Removing " << child << " from " << this << endl;
 	childrenManager()->remove( child );
+
+	// Clients can't tell a removed widget from an unchanged one by
+	// looking at the change versions of the remaining widgets
+	YDialog * dialog = findDialog();
+
+	if ( dialog )
+	    dialog->markAllChanged();
     }
 }
 
@@ -294,6 +310,7 @@ YWidget::setParent( YWidget * newParent )
     }
 
     priv->parent = newParent;
+    priv->dialog = 0;
 }
 
 
@@ -336,6 +353,7 @@ bool YWidget::hasFunctionKey() const
 void YWidget::setFunctionKey( int fkey_no )
 {
     priv->functionKey = fkey_no;
+    markChanged();
 }
 
 
@@ -348,6 +366,7 @@ string YWidget::helpText() const
 void YWidget::setHelpText( const string & helpText )
 {
     priv->helpText = helpText;
+    markChanged();
 }
 
 
@@ -364,6 +383,8 @@ void YWidget::setId( YWidgetID * newId )
 	delete priv->id;
 
     priv->id = newId;
+
+    markChanged();
 }
 
 
@@ -375,19 +396,45 @@ bool YWidget::hasId() const
 
 YDialog * YWidget::findDialog()
 {
-    YWidget * widget = this;
+    // A widget stays in the dialog it was created in, so cache the dialog:
+    // markChanged() needs it for every change, e.g. for each item when
+    // filling a table. Walk up only to the first ancestor that already
+    // knows its dialog.
 
-    while ( widget )
+    if ( ! priv->dialog )
     {
-	YDialog * dialog = dynamic_cast<YDialog *> (widget);
+	YWidget * widget = this;
 
-	if ( dialog )
-	    return dialog;
-	else
-	    widget = widget->parent();
+	while ( widget && ! widget->priv->dialog )
+	{
+	    YDialog * dialog = dynamic_cast<YDialog *> (widget);
+
+	    if ( dialog )
+		widget->priv->dialog = dialog;
+	    else
+		widget = widget->parent();
+	}
+
+	if ( widget )
+	    priv->dialog = widget->priv->dialog;
     }
 
-    return 0;
+    return priv->dialog;
+}
+
+
+void YWidget::markChanged()
+{
+    YDialog * dialog = findDialog();
+
+    if ( dialog && ! dialog->beingDestroyed() )
+	priv->changeVersion = dialog->newChangeVersion();
+}
+
+
+unsigned long YWidget::changeVersion() const
+{
+    return priv->changeVersion;
 }
 
 
@@ -500,6 +547,7 @@ void
 YWidget::setEnabled( bool enabled )
 {
     priv->enabled = enabled;
+    markChanged();
 }
 
 
@@ -522,12 +570,14 @@ void YWidget::setShortcutString( const string & str )
 void YWidget::setNotify( bool notify )
 {
     priv->notify = notify;
+    markChanged();
 }
 
 
 void YWidget::setNotifyContextMenu( bool notifyContextMenu )
 {
     priv->notifyContextMenu = notifyContextMenu;
+    markChanged();
 }
 
 
@@ -296,6 +296,22 @@ public:
      **/
     YDialog * findDialog();
 
+    /**
+     * Record that this widget changed: one of its properties, its items or
+     * its children. This gives it a new change version of its dialog (see
+     * YDialog::changeVersion()).
+     *
+     * The libyui base classes call this in their setters; UIs call it where
+     * they change a widget without calling a libyui base class setter.
+     **/
+    void markChanged();
+
+    /**
+     * Return the change version of this widget's dialog at the last
+     * markChanged() call for this widget or 0 if there was none.
+     **/
+    unsigned long changeVersion() const;
+
     /**
      * Recursively find a widget by its ID.
      * If there is no widget with that ID, this function throws a
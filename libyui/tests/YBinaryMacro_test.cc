@@ -0,0 +1,277 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YBinaryMacroRecorder and YBinaryMacroPlayer
+// classes: Record the user input of a dialog and play it back into a new
+// instance of the same dialog.
+
+#define BOOST_TEST_MODULE YBinaryMacro_tests
+#include <boost/test/unit_test.hpp>
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+
+#include "YUI.h"
+#include "YDialog.h"
+#include "YLayoutBox.h"
+#include "YInputField.h"
+#include "YIntField.h"
+#include "YSelectionBox.h"
+#include "YWidgetID.h"
+#include "YEvent.h"
+#include "YBinaryMacro.h"
+
+using std::string;
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+// Minimal UI and widgets without any display, just enough to create and
+// delete dialogs without loading a UI plug-in
+
+class TestUI: public YUI
+{
+public:
+    TestUI(): YUI( false ) {}
+
+protected:
+    virtual YWidgetFactory *		createWidgetFactory()		{ return 0; }
+    virtual YOptionalWidgetFactory *	createOptionalWidgetFactory()	{ return 0; }
+    virtual YApplication *		createApplication()		{ return 0; }
+    virtual YEvent * runPkgSelection( YWidget * packageSelector )	{ return 0; }
+    virtual void idleLoop( int fd_ycp ) {}
+};
+
+// the dialogs need an UI instance for their deleteNotify() calls
+struct CreateTestUI {
+  void setup()    { new TestUI(); }
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( CreateTestUI );
+
+class TestDialog: public YDialog
+{
+public:
+    TestDialog(): YDialog( YMainDialog ) {}
+
+    virtual void activate() {}
+    virtual int  preferredWidth()  { return 80; }
+    virtual int  preferredHeight() { return 25; }
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+protected:
+    virtual void openInternal() {}
+    virtual YEvent * waitForEventInternal( int timeout_millisec ) { return 0; }
+    virtual YEvent * pollEventInternal() { return 0; }
+};
+
+class TestVBox: public YLayoutBox
+{
+public:
+    TestVBox( YWidget * parent ): YLayoutBox( parent, YD_VERT ) {}
+
+protected:
+    virtual void moveChild( YWidget * child, int newX, int newY ) {}
+};
+
+class TestInputField: public YInputField
+{
+public:
+    TestInputField( YWidget * parent ): YInputField( parent, "Name" ) {}
+
+    virtual string value()			{ return _value; }
+    virtual void   setValue( const string & text ) { _value = text; }
+    virtual int    preferredWidth()		{ return 10; }
+    virtual int    preferredHeight()		{ return 1; }
+    virtual void   setSize( int newWidth, int newHeight ) {}
+
+private:
+    string _value;
+};
+
+class TestIntField: public YIntField
+{
+public:
+    TestIntField( YWidget * parent ): YIntField( parent, "Count", 0, 100 ), _value( 0 ) {}
+
+    virtual int  value()			{ return _value; }
+    virtual int  preferredWidth()		{ return 10; }
+    virtual int  preferredHeight()		{ return 1; }
+    virtual void setSize( int newWidth, int newHeight ) {}
+
+protected:
+    virtual void setValueInternal( int val )	{ _value = val; }
+
+private:
+    int _value;
+};
+
+class TestSelectionBox: public YSelectionBox
+{
+public:
+    TestSelectionBox( YWidget * parent ): YSelectionBox( parent, "Color" )
+    {
+        addItem( new YItem( "Red"   ) );
+        addItem( new YItem( "Green" ) );
+        addItem( new YItem( "Blue"  ) );
+    }
+
+    virtual int  preferredWidth()		{ return 10; }
+    virtual int  preferredHeight()		{ return 3; }
+    virtual void setSize( int newWidth, int newHeight ) {}
+};
+
+// The test dialog: Only widgets with an ID save their user input; the event
+// widget is found by its ID, too
+
+struct TestDialogWidgets
+{
+    TestDialogWidgets( bool withId = true )
+    {
+        dialog     = new TestDialog();
+        TestVBox * vbox = new TestVBox( dialog );
+        inputField = new TestInputField( vbox );
+        intField   = new TestIntField( vbox );
+        selBox     = new TestSelectionBox( vbox );
+
+        if ( withId )
+            inputField->setId( new YStringWidgetID( "name" ) );
+
+        intField->setId( new YStringWidgetID( "count" ) );
+        selBox->setId( new YStringWidgetID( "color" ) );
+    }
+
+    ~TestDialogWidgets()
+    {
+        dialog->destroy();
+    }
+
+    TestDialog *	dialog;
+    TestInputField *	inputField;
+    TestIntField *	intField;
+    TestSelectionBox *	selBox;
+};
+
+
+struct MacroFixture
+{
+    MacroFixture()
+    {
+        char name[] = "/tmp/YBinaryMacro_test-XXXXXX";
+        int fd = mkstemp( name );
+        BOOST_REQUIRE( fd >= 0 );
+        close( fd );
+        macroFile = name;
+    }
+
+    ~MacroFixture()
+    {
+        unlink( macroFile.c_str() );
+    }
+
+    /**
+     * Record one block: The user input of a dialog and a selection event.
+     **/
+    void record()
+    {
+        TestDialogWidgets widgets;
+        widgets.inputField->setValue( "Tux" );
+        widgets.intField->setValue( 42 );
+        widgets.selBox->selectItem( widgets.selBox->itemAt( 2 ) );
+
+        YBinaryMacroRecorder recorder;
+        recorder.record( macroFile );
+        BOOST_REQUIRE( recorder.recording() );
+
+        YEvent * event = new YWidgetEvent( widgets.selBox, YEvent::SelectionChanged );
+        recorder.recordEvent( widgets.dialog, event );
+        recorder.endRecording();
+        widgets.dialog->deleteEvent( event );
+
+        BOOST_CHECK( ! recorder.recording() );
+    }
+
+    string macroFile;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( round_trip, MacroFixture )
+{
+    record();
+
+    TestDialogWidgets widgets;
+    BOOST_CHECK_EQUAL( widgets.inputField->value(), "" );
+
+    YBinaryMacroPlayer player;
+    player.play( macroFile );
+    BOOST_REQUIRE( player.playing() );
+
+    YEvent * event = player.playNextEvent( widgets.dialog );
+    BOOST_REQUIRE( event );
+
+    // the recorded user input is applied to the new dialog
+    BOOST_CHECK_EQUAL( widgets.inputField->value(), "Tux" );
+    BOOST_CHECK_EQUAL( widgets.intField->value(), 42 );
+    BOOST_CHECK( widgets.selBox->selectedItem() == widgets.selBox->itemAt( 2 ) );
+
+    // and the recorded event refers to the widgets of the new dialog
+    YWidgetEvent * widgetEvent = dynamic_cast<YWidgetEvent *>( event );
+    BOOST_REQUIRE( widgetEvent );
+    BOOST_CHECK( widgetEvent->widget() == widgets.selBox );
+    BOOST_CHECK_EQUAL( widgetEvent->reason(), YEvent::SelectionChanged );
+    widgets.dialog->deleteEvent( event );
+
+    // end of the macro
+    BOOST_CHECK( player.playNextEvent( widgets.dialog ) == 0 );
+    BOOST_CHECK( ! player.playing() );
+    BOOST_CHECK( ! player.failed() );
+}
+
+BOOST_FIXTURE_TEST_CASE( missing_widget, MacroFixture )
+{
+    record();
+
+    // the widget with the recorded ID does not exist
+    TestDialogWidgets widgets( false );
+
+    YBinaryMacroPlayer player;
+    player.play( macroFile );
+
+    BOOST_CHECK( player.playNextEvent( widgets.dialog ) == 0 );
+    BOOST_CHECK( ! player.playing() );
+    BOOST_CHECK( player.failed() );
+}
+
+BOOST_FIXTURE_TEST_CASE( not_a_macro, MacroFixture )
+{
+    // the empty temporary file has no macro header
+    YBinaryMacroPlayer player;
+    player.play( macroFile );
+
+    BOOST_CHECK( ! player.playing() );
+}
@@ -0,0 +1,154 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YFileSizeTracker class: Track a file in a
+// temporary directory that grows and then stalls.
+
+#define BOOST_TEST_MODULE YFileSizeTracker_tests
+#include <boost/test/unit_test.hpp>
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+
+#include "YFileSizeTracker.h"
+
+using std::string;
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+
+class TestListener: public YFileSizeListener
+{
+public:
+    TestListener(): notifications( 0 ), lastSize( 0 ) {}
+
+    virtual void fileSizeChanged( const string & filename, YFileSize_t newSize )
+    {
+        notifications++;
+        lastSize = newSize;
+    }
+
+    int		notifications;
+    YFileSize_t	lastSize;
+};
+
+
+struct TrackerFixture
+{
+    TrackerFixture()
+    {
+        char name[] = "/tmp/YFileSizeTracker_test-XXXXXX";
+        BOOST_REQUIRE( mkdtemp( name ) );
+        dir      = name;
+        filename = dir + "/download";
+
+        YFileSizeTracker::instance()->addFile( filename, &listener );
+    }
+
+    ~TrackerFixture()
+    {
+        YFileSizeTracker::instance()->removeFile( filename, &listener );
+        unlink( filename.c_str() );
+        rmdir( dir.c_str() );
+    }
+
+    /**
+     * Append 'size' bytes to the file and let the tracker process that.
+     **/
+    void append( int size )
+    {
+        std::ofstream file( filename, std::ios::app );
+        file << string( size, 'x' );
+        file.close();
+
+        YFileSizeTracker::instance()->processEvents();
+    }
+
+    void sleepMillisec( int millisec )
+    {
+        usleep( millisec * 1000 );
+    }
+
+    string		dir;
+    string		filename;
+    TestListener	listener;
+};
+
+
+BOOST_FIXTURE_TEST_CASE( size_changes, TrackerFixture )
+{
+    YFileSizeTracker * tracker = YFileSizeTracker::instance();
+
+    BOOST_CHECK( tracker->isTracked( filename ) );
+    BOOST_CHECK_EQUAL( tracker->fileSize( filename ), 0 );
+
+    append( 1000 );
+    BOOST_CHECK_EQUAL( tracker->fileSize( filename ), 1000 );
+    BOOST_CHECK_EQUAL( listener.lastSize, 1000 );
+
+    // no notification without a change
+    int notifications = listener.notifications;
+    tracker->processEvents();
+    BOOST_CHECK_EQUAL( listener.notifications, notifications );
+
+    // unknown without a complete rate sample
+    BOOST_CHECK_EQUAL( tracker->transferRate( filename ), 0.0 );
+    BOOST_CHECK_EQUAL( tracker->secondsLeft( filename, 10000 ), -1 );
+    BOOST_CHECK_EQUAL( tracker->secondsLeft( filename, 1000 ), 0 );
+}
+
+BOOST_FIXTURE_TEST_CASE( stalled_download, TrackerFixture )
+{
+    YFileSizeTracker * tracker = YFileSizeTracker::instance();
+    YFileSize_t expectedSize = 100 * 1000 * 1000;
+
+    // about 100 kB/s
+    append( 10000 );
+    sleepMillisec( 600 );
+    append( 60000 );
+
+    double rate = tracker->transferRate( filename );
+    BOOST_CHECK( rate > 0.0 );
+    BOOST_CHECK( tracker->secondsLeft( filename, expectedSize ) > 0 );
+
+    // the rate goes down while the file does not grow...
+    sleepMillisec( 1500 );
+    BOOST_CHECK( tracker->transferRate( filename ) < rate / 2 );
+
+    // ...and after a few seconds the download is stalled
+    sleepMillisec( 4000 );
+    BOOST_CHECK_EQUAL( tracker->transferRate( filename ), 0.0 );
+    BOOST_CHECK_EQUAL( tracker->secondsLeft( filename, expectedSize ), -1 );
+
+    // until it grows again
+    append( 10000 );
+    sleepMillisec( 600 );
+    append( 10000 );
+    BOOST_CHECK( tracker->transferRate( filename ) > 0.0 );
+    BOOST_CHECK( tracker->secondsLeft( filename, expectedSize ) > 0 );
+}
@@ -0,0 +1,143 @@
+/*
+  Copyright (C) 2020 SUSE LLC
+
+  This library is free software; you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 2.1 of the
+  License, or (at your option) version 3.0 of the License. This library
+  is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+  License for more details. You should have received a copy of the GNU
+  Lesser General Public License along with this library; if not, write
+  to the Free Software Foundation, Inc., 51 Franklin Street, Fifth
+  Floor, Boston, MA 02110-1301 USA
+*/
+
+// This is an unit test for the YLatencyHistogram class
+
+#define BOOST_TEST_MODULE YLatencyHistogram_tests
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+#include "YLatencyHistogram.h"
+
+// decrease the log level to warnings
+struct LogWarnings {
+  // global initialization before running any test
+  void setup() {
+      boost::unit_test::unit_test_log.set_threshold_level( boost::unit_test::log_warnings );
+  }
+  // cleanup after all tests are finished
+  void teardown() { }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE( LogWarnings );
+
+BOOST_AUTO_TEST_CASE( empty )
+{
+    YLatencyHistogram histogram;
+
+    BOOST_CHECK_EQUAL( histogram.count(), 0 );
+    BOOST_CHECK_EQUAL( histogram.min(), 0 );
+    BOOST_CHECK_EQUAL( histogram.max(), 0 );
+    BOOST_CHECK_EQUAL( histogram.average(), 0 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 50 ), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( buckets )
+{
+    YLatencyHistogram histogram;
+
+    // bucket 'n' counts 2^(n-1) up to (excluding) 2^n, bucket 0 counts 0
+    histogram.add( 0 );
+    histogram.add( 1 );
+    histogram.add( 2 );
+    histogram.add( 3 );
+    histogram.add( 4 );
+    histogram.add( 7 );
+    histogram.add( 8 );
+    histogram.add( 1023 );
+    histogram.add( 1024 );
+
+    BOOST_CHECK_EQUAL( histogram.bucket( 0 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.bucket( 1 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.bucket( 2 ), 2 );
+    BOOST_CHECK_EQUAL( histogram.bucket( 3 ), 2 );
+    BOOST_CHECK_EQUAL( histogram.bucket( 4 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.bucket( 10 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.bucket( 11 ), 1 );
+
+    // out of range bucket numbers
+    BOOST_CHECK_EQUAL( histogram.bucket( -1 ), 0 );
+    BOOST_CHECK_EQUAL( histogram.bucket( YLatencyHistogram::BucketCount ), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( limits )
+{
+    YLatencyHistogram histogram;
+
+    // negative values count as 0, huge ones go to the last bucket
+    histogram.add( -5 );
+    histogram.add( 1LL << 50 );
+
+    BOOST_CHECK_EQUAL( histogram.bucket( 0 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.bucket( YLatencyHistogram::BucketCount - 1 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.min(), 0 );
+    BOOST_CHECK_EQUAL( histogram.max(), 1LL << 50 );
+}
+
+BOOST_AUTO_TEST_CASE( statistics )
+{
+    YLatencyHistogram histogram;
+
+    for ( int i = 1; i <= 100; i++ )
+        histogram.add( i );
+
+    BOOST_CHECK_EQUAL( histogram.count(), 100 );
+    BOOST_CHECK_EQUAL( histogram.min(), 1 );
+    BOOST_CHECK_EQUAL( histogram.max(), 100 );
+    BOOST_CHECK_EQUAL( histogram.sum(), 5050 );
+    BOOST_CHECK_EQUAL( histogram.average(), 50 );
+
+    histogram.clear();
+    BOOST_CHECK_EQUAL( histogram.count(), 0 );
+    BOOST_CHECK_EQUAL( histogram.sum(), 0 );
+    BOOST_CHECK_EQUAL( histogram.bucket( 1 ), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( percentiles )
+{
+    YLatencyHistogram histogram;
+
+    for ( int i = 1; i <= 100; i++ )
+        histogram.add( i );
+
+    // the upper limit of the bucket that contains the percentile:
+    // 1..63 are in the buckets up to 6 (32..63)
+    BOOST_CHECK_EQUAL( histogram.percentile( 50 ), 63 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 63 ), 63 );
+
+    // but never more than the maximum
+    BOOST_CHECK_EQUAL( histogram.percentile( 64 ), 100 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 99 ), 100 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 100 ), 100 );
+
+    // the lowest non-empty bucket
+    BOOST_CHECK_EQUAL( histogram.percentile( 0 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 1 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 2 ), 3 );
+}
+
+BOOST_AUTO_TEST_CASE( summary )
+{
+    YLatencyHistogram histogram;
+    histogram.add( 10 );
+    histogram.add( 30 );
+
+    std::ostringstream str;
+    str << histogram;
+
+    BOOST_CHECK_EQUAL( str.str(), "count=2 min=10 avg=20 p50=15 p90=30 p99=30 max=30" );
+}